@@ -0,0 +1,100 @@
+#include "AnelCompartilhado.h"
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const size_t TAMANHO_CABECALHO = 64;
+static const size_t OFFSET_PUBLICADOS = 16;
+static const uint32_t VERSAO_ANEL = 1;
+
+// Grava um u64 visível para outros processos só depois dos dados anteriores
+static void publicarU64(unsigned char* endereco, unsigned long long valor) {
+    atomic_thread_fence(memory_order_release);
+    reinterpret_cast<atomic<unsigned long long>*>(endereco)->store(valor, memory_order_release);
+}
+
+AnelCompartilhado::AnelCompartilhado()
+    : base(nullptr), tamanhoRegiao(0), nSlots(0), tamanhoSlot(0), publicados(0), handle(nullptr) {}
+
+AnelCompartilhado::~AnelCompartilhado() {
+    fechar();
+}
+
+void AnelCompartilhado::fechar() {
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle((HANDLE)handle);
+#else
+    munmap(base, tamanhoRegiao);
+    // O nome fica disponível até o leitor terminar; simulation.py o remove ao encerrar o motor
+#endif
+    base = nullptr;
+    handle = nullptr;
+}
+
+/// @brief Cria a região compartilhada e zera o cabeçalho e os slots.
+/// @param nome Nome da região (POSIX: "/nome", visível em /dev/shm; Windows: nome do mapeamento).
+/// @param nSlots Quantidade de quadros guardados.
+/// @param tamanhoMaximoQuadro Maior quadro que será publicado (define o tamanho do slot).
+bool AnelCompartilhado::criar(const string& nome, int nSlots, int tamanhoMaximoQuadro) {
+    fechar();
+    this->nSlots = nSlots;
+    // Slot = seq (8 bytes) + quadro, arredondado para 64 bytes
+    tamanhoSlot = (int)((8 + tamanhoMaximoQuadro + 63) / 64 * 64);
+    tamanhoRegiao = TAMANHO_CABECALHO + (size_t)nSlots * tamanhoSlot;
+    publicados = 0;
+
+#ifdef _WIN32
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                  0, (DWORD)tamanhoRegiao, nome.c_str());
+    if (!h) return false;
+    void* p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, tamanhoRegiao);
+    if (!p) { CloseHandle(h); return false; }
+    handle = h;
+    base = (unsigned char*)p;
+#else
+    shm_unlink(nome.c_str());
+    int fd = shm_open(nome.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) return false;
+    if (ftruncate(fd, (off_t)tamanhoRegiao) != 0) { close(fd); shm_unlink(nome.c_str()); return false; }
+    void* p = mmap(nullptr, tamanhoRegiao, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) { shm_unlink(nome.c_str()); return false; }
+    base = (unsigned char*)p;
+#endif
+
+    nomeRegiao = nome;
+    memset(base, 0, tamanhoRegiao);
+    uint32_t cabecalho[4] = {0, VERSAO_ANEL, (uint32_t)nSlots, (uint32_t)tamanhoSlot};
+    memcpy(cabecalho, "BRSH", 4);
+    memcpy(base, cabecalho, sizeof(cabecalho));
+    return true;
+}
+
+bool AnelCompartilhado::publicar(const char* quadro, size_t tamanho) {
+    if (!base || 8 + tamanho > (size_t)tamanhoSlot) return false;
+
+    unsigned long long n = publicados;
+    unsigned char* slot = base + TAMANHO_CABECALHO + (size_t)(n % nSlots) * tamanhoSlot;
+
+    publicarU64(slot, 2 * n + 1);            // em escrita
+    atomic_thread_fence(memory_order_release);
+    memcpy(slot + 8, quadro, tamanho);
+    publicarU64(slot, 2 * n + 2);            // completo
+
+    publicados = n + 1;
+    publicarU64(base + OFFSET_PUBLICADOS, publicados);
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef ANEL_COMPARTILHADO_H
+#define ANEL_COMPARTILHADO_H
+
+#include <string>
+#include <cstddef>
+
+/// @brief Buffer circular em memória compartilhada para os quadros binários do simulador.
+///
+/// Um único produtor (o motor) e leitores que apenas mapeiam a região (simulation.py).
+/// Layout, todos os inteiros little-endian:
+///
+///   cabeçalho (64 bytes): "BRSH", versão u32, nSlots u32, tamanhoSlot u32,
+///                         quadrosPublicados u64 (offset 16)
+///   slot k (tamanhoSlot bytes, a partir do offset 64 + k * tamanhoSlot):
+///                         seq u64, quadro binário (mesmo formato do stdout)
+///
+/// O quadro n vai para o slot n % nSlots. Enquanto é escrito, seq = 2n + 1; ao terminar,
+/// seq = 2n + 2 e quadrosPublicados = n + 1. O leitor confere seq antes e depois de ler
+/// (seqlock) e descarta o quadro se ele mudou no meio. Leitores atrasados perdem
+/// quadros antigos, nunca recebem quadros corrompidos.
+class AnelCompartilhado {
+public:
+    AnelCompartilhado();
+    ~AnelCompartilhado();
+
+    /// Cria (ou recria) a região com o nome dado. Retorna false se o sistema não permitir.
+    bool criar(const std::string& nome, int nSlots, int tamanhoMaximoQuadro);
+
+    /// Publica um quadro. Quadros maiores que o slot são descartados (retorna false).
+    bool publicar(const char* quadro, size_t tamanho);
+
+    const std::string& nome() const { return nomeRegiao; }
+    size_t tamanhoTotal() const { return tamanhoRegiao; }
+    /// Maior quadro que cabe em um slot (0 antes de criar).
+    int maiorQuadro() const { return base ? tamanhoSlot - 8 : 0; }
+
+private:
+    void fechar();
+
+    std::string nomeRegiao;
+    unsigned char* base;
+    size_t tamanhoRegiao;
+    int nSlots;
+    int tamanhoSlot;
+    unsigned long long publicados;
+    void* handle; // HANDLE do mapeamento no Windows (não usado em POSIX)
+};
+
+#endif
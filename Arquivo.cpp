@@ -0,0 +1,71 @@
+#include "Arquivo.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+static bool gravarTemporario(const string& temporario, initializer_list<TrechoArquivo> trechos) {
+    HANDLE arquivo = CreateFileA(temporario.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) return false;
+    bool ok = true;
+    for (const TrechoArquivo& t : trechos) {
+        const char* p = static_cast<const char*>(t.dados);
+        size_t restante = t.tamanho;
+        while (ok && restante > 0) {
+            DWORD parte = restante > 0x40000000 ? 0x40000000 : (DWORD)restante, escritos = 0;
+            ok = WriteFile(arquivo, p, parte, &escritos, NULL) && escritos == parte;
+            p += parte;
+            restante -= parte;
+        }
+    }
+    ok = ok && FlushFileBuffers(arquivo);
+    return CloseHandle(arquivo) && ok;
+}
+
+static bool substituir(const string& temporario, const string& caminho) {
+    return MoveFileExA(temporario.c_str(), caminho.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+static bool gravarTemporario(const string& temporario, initializer_list<TrechoArquivo> trechos) {
+    int arquivo = open(temporario.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (arquivo < 0) return false;
+    bool ok = true;
+    for (const TrechoArquivo& t : trechos) {
+        const char* p = static_cast<const char*>(t.dados);
+        size_t restante = t.tamanho;
+        while (ok && restante > 0) {
+            ssize_t escritos = write(arquivo, p, restante);
+            ok = escritos > 0;
+            if (ok) {
+                p += escritos;
+                restante -= (size_t)escritos;
+            }
+        }
+    }
+    ok = ok && fsync(arquivo) == 0;
+    return close(arquivo) == 0 && ok;
+}
+
+// O rename do POSIX troca o destino atomicamente: quem abrir 'caminho' vê o antigo ou o novo
+static bool substituir(const string& temporario, const string& caminho) {
+    return rename(temporario.c_str(), caminho.c_str()) == 0;
+}
+
+#endif
+
+bool gravarArquivoAtomico(const string& caminho, initializer_list<TrechoArquivo> trechos) {
+    string temporario = caminho + ".tmp";
+    if (gravarTemporario(temporario, trechos) && substituir(temporario, caminho)) return true;
+    remove(temporario.c_str());
+    return false;
+}
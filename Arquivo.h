@@ -0,0 +1,34 @@
+#ifndef ARQUIVO_H
+#define ARQUIVO_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <initializer_list>
+
+// Acrescenta valores brutos a um buffer em memória (arquivos binários do checkpoint e do lote)
+struct EscritorBinario {
+    std::vector<unsigned char> dados;
+
+    void bytes(const void* p, size_t n) {
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        dados.insert(dados.end(), b, b + n);
+    }
+    template <typename T> void valor(const T& v) { bytes(&v, sizeof(T)); }
+    template <typename T> void vetor(const std::vector<T>& v, size_t n) { bytes(v.data(), n * sizeof(T)); }
+};
+
+// Trecho de memória gravado por gravarArquivoAtomico
+struct TrechoArquivo {
+    const void* dados;
+    size_t tamanho;
+};
+
+/// @brief Grava os trechos, em ordem, em 'caminho' + ".tmp", leva o temporário ao disco
+/// (fsync / FlushFileBuffers) e o renomeia por cima de 'caminho' em uma única operação
+/// (rename no POSIX; MoveFileExA com MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH no
+/// Windows). Um processo morto em qualquer ponto deixa o arquivo anterior ou o novo inteiro.
+/// @return false se algo falhar (o arquivo anterior fica intacto).
+bool gravarArquivoAtomico(const std::string& caminho, std::initializer_list<TrechoArquivo> trechos);
+
+#endif
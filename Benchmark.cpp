@@ -0,0 +1,966 @@
+// Suíte de desempenho reprodutível: microbenchmarks dos pontos quentes e uma bateria
+// fixa de alvos e obstáculos resolvida em modo headless. Rodar com `make benchmark`.
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdio>
+
+#include "Types.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Robot.h"
+#include "Evolution.h"
+#include "Selecao.h"
+#include "Populacao.h"
+#include "Paralelo.h"
+#include "Lote.h"
+#include "Execucao.h"
+#include "Saida.h"
+#include "Cena.h"
+#include "MapaColisao.h"
+#include "Checkpoint.h"
+#include "Planejador.h"
+#include "Metricas.h"
+#include "Braco.h"
+#include "Genoma.h"
+#include "Trig.h"
+
+using namespace std;
+
+// Semente fixa de toda a suíte (microbenchmarks e execuções)
+static const unsigned int SEMENTE_BENCHMARK = 20240601;
+
+// Evita que o compilador descarte os cálculos medidos
+static volatile double sumidouro = 0.0;
+
+static double agora() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Imprime uma linha de microbenchmark no formato chave=valor.
+static void imprimirMicro(const string& nome, int chamadas, double segundos) {
+    cout << "MICRO " << nome
+         << " chamadas=" << chamadas
+         << " ns_por_chamada=" << fixed << setprecision(1) << segundos * 1e9 / chamadas
+         << defaultfloat << setprecision(6) << endl;
+}
+
+/// @brief Gera 'n' genomas aleatórios com o gerador da suíte.
+static vector<vector<double>> genomasAleatorios(int n) {
+    Gerador rng;
+    reposicionarGerador(rng, 0, 0, FLUXO_INICIAL);
+    vector<vector<double>> genomas(n, vector<double>(c.nGenes * c.nJuntas));
+    for (auto& g : genomas) gerarIndividuo(g.data(), rng);
+    return genomas;
+}
+
+/// @brief Gerador Philox: vetores de referência de Salmon et al. (Random123), uniformidade do
+/// sorteio sem repetição e custo de reposicionar o gerador e dos operadores que sorteiam.
+static void microAleatorio() {
+    struct Vetor { uint32_t chave[2], contador[4], saida[4]; };
+    const Vetor referencia[] = {
+        {{0, 0}, {0, 0, 0, 0}, {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+        {{0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+         {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+        {{0xa4093822, 0x299f31d0}, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+         {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}
+    };
+    int corretos = 0;
+    for (const Vetor& v : referencia) {
+        Gerador rng;
+        rng.posicionar(v.chave[0] | ((uint64_t)v.chave[1] << 32), v.contador[1], v.contador[2], v.contador[3],
+                       v.contador[0]);
+        bool igual = true;
+        for (int i = 0; i < 4; i++) igual = igual && rng() == v.saida[i];
+        if (igual) corretos++;
+    }
+    cout << "VALIDACAO philox_referencia corretos=" << corretos << "/3" << (corretos == 3 ? " OK" : " FALHOU") << endl;
+
+    // Cada gene deve sair em k/n dos sorteios (desvio relativo máximo entre os genes)
+    Gerador rng;
+    const int SORTEIOS = 200000, K = 7;
+    int n = c.nGenes;
+    vector<int> destino(n), contagem(n, 0);
+    vector<unsigned char> marcas(n, 0);
+    for (int r = 0; r < SORTEIOS; r++) {
+        reposicionarGerador(rng, r, 0, FLUXO_FILHO);
+        sortearSemRepeticao(rng, n, K, destino.data(), marcas.data());
+        for (int i = 0; i < K; i++) contagem[destino[i]]++;
+    }
+    double esperado = (double)SORTEIOS * K / n, desvio = 0.0;
+    for (int g = 0; g < n; g++) desvio = max(desvio, fabs(contagem[g] - esperado) / esperado);
+    cout << "VALIDACAO sorteio_sem_repeticao n=" << n << " k=" << K << " desvio_relativo_max=" << desvio
+         << (desvio < 0.05 ? " OK" : " FALHOU") << endl;
+
+    const int N = 200000;
+    double inicio = agora();
+    for (int i = 0; i < N; i++) {
+        reposicionarGerador(rng, i, 7, FLUXO_FILHO);
+        sumidouro = sumidouro + rng();
+    }
+    imprimirMicro("reposicionarGerador", N, agora() - inicio);
+
+    vector<double> genoma(c.nGenes * c.nJuntas, 0.0);
+    inicio = agora();
+    for (int i = 0; i < N; i++) {
+        reposicionarGerador(rng, 0, i, FLUXO_INICIAL);
+        gerarIndividuo(genoma.data(), rng);
+    }
+    imprimirMicro("gerarIndividuo", N, agora() - inicio);
+
+    TabelaAlias tabela;
+    tabela.construir(c.listaPNumGene);
+    EstadoEvolutivo est;
+    vector<int> indices(c.nGenes);
+    inicio = agora();
+    for (int i = 0; i < N; i++) {
+        reposicionarGerador(rng, i, 7, FLUXO_FILHO);
+        sumidouro = sumidouro + realizarMutacao(genoma.data(), rng, est, tabela, indices, marcas);
+    }
+    imprimirMicro("realizarMutacao", N, agora() - inicio);
+}
+
+static void microCinematica() {
+    Gerador rng;
+    reposicionarGerador(rng, 0, 1, FLUXO_INICIAL);
+    const int N = 1000;
+    vector<vector<double>> poses(N, vector<double>(c.nJuntas));
+    for (auto& p : poses)
+        for (int j = 0; j < c.nJuntas; j++) p[j] = escolherNumReal(rng, c.baseLmin[j], c.baseLmax[j]);
+
+    const int REPETICOES = 200;
+    double inicio = agora();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < N; i++) sumidouro = sumidouro + cinematicaDireta(poses[i]).x;
+    imprimirMicro("cinematicaDireta", N * REPETICOES, agora() - inicio);
+
+    inicio = agora();
+    for (int r = 0; r < REPETICOES; r++)
+        for (int i = 0; i < N; i++) sumidouro = sumidouro + (verificarColisao(poses[i]) ? 1 : 0);
+    imprimirMicro("verificarColisao", N * REPETICOES, agora() - inicio);
+}
+
+/// @brief Cinemática de cada braço predefinido: instância com o número de juntas fixo
+/// (a usada pelo programa) contra a genérica, que lê o número de juntas em tempo de execução.
+static void microBraco() {
+    const char* bracos[] = {"_braco_3r", "_braco_4r", "_braco_6r", "_braco_7r"};
+    for (const char* nome : bracos) {
+        selecionarBraco(nome);
+        montarBraco();
+        Gerador rng;
+        reposicionarGerador(rng, 0, 3, FLUXO_INICIAL);
+        const int N = 1000;
+        vector<double> poses(N * c.nJuntas);
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < c.nJuntas; j++) poses[i * c.nJuntas + j] = escolherNumReal(rng, c.baseLmin[j], c.baseLmax[j]);
+
+        const int REPETICOES = 200;
+        Ponto origens[MAX_JUNTAS + 1];
+        double inicio = agora();
+        for (int r = 0; r < REPETICOES; r++)
+            for (int i = 0; i < N; i++) {
+                braco.cadeia(braco, &poses[i * c.nJuntas], origens);
+                sumidouro = sumidouro + origens[c.nJuntas].x;
+            }
+        imprimirMicro(string("cadeia") + (nome + 6), N * REPETICOES, agora() - inicio);
+
+        inicio = agora();
+        for (int r = 0; r < REPETICOES; r++)
+            for (int i = 0; i < N; i++) {
+                cadeiaCinematica<0>(braco, &poses[i * c.nJuntas], origens);
+                sumidouro = sumidouro + origens[c.nJuntas].x;
+            }
+        imprimirMicro(string("cadeia") + (nome + 6) + "_generica", N * REPETICOES, agora() - inicio);
+    }
+    selecionarBraco("_braco_3r");
+    montarBraco();
+}
+
+/// @brief Custo do teste de colisão de um passo (pose + varredura) em cenas com cada vez
+/// mais obstáculos, para acompanhar o crescimento sublinear da BVH.
+static void microCena() {
+    Gerador rng;
+    reposicionarGerador(rng, 0, 2, FLUXO_INICIAL);
+    const int N = 1000;
+    vector<double> poses((N + 1) * c.nJuntas);
+    for (int i = 0; i <= N; i++)
+        for (int j = 0; j < c.nJuntas; j++) poses[i * c.nJuntas + j] = escolherNumReal(rng, c.baseLmin[j], c.baseLmax[j]);
+    // Passos curtos, como os de um genoma (até 'speed' graus por junta, dentro dos limites como em move)
+    for (int i = 1; i <= N; i++)
+        for (int j = 0; j < c.nJuntas; j++) {
+            double v = poses[(i - 1) * c.nJuntas + j] + escolherNumReal(rng, -c.speed, c.speed);
+            poses[i * c.nJuntas + j] = max(c.baseLmin[j], min(c.baseLmax[j], v));
+        }
+
+    const int tamanhos[] = {1, 16, 64, 256};
+    for (int n : tamanhos) {
+        cena.limpar();
+        for (int k = 0; k < n; k++) {
+            double ang = escolherNumReal(rng, -M_PI, M_PI), r = escolherNumReal(rng, 4.0, 20.0);
+            double x = r * cos(ang), y = r * sin(ang), z = escolherNumReal(rng, 0.0, 18.0);
+            if (k % 2 == 0) cena.adicionarEsfera({x, y, z, escolherNumReal(rng, 0.2, 1.0)});
+            else cena.adicionarCaixa({{x - 0.3, y - 0.3, z - 0.5}, {x + 0.3, y + 0.3, z + 0.5}});
+        }
+        cena.construir();
+
+        const int REPETICOES = 100;
+        int colisoes = 0;
+        double inicio = agora();
+        for (int r = 0; r < REPETICOES; r++)
+            for (int i = 1; i <= N; i++) colisoes += colisaoNoPasso(&poses[(i - 1) * c.nJuntas], &poses[i * c.nJuntas]) ? 1 : 0;
+        imprimirMicro("colisaoNoPasso_cena" + to_string(n), N * REPETICOES, agora() - inicio);
+        sumidouro = sumidouro + colisoes;
+
+        // Mesmo teste com o mapa de configurações: a construção entra à parte, e as respostas
+        // precisam ser idênticas às da geometria (o mapa só pula consultas que dariam "livre")
+        inicio = agora();
+        if (!mapaColisao.construir(c.resolucaoMapa)) continue;
+        imprimirMicro("mapaColisao_construcao_cena" + to_string(n), mapaColisao.celulas(), agora() - inicio);
+        int colisoesMapa = 0, respondidas = 0;
+        inicio = agora();
+        for (int r = 0; r < REPETICOES; r++)
+            for (int i = 1; i <= N; i++) colisoesMapa += colisaoNoPasso(&poses[(i - 1) * c.nJuntas], &poses[i * c.nJuntas]) ? 1 : 0;
+        imprimirMicro("colisaoNoPasso_cena" + to_string(n) + "_mapa", N * REPETICOES, agora() - inicio);
+        for (int i = 1; i <= N; i++) {
+            double deslocamento = deslocamentoMaximo(&poses[(i - 1) * c.nJuntas], &poses[i * c.nJuntas]);
+            respondidas += mapaColisao.livre(&poses[i * c.nJuntas], deslocamento) ? 1 : 0;
+        }
+        mapaColisao.descartar();
+        cout << "VALIDACAO mapa_colisao_cena" << n << " colisoes=" << colisoes / REPETICOES
+             << " colisoes_mapa=" << colisoesMapa / REPETICOES
+             << " respondidas_pelo_mapa=" << respondidas << "/" << N
+             << (colisoes == colisoesMapa ? " OK" : " FALHA") << endl;
+    }
+    montarCena();
+}
+
+static void microFitness(const Ponto& alvo) {
+    const int N = 2000;
+    vector<vector<double>> genomas = genomasAleatorios(N);
+
+    double inicio = agora();
+    for (int i = 0; i < N; i++) {
+        Avaliacao av;
+        sumidouro = sumidouro + calcularFitness(genomas[i].data(), alvo, av);
+    }
+    imprimirMicro("calcularFitness", N, agora() - inicio);
+
+#if METRICAS
+    // A avaliação sem trajetória não pode tocar no alocador
+    unsigned long long alocacoesAntes = alocacoesDesdeZerar();
+    for (int i = 0; i < N; i++) {
+        Avaliacao av;
+        sumidouro = sumidouro + calcularFitness(genomas[i].data(), alvo, av);
+    }
+    unsigned long long alocacoesFitness = alocacoesDesdeZerar() - alocacoesAntes;
+    cout << "VALIDACAO calcularFitness_alocacoes chamadas=" << N << " alocacoes=" << alocacoesFitness
+         << (alocacoesFitness == 0 ? " OK" : " FALHA") << endl;
+#endif
+
+    // Kernel em lote em cada nível suportado, com a verificação da tolerância contra o escalar
+    ParametrosLote prm = montarParametrosLote(alvo);
+    for (int nivel = SIMD_ESCALAR; nivel <= (int)detectarSimd(); nivel++) {
+        int largura = larguraLote((NivelSimd)nivel);
+        double erroMaximo = 0.0;
+        int divergencias = 0;
+
+        inicio = agora();
+        for (int i = 0; i + largura <= N; i += largura) {
+            LaneLote lanes[LARGURA_MAXIMA_LOTE];
+            Avaliacao av[LARGURA_MAXIMA_LOTE];
+            for (int l = 0; l < largura; l++) lanes[l] = {genomas[i + l].data(), nullptr, 1};
+            avaliarLote((NivelSimd)nivel, prm, lanes, largura, av);
+            sumidouro = sumidouro + av[0].fitness;
+        }
+        double segundos = agora() - inicio;
+        imprimirMicro(string("avaliarLote_") + nomeSimd((NivelSimd)nivel), N, segundos);
+
+        for (int i = 0; i + largura <= N; i += largura) {
+            LaneLote lanes[LARGURA_MAXIMA_LOTE];
+            Avaliacao av[LARGURA_MAXIMA_LOTE];
+            for (int l = 0; l < largura; l++) lanes[l] = {genomas[i + l].data(), nullptr, 1};
+            avaliarLote((NivelSimd)nivel, prm, lanes, largura, av);
+            for (int l = 0; l < largura; l++) {
+                Avaliacao ref;
+                calcularFitness(genomas[i + l].data(), alvo, ref);
+                double erro = fabs(ref.fitness - av[l].fitness) / max(1.0, fabs(ref.fitness));
+                erroMaximo = max(erroMaximo, erro);
+                if (ref.venceu != av[l].venceu || ref.passoVitoria != av[l].passoVitoria) divergencias++;
+            }
+        }
+        cout << "VALIDACAO avaliarLote_" << nomeSimd((NivelSimd)nivel)
+             << " erro_relativo_max=" << erroMaximo
+             << " divergencias_vitoria=" << divergencias
+             << " tolerancia=" << TOLERANCIA_LOTE
+             << (erroMaximo <= TOLERANCIA_LOTE && divergencias == 0 ? " OK" : " FALHOU") << endl;
+    }
+}
+
+/// @brief Modo de cinemática rápida (Config::_trig = "_trig_rapida"): custo e erro máximo de
+/// sincosRapido, da cadeia de cada braço e da trajetória inteira em relação ao modo exato, e
+/// igualdade entre o lote e calcularFitness nesse modo.
+static void validarTrigRapida(const Ponto& alvo) {
+    string trigOriginal = c._trig;
+
+    // Seno e cosseno em uma grade densa de [-4pi, 4pi]
+    const int PONTOS = 2000000;
+    double erroTrig = 0.0;
+    for (int i = 0; i <= PONTOS; i++) {
+        double x = -4 * M_PI + 8 * M_PI * i / PONTOS, s, co;
+        sincosRapido(x, s, co);
+        erroTrig = max(erroTrig, max(fabs(s - sin(x)), fabs(co - cos(x))));
+    }
+    cout << "VALIDACAO trig_sincos erro_abs_max=" << erroTrig << " limite=" << ERRO_TRIG_RAPIDA
+         << (erroTrig <= ERRO_TRIG_RAPIDA ? " OK" : " FALHOU") << endl;
+
+    // Ângulos sorteados (quadrantes imprevisíveis, como na cinemática)
+    const int N = 100000;
+    vector<double> angulos(N);
+    Gerador rngAngulos;
+    reposicionarGerador(rngAngulos, 0, 5, FLUXO_INICIAL);
+    for (double& x : angulos) x = escolherNumReal(rngAngulos, -2 * M_PI, 2 * M_PI);
+    double inicio = agora();
+    for (int i = 0; i < N; i++) sumidouro = sumidouro + sin(angulos[i]) + cos(angulos[i]);
+    imprimirMicro("sincos_std", N, agora() - inicio);
+    inicio = agora();
+    for (int i = 0; i < N; i++) {
+        double s, co;
+        sincosRapido(angulos[i], s, co);
+        sumidouro = sumidouro + s + co;
+    }
+    imprimirMicro("sincos_rapido", N, agora() - inicio);
+
+    // Cadeia de cada braço: erro de posição de todas as origens e custo por pose
+    const char* bracos[] = {"_braco_3r", "_braco_4r", "_braco_6r", "_braco_7r"};
+    for (const char* nome : bracos) {
+        selecionarBraco(nome);
+        Gerador rng;
+        reposicionarGerador(rng, 0, 4, FLUXO_INICIAL);
+        const int POSES = 20000;
+        vector<double> poses(POSES * c.nJuntas);
+        for (int i = 0; i < POSES; i++)
+            for (int j = 0; j < c.nJuntas; j++) poses[i * c.nJuntas + j] = escolherNumReal(rng, c.baseLmin[j], c.baseLmax[j]);
+
+        Ponto exatas[MAX_JUNTAS + 1], rapidas[MAX_JUNTAS + 1];
+        c._trig = "_trig_exata";
+        montarBraco();
+        ModeloBraco exato = braco;
+        c._trig = "_trig_rapida";
+        montarBraco();
+
+        double erroPosicao = 0.0;
+        for (int i = 0; i < POSES; i++) {
+            exato.cadeia(exato, &poses[i * c.nJuntas], exatas);
+            braco.cadeia(braco, &poses[i * c.nJuntas], rapidas);
+            for (int k = 0; k <= c.nJuntas; k++)
+                erroPosicao = max(erroPosicao, sqrt(distSq(exatas[k], rapidas[k])));
+        }
+        // Cada junta erra o seu seno/cosseno em até ERRO_TRIG_RAPIDA (mais o arredondamento)
+        double limite = 2 * ERRO_TRIG_RAPIDA * c.nJuntas * braco.alcance[0];
+        cout << "VALIDACAO trig_cadeia" << (nome + 6) << " erro_posicao_max=" << erroPosicao << " limite=" << limite
+             << (erroPosicao <= limite ? " OK" : " FALHOU") << endl;
+
+        // Mesmas poses e mesmo laço nos dois modos
+        const ModeloBraco* modelos[] = {&exato, &braco};
+        const char* sufixos[] = {"_exata", "_rapida"};
+        for (int m = 0; m < 2; m++) {
+            inicio = agora();
+            for (int r = 0; r < 10; r++)
+                for (int i = 0; i < POSES; i++) {
+                    modelos[m]->cadeia(*modelos[m], &poses[i * c.nJuntas], rapidas);
+                    sumidouro = sumidouro + rapidas[c.nJuntas].x;
+                }
+            imprimirMicro(string("cadeia") + (nome + 6) + sufixos[m], POSES * 10, agora() - inicio);
+        }
+    }
+    selecionarBraco("_braco_3r");
+
+    // Trajetórias inteiras: a ponta em cada waypoint, o fitness e a vitória
+    const int GENOMAS = 2000;
+    vector<vector<double>> genomas = genomasAleatorios(GENOMAS);
+    double erroPosicao = 0.0, erroFitness = 0.0;
+    int divergencias = 0;
+    for (int i = 0; i < GENOMAS; i++) {
+        vector<Ponto> trajExata, trajRapida;
+        Avaliacao exata, rapida;
+        c._trig = "_trig_exata";
+        montarBraco();
+        calcularFitness(genomas[i].data(), alvo, exata, &trajExata);
+        c._trig = "_trig_rapida";
+        montarBraco();
+        calcularFitness(genomas[i].data(), alvo, rapida, &trajRapida);
+        for (size_t k = 0; k < min(trajExata.size(), trajRapida.size()); k++)
+            erroPosicao = max(erroPosicao, sqrt(distSq(trajExata[k], trajRapida[k])));
+        erroFitness = max(erroFitness, fabs(exata.fitness - rapida.fitness) / max(1.0, fabs(exata.fitness)));
+        if (exata.venceu != rapida.venceu || exata.passoVitoria != rapida.passoVitoria) divergencias++;
+    }
+    cout << "VALIDACAO trig_trajetoria erro_posicao_max=" << erroPosicao
+         << " erro_relativo_fitness_max=" << erroFitness
+         << " divergencias_vitoria=" << divergencias
+         << (erroFitness <= TOLERANCIA_LOTE ? " OK" : " FALHOU") << endl;
+
+    // No modo rápido todos os níveis do lote usam a mesma aritmética de calcularFitness
+    inicio = agora();
+    for (int i = 0; i < GENOMAS; i++) {
+        Avaliacao av;
+        sumidouro = sumidouro + calcularFitness(genomas[i].data(), alvo, av);
+    }
+    imprimirMicro("calcularFitness_rapida", GENOMAS, agora() - inicio);
+
+    ParametrosLote prm = montarParametrosLote(alvo);
+    for (int nivel = SIMD_ESCALAR; nivel <= (int)detectarSimd(); nivel++) {
+        int largura = larguraLote((NivelSimd)nivel);
+        int diferentes = 0;
+        inicio = agora();
+        for (int i = 0; i + largura <= GENOMAS; i += largura) {
+            LaneLote lanes[LARGURA_MAXIMA_LOTE];
+            Avaliacao av[LARGURA_MAXIMA_LOTE];
+            for (int l = 0; l < largura; l++) lanes[l] = {genomas[i + l].data(), nullptr, 1};
+            avaliarLote((NivelSimd)nivel, prm, lanes, largura, av);
+            sumidouro = sumidouro + av[0].fitness;
+        }
+        imprimirMicro(string("avaliarLote_") + nomeSimd((NivelSimd)nivel) + "_rapida", GENOMAS, agora() - inicio);
+
+        for (int i = 0; i + largura <= GENOMAS; i += largura) {
+            LaneLote lanes[LARGURA_MAXIMA_LOTE];
+            Avaliacao av[LARGURA_MAXIMA_LOTE];
+            for (int l = 0; l < largura; l++) lanes[l] = {genomas[i + l].data(), nullptr, 1};
+            avaliarLote((NivelSimd)nivel, prm, lanes, largura, av);
+            for (int l = 0; l < largura; l++) {
+                Avaliacao ref;
+                calcularFitness(genomas[i + l].data(), alvo, ref);
+                if (ref.fitness != av[l].fitness || ref.venceu != av[l].venceu || ref.passoVitoria != av[l].passoVitoria)
+                    diferentes++;
+            }
+        }
+        cout << "VALIDACAO avaliarLote_" << nomeSimd((NivelSimd)nivel) << "_rapida diferentes=" << diferentes
+             << (diferentes == 0 ? " OK" : " FALHOU") << endl;
+    }
+
+    c._trig = trigOriginal;
+    montarBraco();
+}
+
+/// @brief Cinemática inversa analítica: para poses sorteadas dentro dos limites, todas as
+/// soluções devem levar a ponta ao mesmo ponto e uma delas deve ser a própria pose.
+static void validarCinematicaInversa() {
+    Gerador rng;
+    reposicionarGerador(rng, 0, 6, FLUXO_INICIAL);
+    const int POSES = 20000;
+    double erroPosicao = 0.0;
+    int poseEncontrada = 0, totalSolucoes = 0;
+    vector<vector<double>> solucoes;
+    double inicio = agora();
+    for (int n = 0; n < POSES; n++) {
+        vector<double> pose(c.nJuntas);
+        for (int k = 0; k < c.nJuntas; k++) pose[k] = escolherNumReal(rng, c.baseLmin[k], c.baseLmax[k]);
+        Ponto alvo = cinematicaDireta(pose);
+        totalSolucoes += cinematicaInversa(alvo, solucoes);
+
+        bool achou = false;
+        for (const vector<double>& s : solucoes) {
+            erroPosicao = max(erroPosicao, sqrt(distSq(cinematicaDireta(s), alvo)));
+            double diferenca = 0.0;
+            for (int k = 0; k < c.nJuntas; k++) diferenca = max(diferenca, fabs(s[k] - pose[k]));
+            achou = achou || diferenca < 1e-6;
+        }
+        if (achou) poseEncontrada++;
+    }
+    imprimirMicro("cinematicaInversa", POSES, agora() - inicio);
+    cout << "VALIDACAO ik poses=" << POSES << " solucoes_por_pose=" << (double)totalSolucoes / POSES
+         << " pose_recuperada=" << poseEncontrada << " erro_posicao_max=" << erroPosicao
+         << (poseEncontrada == POSES && erroPosicao < 1e-9 ? " OK" : " FALHOU") << endl;
+}
+
+static void microSelecao(const Ponto& alvo, int nIndv) {
+    Populacao pop, proxima;
+    pop.redimensionar(nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+    proxima.redimensionar(nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+    gerarPopulacaoInicial(pop);
+    avaliarPopulacao(pop, alvo);
+
+    string selecaoOriginal = c._sel;
+    const char* estrategias[] = {"_sel_rol", "_sel_tor", "_sel_sus"};
+    for (const char* nome : estrategias) {
+        c._sel = nome;
+        EstadoEvolutivo est;
+        const int REPETICOES = 50;
+        double inicio = agora();
+        for (int r = 0; r < REPETICOES; r++) {
+            est.geracao = r;
+            realizarSelecao(pop, proxima, est);
+        }
+        imprimirMicro(string("realizarSelecao") + nome + "_n" + to_string(nIndv), REPETICOES, agora() - inicio);
+    }
+    c._sel = selecaoOriginal;
+}
+
+/// @brief Execução interrompida e retomada do checkpoint contra a mesma execução sem
+/// interrupção: avaliações, vitória, catástrofes e melhor fitness devem ser idênticos.
+/// Mede também o custo de gravar e ler o checkpoint da população padrão.
+static void validarCheckpoint(const Ponto& alvo, int geracoes) {
+    const char* ARQUIVO = "benchmark_checkpoint.tmp";
+    string arquivoOriginal = c.arquivoCheckpoint;
+    int intervaloOriginal = c.intervaloCheckpoint;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.maxGeracoes = geracoes;
+
+    c.arquivoCheckpoint.clear();
+    definirSemente(SEMENTE_BENCHMARK);
+    ResultadoExecucao inteira = executarEvolucao(alvo, lim);
+    double fitnessInteira = melhorGeral.fitness;
+
+    // A primeira parte passa do checkpoint, como um processo morto entre dois checkpoints
+    c.arquivoCheckpoint = ARQUIVO;
+    c.intervaloCheckpoint = max(1, geracoes / 4);
+    LimitesExecucao parte = lim;
+    parte.maxGeracoes = 2 * c.intervaloCheckpoint + c.intervaloCheckpoint / 2;
+    definirSemente(SEMENTE_BENCHMARK);
+    executarEvolucao(alvo, parte);
+    c.retomarCheckpoint = true;
+    definirSemente(SEMENTE_BENCHMARK + 1); // a semente vem do checkpoint
+    ResultadoExecucao retomada = executarEvolucao(alvo, lim);
+    c.retomarCheckpoint = false;
+
+    bool igual = retomada.avaliacoes == inteira.avaliacoes && retomada.geracoes == inteira.geracoes &&
+                 retomada.geracaoPrimeiraVitoria == inteira.geracaoPrimeiraVitoria &&
+                 retomada.catastrofes == inteira.catastrofes && melhorGeral.fitness == fitnessInteira;
+    cout << "VALIDACAO checkpoint_retomada geracoes=" << geracoes << " retomada_em=" << 2 * c.intervaloCheckpoint
+         << " avaliacoes=" << inteira.avaliacoes << "/" << retomada.avaliacoes
+         << " fitness=" << fitnessInteira << "/" << melhorGeral.fitness << (igual ? " OK" : " FALHOU") << endl;
+
+    // Custo isolado (a população e o melhor global são os do fim da execução retomada)
+    Populacao pop, proxima;
+    QuadroCheckpoint quadro;
+    Individuo melhor;
+    const int REPETICOES = 20;
+    double inicio = agora();
+    for (int r = 0; r < REPETICOES; r++) lerCheckpoint(ARQUIVO, alvo, quadro, melhor, pop, proxima);
+    imprimirMicro("lerCheckpoint", REPETICOES, agora() - inicio);
+    inicio = agora();
+    for (int r = 0; r < REPETICOES; r++) gravarCheckpoint(ARQUIVO, alvo, quadro, melhor, pop, proxima);
+    imprimirMicro("gravarCheckpoint", REPETICOES, agora() - inicio);
+
+    remove(ARQUIVO);
+    c.arquivoCheckpoint = arquivoOriginal;
+    c.intervaloCheckpoint = intervaloOriginal;
+}
+
+/// @brief Modo lote contra a execução única de cada alvo: com a mesma semente e os mesmos
+/// limites, avaliações e melhor fitness devem ser idênticos. Mede também a vazão do lote
+/// (alvos resolvidos por segundo por núcleo, até a vitória ou o limite) contra a dos mesmos
+/// alvos resolvidos um a um com o pool inteiro em cada geração.
+static void validarLote(const Ponto* alvos, int nAlvos, int geracoes) {
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.maxGeracoes = geracoes;
+
+    vector<TarefaLote> tarefas(nAlvos);
+    for (int i = 0; i < nAlvos; i++) tarefas[i].alvo = alvos[i];
+    vector<SolucaoLote> solucoes;
+    definirSemente(SEMENTE_BENCHMARK);
+    resolverLote(tarefas, lim, solucoes);
+
+    int iguais = 0;
+    for (int i = 0; i < nAlvos; i++) {
+        definirSemente(SEMENTE_BENCHMARK);
+        ResultadoExecucao res = executarEvolucao(alvos[i], lim);
+        if (res.avaliacoes == solucoes[i].res.avaliacoes && melhorGeral.fitness == solucoes[i].melhor.fitness) iguais++;
+    }
+    cout << "VALIDACAO lote_igual_execucao_unica alvos=" << iguais << "/" << nAlvos
+         << (iguais == nAlvos ? " OK" : " FALHOU") << endl;
+
+    // Vazão: 4 cópias da bateria (alvos levemente deslocados), cada uma até a vitória
+    LimitesExecucao limVitoria = lim;
+    limVitoria.pararNaVitoria = true;
+    tarefas.clear();
+    for (int r = 0; r < 4; r++)
+        for (int i = 0; i < nAlvos; i++) {
+            TarefaLote t;
+            t.alvo = {alvos[i].x + 0.5 * r, alvos[i].y - 0.25 * r, alvos[i].z};
+            tarefas.push_back(t);
+        }
+
+    definirSemente(SEMENTE_BENCHMARK);
+    double inicio = agora();
+    int resolvidosSequencial = 0;
+    for (const TarefaLote& t : tarefas) {
+        ResultadoExecucao res = executarEvolucao(t.alvo, limVitoria);
+        if (res.geracaoPrimeiraVitoria >= 0) resolvidosSequencial++;
+    }
+    double segundosSequencial = agora() - inicio;
+
+    ResumoLote resumo = resolverLote(tarefas, limVitoria, solucoes);
+    int nucleos = pool->tamanho();
+    cout << "BENCH_LOTE alvos=" << resumo.alvos
+         << " nucleos=" << nucleos
+         << " resolvidos=" << resumo.resolvidos
+         << " roubos=" << resumo.roubos
+         << " lote_s=" << resumo.segundos
+         << " lote_resolvidos_por_s_por_nucleo=" << resumo.resolvidos / resumo.segundos / nucleos
+         << " sequencial_s=" << segundosSequencial
+         << " sequencial_resolvidos_por_s_por_nucleo=" << resolvidosSequencial / segundosSequencial / nucleos << endl;
+}
+
+// Replanejamento ao vivo (CanalReplanejamento): o alvo anda um pouco depois de 'aquecimento'
+// gerações; compara as avaliações até a vitória no alvo novo mantendo a população com as de
+// uma evolução nova. Depois, o prazo por geração pela metade do tempo medido sem prazo.
+static void validarReplanejamento(const Ponto* alvos, int nAlvos, int geracoes) {
+    const int aquecimento = 40;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.pararNaVitoria = true;
+
+    int vitoriasMantida = 0, vitoriasNova = 0;
+    long long avaliacoesMantida = 0, avaliacoesNova = 0;
+    for (int i = 0; i < nAlvos; i++) {
+        Ponto novo = {alvos[i].x + 1.0, alvos[i].y - 0.5, alvos[i].z + 0.5};
+
+        EstadoLaco estado;
+        CanalReplanejamento canal;
+        LimitesExecucao limMantida = lim;
+        limMantida.pararNaVitoria = false;
+        limMantida.estado = &estado;
+        limMantida.maxGeracoes = aquecimento;
+        definirSemente(SEMENTE_BENCHMARK);
+        long long antes = executarEvolucao(alvos[i], limMantida).avaliacoes;
+
+        canal.moverAlvo(novo);
+        limMantida.pararNaVitoria = true;
+        limMantida.replanejamento = &canal;
+        limMantida.maxGeracoes = aquecimento + geracoes;
+        ResultadoExecucao res = executarEvolucao(alvos[i], limMantida);
+        if (melhorGeral.venceu) {
+            vitoriasMantida++;
+            avaliacoesMantida += res.avaliacoes - antes;
+        }
+
+        LimitesExecucao limNova = lim;
+        limNova.maxGeracoes = geracoes;
+        definirSemente(SEMENTE_BENCHMARK);
+        res = executarEvolucao(novo, limNova);
+        if (res.geracaoPrimeiraVitoria >= 0) {
+            vitoriasNova++;
+            avaliacoesNova += res.avaliacoesPrimeiraVitoria;
+        }
+    }
+    cout << "BENCH_REPLAN alvos=" << nAlvos
+         << " mantida_vitorias=" << vitoriasMantida
+         << " mantida_avaliacoes_ate_vitoria_media=" << (vitoriasMantida ? avaliacoesMantida / vitoriasMantida : -1)
+         << " nova_vitorias=" << vitoriasNova
+         << " nova_avaliacoes_ate_vitoria_media=" << (vitoriasNova ? avaliacoesNova / vitoriasNova : -1) << endl;
+
+    LimitesExecucao limPrazo;
+    limPrazo.streaming = false;
+    limPrazo.maxGeracoes = geracoes;
+    definirSemente(SEMENTE_BENCHMARK);
+    ResultadoExecucao livre = executarEvolucao(alvos[0], limPrazo);
+    limPrazo.prazoGeracao = 0.5 * livre.segundos / livre.geracoes;
+    definirSemente(SEMENTE_BENCHMARK);
+    ResultadoExecucao comPrazo = executarEvolucao(alvos[0], limPrazo);
+    cout << "BENCH_PRAZO prazo_ms=" << 1000.0 * limPrazo.prazoGeracao
+         << " livre_geracao_ms=" << 1000.0 * livre.segundos / livre.geracoes
+         << " prazo_geracao_ms=" << 1000.0 * comPrazo.segundos / comPrazo.geracoes
+         << " estouros=" << comPrazo.prazosEstourados << "/" << comPrazo.geracoes
+         << " livre_avaliacoes=" << livre.avaliacoes
+         << " prazo_avaliacoes=" << comPrazo.avaliacoes << endl;
+
+    // Um prazo apertado encolhe a população; com folga nas gerações seguintes ela volta a nIndv
+    EstadoLaco estado;
+    LimitesExecucao limEstado = limPrazo;
+    limEstado.estado = &estado;
+    limEstado.maxGeracoes = 20;
+    limEstado.prazoGeracao = 1e-7;
+    definirSemente(SEMENTE_BENCHMARK);
+    executarEvolucao(alvos[0], limEstado);
+    int encolhida = estado.pop.tamanho();
+    limEstado.maxGeracoes = 22;
+    limEstado.prazoGeracao = 10.0;
+    executarEvolucao(alvos[0], limEstado);
+    int recuperada = estado.pop.tamanho();
+    cout << "VALIDACAO prazo_recupera_populacao encolhida=" << encolhida << " recuperada=" << recuperada << "/"
+         << c.nIndv << (encolhida < c.nIndv && recuperada == c.nIndv ? " OK" : " FALHA") << endl;
+}
+
+/// @brief Genoma por pontos de controle (Config::_gen = "_gen_spline"): lote contra
+/// calcularFitness com a expansão da curva, e reavaliação incremental contra a completa.
+static void validarGenomaSpline(const Ponto& alvo, int geracoes) {
+    string genOriginal = c._gen;
+    definirConfig("_gen", "_gen_spline");
+    montarGenoma();
+
+    const int N = 400;
+    vector<vector<double>> genomas = genomasAleatorios(N);
+    ParametrosLote prm = montarParametrosLote(alvo);
+    for (int nivel = SIMD_ESCALAR; nivel <= (int)detectarSimd(); nivel++) {
+        int largura = larguraLote((NivelSimd)nivel);
+        double erroMaximo = 0.0;
+        int divergencias = 0;
+        for (int i = 0; i + largura <= N; i += largura) {
+            LaneLote lanes[LARGURA_MAXIMA_LOTE];
+            Avaliacao av[LARGURA_MAXIMA_LOTE];
+            for (int l = 0; l < largura; l++) lanes[l] = {genomas[i + l].data(), nullptr, 1};
+            avaliarLote((NivelSimd)nivel, prm, lanes, largura, av);
+            for (int l = 0; l < largura; l++) {
+                Avaliacao ref;
+                calcularFitness(genomas[i + l].data(), alvo, ref);
+                erroMaximo = max(erroMaximo, fabs(ref.fitness - av[l].fitness) / max(1.0, fabs(ref.fitness)));
+                if (ref.venceu != av[l].venceu || ref.passoVitoria != av[l].passoVitoria) divergencias++;
+            }
+        }
+        cout << "VALIDACAO genoma_spline_lote_" << nomeSimd((NivelSimd)nivel)
+             << " controles=" << c.nGenes
+             << " erro_relativo_max=" << erroMaximo
+             << " divergencias_vitoria=" << divergencias
+             << (erroMaximo <= TOLERANCIA_LOTE && divergencias == 0 ? " OK" : " FALHOU") << endl;
+    }
+
+    // A reavaliação incremental (primeiro passo do primeiro controle alterado) não pode mudar nada
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.maxGeracoes = geracoes;
+    definirSemente(SEMENTE_BENCHMARK);
+    ResultadoExecucao incremental = executarEvolucao(alvo, lim);
+    double fitnessIncremental = melhorGeral.fitness;
+    c.reavaliacaoIncremental = false;
+    definirSemente(SEMENTE_BENCHMARK);
+    ResultadoExecucao completa = executarEvolucao(alvo, lim);
+    c.reavaliacaoIncremental = true;
+    cout << "VALIDACAO genoma_spline_incremental geracoes=" << geracoes
+         << " fitness=" << fitnessIncremental << "/" << melhorGeral.fitness
+         << " avaliacoes=" << incremental.avaliacoes << "/" << completa.avaliacoes
+         << (fitnessIncremental == melhorGeral.fitness ? " OK" : " FALHOU") << endl;
+
+    definirConfig("_gen", genOriginal);
+    montarGenoma();
+}
+
+/// @brief Reavaliação incremental do caminho escalar (_simd_off e braços sem lote): retomar
+/// do cache de prefixo não pode mudar nada em relação a simular cada trajetória inteira.
+static void validarIncrementalEscalar(const Ponto& alvo, int geracoes) {
+    string simdOriginal = c._simd;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.maxGeracoes = geracoes;
+
+    const char* bracos[] = {"_braco_3r", "_braco_6r"};
+    for (const char* nome : bracos) {
+        selecionarBraco(nome);
+        c._simd = "_simd_off";
+        definirSemente(SEMENTE_BENCHMARK);
+        ResultadoExecucao incremental = executarEvolucao(alvo, lim);
+        double fitnessIncremental = melhorGeral.fitness;
+        c.reavaliacaoIncremental = false;
+        definirSemente(SEMENTE_BENCHMARK);
+        ResultadoExecucao completa = executarEvolucao(alvo, lim);
+        c.reavaliacaoIncremental = true;
+        cout << "VALIDACAO escalar_incremental" << (nome + 6) << " geracoes=" << geracoes
+             << " fitness=" << fitnessIncremental << "/" << melhorGeral.fitness
+             << " avaliacoes=" << incremental.avaliacoes << "/" << completa.avaliacoes
+             << (fitnessIncremental == melhorGeral.fitness ? " OK" : " FALHOU") << endl;
+    }
+    selecionarBraco("_braco_3r");
+    c._simd = simdOriginal;
+}
+
+/// @brief Avaliações até a vitória e memória da população de cada representação do genoma,
+/// na bateria inteira.
+static void compararGenomas(const Ponto* alvos, int nAlvos, const Obstaculo* obstaculos, int nObstaculos,
+                            int geracoes) {
+    string genOriginal = c._gen;
+    int controlesOriginal = c.nControles;
+    Obstaculo obstaculoOriginal = c.bolaDeDemolicao;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.pararNaVitoria = true;
+    lim.maxGeracoes = geracoes;
+
+    const char* modos[] = {"_gen_vel", "_gen_spline", "_gen_spline", "_gen_spline"};
+    const int controles[] = {0, 6, 8, 12};
+    for (int m = 0; m < 4; m++) {
+        definirConfig("_gen", modos[m]);
+        if (controles[m] > 0) definirConfig("nControles", to_string(controles[m]));
+
+        int vitorias = 0;
+        long long avaliacoesAteVitoria = 0;
+        double segundosAteVitoria = 0.0;
+        for (int o = 0; o < nObstaculos; o++) {
+            c.bolaDeDemolicao = obstaculos[o];
+            for (int a = 0; a < nAlvos; a++) {
+                definirSemente(SEMENTE_BENCHMARK);
+                ResultadoExecucao res = executarEvolucao(alvos[a], lim);
+                if (res.geracaoPrimeiraVitoria < 0) continue;
+                vitorias++;
+                avaliacoesAteVitoria += res.avaliacoesPrimeiraVitoria;
+                segundosAteVitoria += res.segundosPrimeiraVitoria;
+            }
+        }
+
+        Populacao pop;
+        pop.redimensionar(c.nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+        cout << "BENCH_GENOMA modo=" << modos[m]
+             << " genes=" << c.nGenes
+             << " vitorias=" << vitorias << "/" << nAlvos * nObstaculos
+             << " primeira_vitoria_avaliacoes_media=" << (vitorias ? avaliacoesAteVitoria / vitorias : -1)
+             << " primeira_vitoria_s_media=" << (vitorias ? segundosAteVitoria / vitorias : -1.0)
+             << " populacao_genomas_bytes=" << pop.bytesGenomas()
+             << " populacao_total_bytes=" << pop.bytesTotais() << endl;
+    }
+
+    c.nControles = controlesOriginal;
+    definirConfig("_gen", genOriginal);
+    c.bolaDeDemolicao = obstaculoOriginal;
+}
+
+int main(int argc, char* argv[]) {
+    int geracoes = 200;
+    for (int i = 1; i < argc; i++) {
+        string opcao = argv[i];
+        if (opcao == "--geracoes" && i + 1 < argc) geracoes = atoi(argv[++i]);
+        else if (opcao == "--threads" && i + 1 < argc) c.nThreads = atoi(argv[++i]);
+        else {
+            cerr << "Uso: " << argv[0] << " [--geracoes N] [--threads N]" << endl;
+            return 1;
+        }
+    }
+
+    c.listaPNumGene.assign(c.nGenes, 1.0/c.nGenes);
+    c.listaPCadaGene.assign(c.nGenes, 1.0/c.nGenes);
+    definirSemente(SEMENTE_BENCHMARK);
+    inicializarParalelismo(c.nThreads);
+
+    cout << "INFO threads=" << pool->tamanho()
+         << " simd=" << nomeSimd(escolherSimd())
+         << " nIndv=" << c.nIndv << " nWaypoints=" << c.nWaypoints
+         << " semente=" << SEMENTE_BENCHMARK << endl;
+
+    // Microbenchmarks (na cena padrão: só a bola de demolição)
+    Ponto alvoMicro = {15.0, 3.0, 4.0};
+    montarBraco();
+    montarCena();
+    microAleatorio();
+    microCinematica();
+    microBraco();
+    microCena();
+    microFitness(alvoMicro);
+    validarTrigRapida(alvoMicro);
+    validarCinematicaInversa();
+    microSelecao(alvoMicro, c.nIndv);
+    microSelecao(alvoMicro, 1000);
+
+    // Bateria fixa: cada alvo contra cada configuração de obstáculo
+    const Ponto alvos[] = {
+        {15.0, 3.0, 4.0}, {10.0, -8.0, 6.0}, {5.0, 5.0, 14.0}, {-12.0, 4.0, 2.0}, {0.0, -15.0, 8.0}
+    };
+    const Obstaculo obstaculos[] = {
+        {0.0, 0.0, 0.0, 0.0},     // sem obstáculo
+        {10.0, 5.0, 5.0, 5.0},    // bola de demolição padrão
+        {8.0, 0.0, 8.0, 3.0}
+    };
+
+    Obstaculo obstaculoOriginal = c.bolaDeDemolicao;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    lim.maxGeracoes = geracoes;
+
+    int execucoes = 0, vitorias = 0;
+    double segundosTotal = 0.0;
+    long long avaliacoesTotal = 0, geracoesTotal = 0;
+    for (const Obstaculo& obs : obstaculos) {
+        c.bolaDeDemolicao = obs;
+        for (const Ponto& alvo : alvos) {
+            definirSemente(SEMENTE_BENCHMARK);
+            ResultadoExecucao res = executarEvolucao(alvo, lim);
+            imprimirResultado("BENCH", alvo, res);
+
+            execucoes++;
+            if (res.geracaoPrimeiraVitoria >= 0) vitorias++;
+            segundosTotal += res.segundos;
+            avaliacoesTotal += res.avaliacoes;
+            geracoesTotal += res.geracoes;
+        }
+    }
+    c.bolaDeDemolicao = obstaculoOriginal;
+
+    cout << "RESUMO execucoes=" << execucoes
+         << " vitorias=" << vitorias
+         << " segundos=" << segundosTotal
+         << " geracoes_por_s=" << geracoesTotal / segundosTotal
+         << " avaliacoes_por_s=" << avaliacoesTotal / segundosTotal << endl;
+
+    // Tempo até o primeiro acerto com e sem as sementes de cinemática inversa (mesma bateria)
+    LimitesExecucao limVitoria = lim;
+    limVitoria.pararNaVitoria = true;
+    string ikOriginal = c._ik;
+    const char* modosIK[] = {"_ik_off", "_ik_on"};
+    for (const char* modo : modosIK) {
+        c._ik = modo;
+        int vitoriasIK = 0;
+        double segundosAteVitoria = 0.0;
+        long long avaliacoesAteVitoria = 0;
+        for (const Obstaculo& obs : obstaculos) {
+            c.bolaDeDemolicao = obs;
+            for (const Ponto& alvo : alvos) {
+                definirSemente(SEMENTE_BENCHMARK);
+                ResultadoExecucao res = executarEvolucao(alvo, limVitoria);
+                if (res.geracaoPrimeiraVitoria < 0) continue;
+                vitoriasIK++;
+                segundosAteVitoria += res.segundosPrimeiraVitoria;
+                avaliacoesAteVitoria += res.avaliacoes;
+            }
+        }
+        cout << "BENCH_IK modo=" << modo
+             << " vitorias=" << vitoriasIK << "/" << execucoes
+             << " primeira_vitoria_s_media=" << (vitoriasIK ? segundosAteVitoria / vitoriasIK : -1.0)
+             << " avaliacoes_ate_vitoria_media=" << (vitoriasIK ? avaliacoesAteVitoria / vitoriasIK : -1) << endl;
+    }
+    c._ik = ikOriginal;
+    c.bolaDeDemolicao = obstaculoOriginal;
+
+    // Gerações e avaliações até o primeiro acerto do AG puro e de cada busca local (mesma bateria)
+    string locOriginal = c._loc;
+    const char* modosLocal[] = {"_loc_off", "_loc_coord", "_loc_es"};
+    for (const char* modo : modosLocal) {
+        c._loc = modo;
+        int vitoriasLocal = 0;
+        long long geracoesAteVitoria = 0, avaliacoesAteVitoria = 0;
+        double segundosAteVitoria = 0.0;
+        for (const Obstaculo& obs : obstaculos) {
+            c.bolaDeDemolicao = obs;
+            for (const Ponto& alvo : alvos) {
+                definirSemente(SEMENTE_BENCHMARK);
+                ResultadoExecucao res = executarEvolucao(alvo, limVitoria);
+                if (res.geracaoPrimeiraVitoria < 0) continue;
+                vitoriasLocal++;
+                geracoesAteVitoria += res.geracaoPrimeiraVitoria;
+                avaliacoesAteVitoria += res.avaliacoesPrimeiraVitoria;
+                segundosAteVitoria += res.segundosPrimeiraVitoria;
+            }
+        }
+        cout << "BENCH_LOCAL modo=" << modo
+             << " vitorias=" << vitoriasLocal << "/" << execucoes
+             << " primeira_vitoria_geracao_media=" << (vitoriasLocal ? (double)geracoesAteVitoria / vitoriasLocal : -1.0)
+             << " primeira_vitoria_avaliacoes_media=" << (vitoriasLocal ? avaliacoesAteVitoria / vitoriasLocal : -1)
+             << " primeira_vitoria_s_media=" << (vitoriasLocal ? segundosAteVitoria / vitoriasLocal : -1.0) << endl;
+    }
+    c._loc = locOriginal;
+    c.bolaDeDemolicao = obstaculoOriginal;
+
+    validarCheckpoint(alvos[0], geracoes);
+    validarLote(alvos, (int)(sizeof(alvos) / sizeof(alvos[0])), geracoes);
+    validarReplanejamento(alvos, (int)(sizeof(alvos) / sizeof(alvos[0])), geracoes);
+    validarGenomaSpline(alvos[0], geracoes);
+    validarIncrementalEscalar(alvos[0], geracoes);
+    compararGenomas(alvos, (int)(sizeof(alvos) / sizeof(alvos[0])), obstaculos,
+                    (int)(sizeof(obstaculos) / sizeof(obstaculos[0])), geracoes);
+
+    if (sumidouro == 12345.678) cout << endl;
+    return 0;
+}
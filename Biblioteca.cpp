@@ -0,0 +1,228 @@
+#include "Biblioteca.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Robot.h"
+#include "Paralelo.h"
+#include "Execucao.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <thread>
+
+using namespace std;
+
+/// @brief Estado de um solver. O motor é um só por processo e trabalha com as globais
+/// (Config c, cena, braço, mapa de colisão, melhorGeral e as populações de Execucao.cpp):
+/// cada chamada copia a configuração do solver para 'c' e troca o laço guardado em 'estado'
+/// com o de Execucao.cpp, sob uma trava única (ver Biblioteca.h).
+struct BrasilSolver {
+    Config config;
+    unsigned int semente;
+    Ponto alvo;
+    EstadoLaco estado;
+    ResultadoExecucao ultimo;
+    CanalReplanejamento canal; // movimentos para a próxima execução da evolução em curso
+};
+
+// Serializa todas as chamadas que tocam nas globais do motor
+static mutex travaMotor;
+
+/// @brief Põe a configuração do solver nas globais e garante o pool com as threads pedidas.
+static void ativar(BrasilSolver* s) {
+    c = s->config;
+    int threads = c.nThreads > 0 ? c.nThreads : (int)thread::hardware_concurrency();
+    if (!pool || pool->tamanho() != max(1, threads)) inicializarParalelismo(c.nThreads);
+}
+
+/// @brief A evolução atual não vale mais (configuração, alvo ou cena mudaram); os buffers
+/// das populações ficam alocados para a próxima.
+static void recomecar(BrasilSolver* s) {
+    s->estado.valido = false;
+    s->canal.descartar();
+    s->ultimo = ResultadoExecucao();
+    s->estado.melhor = Individuo();
+}
+
+/// @brief Lê esferas e caixas no formato da API.
+static void lerObstaculos(const double* esferas, int nEsferas, const double* caixas, int nCaixas,
+                          vector<Obstaculo>& listaEsferas, vector<Caixa>& listaCaixas) {
+    listaEsferas.resize(nEsferas);
+    for (int i = 0; i < nEsferas; i++) {
+        const double* e = esferas + 4 * i;
+        listaEsferas[i] = {e[0], e[1], e[2], e[3]};
+    }
+    listaCaixas.resize(nCaixas);
+    for (int i = 0; i < nCaixas; i++) {
+        const double* b = caixas + 6 * i;
+        for (int k = 0; k < 3; k++) {
+            listaCaixas[i].min[k] = min(b[k], b[k + 3]);
+            listaCaixas[i].max[k] = max(b[k], b[k + 3]);
+        }
+    }
+}
+
+static bool obstaculosValidos(const double* esferas, int nEsferas, const double* caixas, int nCaixas) {
+    return nEsferas >= 0 && nCaixas >= 0 && (nEsferas == 0 || esferas) && (nCaixas == 0 || caixas);
+}
+
+static void preencher(const BrasilSolver* s, BrasilEstatisticas* saida) {
+    const Individuo& melhor = s->estado.melhor;
+    saida->geracoes = s->ultimo.geracoes;
+    saida->avaliacoes = s->ultimo.avaliacoes;
+    saida->segundos = s->ultimo.segundos;
+    saida->melhorFitness = melhor.fitness;
+    saida->venceu = melhor.venceu ? 1 : 0;
+    saida->passoVitoria = melhor.passoVitoria;
+    saida->geracaoPrimeiraVitoria = s->ultimo.geracaoPrimeiraVitoria;
+    saida->avaliacoesPrimeiraVitoria = s->ultimo.avaliacoesPrimeiraVitoria;
+    saida->catastrofes = s->ultimo.catastrofes;
+    saida->desfecho = (int)s->ultimo.desfecho;
+}
+
+extern "C" {
+
+BrasilSolver* brasil_criar(unsigned int semente) {
+    BrasilSolver* s = new (nothrow) BrasilSolver();
+    if (!s) return nullptr;
+    s->config.arquivoCache.clear();
+    s->config.arquivoMapa.clear();
+    lock_guard<mutex> trava(travaMotor);
+    definirSemente(semente);
+    s->semente = sementeBase;
+    s->alvo = {20.0, 0.0, 0.0};
+    return s;
+}
+
+void brasil_destruir(BrasilSolver* solver) {
+    lock_guard<mutex> trava(travaMotor);
+    delete solver;
+}
+
+int brasil_configurar(BrasilSolver* solver, const char* chave, const char* valor) {
+    if (!solver || !chave || !valor) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    try {
+        c = solver->config;
+        if (!definirConfig(chave, valor)) return -1;
+        solver->config = c;
+        recomecar(solver);
+    } catch (const bad_alloc&) {
+        return -1;
+    }
+    return 0;
+}
+
+int brasil_definir_alvo(BrasilSolver* solver, double x, double y, double z) {
+    if (!solver) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    solver->alvo = {x, y, z};
+    recomecar(solver);
+    return 0;
+}
+
+int brasil_definir_obstaculos(BrasilSolver* solver, const double* esferas, int nEsferas,
+                              const double* caixas, int nCaixas) {
+    if (!solver || !obstaculosValidos(esferas, nEsferas, caixas, nCaixas)) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    try {
+        Config& cfg = solver->config;
+        cfg.bolaDeDemolicao.raio = 0.0;
+        cfg.arquivoCena.clear();
+        lerObstaculos(esferas, nEsferas, caixas, nCaixas, cfg.esferasCena, cfg.caixasCena);
+        recomecar(solver);
+    } catch (const bad_alloc&) {
+        return -1;
+    }
+    return 0;
+}
+
+int brasil_mover_alvo(BrasilSolver* solver, double x, double y, double z) {
+    if (!solver) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    solver->alvo = {x, y, z};
+    if (solver->estado.valido) solver->canal.moverAlvo(solver->alvo);
+    else recomecar(solver);
+    return 0;
+}
+
+int brasil_mover_obstaculos(BrasilSolver* solver, const double* esferas, int nEsferas,
+                            const double* caixas, int nCaixas) {
+    if (!solver || !obstaculosValidos(esferas, nEsferas, caixas, nCaixas)) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    try {
+        // A configuração do solver já fica com a cena nova; o canal a leva para dentro do laço
+        Config& cfg = solver->config;
+        cfg.bolaDeDemolicao.raio = 0.0;
+        cfg.arquivoCena.clear();
+        lerObstaculos(esferas, nEsferas, caixas, nCaixas, cfg.esferasCena, cfg.caixasCena);
+        if (solver->estado.valido) {
+            solver->canal.moverObstaculo(cfg.bolaDeDemolicao);
+            solver->canal.substituirObstaculos(cfg.esferasCena, cfg.caixasCena);
+        } else {
+            recomecar(solver);
+        }
+    } catch (const bad_alloc&) {
+        return -1;
+    }
+    return 0;
+}
+
+int brasil_executar(BrasilSolver* solver, int geracoes, int pararNaVitoria, BrasilEstatisticas* saida) {
+    if (!solver || geracoes <= 0) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    try {
+        ativar(solver);
+        sementeBase = solver->semente;
+
+        LimitesExecucao lim;
+        lim.streaming = false;
+        lim.pararNaVitoria = pararNaVitoria != 0;
+        lim.estado = &solver->estado;
+        lim.replanejamento = &solver->canal;
+        // maxGeracoes conta desde o começo da evolução
+        lim.maxGeracoes = (solver->estado.valido ? solver->estado.quadro.est.geracao : 0) + geracoes;
+        // Com um movimento pendente o laço retoma no alvo antigo e o canal o leva ao novo
+        Ponto alvo = solver->estado.valido ? solver->estado.alvo : solver->alvo;
+        solver->ultimo = executarEvolucao(alvo, lim);
+        // O modelo de ilhas não guarda o laço: cada chamada é uma evolução nova
+        if (c.nIlhas > 1) solver->estado.melhor = melhorGeral;
+
+        // A trajetória só é reconstruída aqui, uma vez por chamada
+        registrarTrajetoria(solver->estado.melhor, solver->alvo);
+    } catch (const bad_alloc&) {
+        recomecar(solver);
+        return -1;
+    }
+    if (saida) preencher(solver, saida);
+    return 0;
+}
+
+int brasil_estatisticas(const BrasilSolver* solver, BrasilEstatisticas* saida) {
+    if (!solver || !saida) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    preencher(solver, saida);
+    return 0;
+}
+
+int brasil_trajetoria(const BrasilSolver* solver, double* xyz, int capacidade) {
+    if (!solver || (capacidade > 0 && !xyz)) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    const vector<Ponto>& t = solver->estado.melhor.trajetoria;
+    int n = min(capacidade, (int)t.size());
+    for (int i = 0; i < n; i++) {
+        xyz[3 * i] = t[i].x;
+        xyz[3 * i + 1] = t[i].y;
+        xyz[3 * i + 2] = t[i].z;
+    }
+    return (int)t.size();
+}
+
+int brasil_genoma(const BrasilSolver* solver, double* destino, int capacidade) {
+    if (!solver || (capacidade > 0 && !destino)) return -1;
+    lock_guard<mutex> trava(travaMotor);
+    const vector<double>& g = solver->estado.melhor.genoma;
+    copy(g.begin(), g.begin() + max(0, min(capacidade, (int)g.size())), destino);
+    return (int)g.size();
+}
+
+}
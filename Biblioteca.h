@@ -0,0 +1,94 @@
+#ifndef BIBLIOTECA_H
+#define BIBLIOTECA_H
+
+/* API em C da biblioteca compartilhada (make biblioteca: libbrasil.so / brasil.dll), para
+ * usar o motor dentro do próprio processo (ctypes no Python, controladores em C/C++) sem
+ * iniciar o executável nem interpretar o stdout.
+ *
+ * Há um único motor por processo. O motor trabalha sobre estado global (configuração,
+ * cena, braço, mapa de colisão, populações e pool de threads), e uma trava única serializa
+ * todas as chamadas de todos os solvers. Dois solvers nunca executam ao mesmo tempo: cada
+ * brasil_executar ocupa o motor e o pool inteiros até voltar. As chamadas podem vir de
+ * qualquer thread. Para resolver vários problemas em paralelo, use um processo por solver
+ * ou o modo lote do executável.
+ *
+ * Um solver guarda só a sua configuração (cópia de Config), o alvo, os obstáculos e, entre
+ * as chamadas, o laço de população única (populações, melhor, estagnação e semente). Cada
+ * brasil_executar copia a configuração para o motor e troca o laço guardado para dentro
+ * dele, então a evolução continua de uma chamada para a próxima exatamente como uma execução
+ * única. Com "nIlhas" > 1 nada é guardado entre as chamadas: cada uma recomeça a evolução.
+ *
+ * Mudar configuração, alvo ou obstáculos recomeça a evolução do zero na próxima execução;
+ * brasil_mover_alvo e brasil_mover_obstaculos mudam o problema sem recomeçar (replanejamento).
+ * Funções que devolvem int: < 0 é erro (solver nulo, chave inválida ou falta de memória).
+ * Os buffers são sempre do chamador. */
+
+#ifdef _WIN32
+#define BRASIL_API __declspec(dllexport)
+#else
+#define BRASIL_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct BrasilSolver BrasilSolver;
+
+/* Medidas acumuladas desde o começo da evolução atual */
+typedef struct {
+    int geracoes;
+    long long avaliacoes;
+    double segundos;                 /* tempo de execução somado das chamadas */
+    double melhorFitness;
+    int venceu;                      /* 1 se o melhor alcança o alvo; colisões não contam */
+    int passoVitoria;                /* passo em que alcança (válido com venceu) */
+    int geracaoPrimeiraVitoria;      /* -1 sem vitória */
+    long long avaliacoesPrimeiraVitoria;
+    int catastrofes;
+    int desfecho;                    /* 1 = SOLVED, 2 = GAVE_UP na última chamada (DesfechoExecucao) */
+} BrasilEstatisticas;
+
+/* Solver com a configuração padrão, alvo (20, 0, 0) e a bola de demolição padrão.
+ * semente 0 sorteia uma; com a mesma semente os resultados se repetem. */
+BRASIL_API BrasilSolver* brasil_criar(unsigned int semente);
+BRASIL_API void brasil_destruir(BrasilSolver* solver);
+
+/* Altera um campo da configuração pelo nome, como o comando SET do modo servidor
+ * (ex.: "nIndv", "100"; "_braco", "_braco_6r"; "_loc", "_loc_es"). 0 = ok. */
+BRASIL_API int brasil_configurar(BrasilSolver* solver, const char* chave, const char* valor);
+
+BRASIL_API int brasil_definir_alvo(BrasilSolver* solver, double x, double y, double z);
+
+/* Substitui todos os obstáculos (inclusive a bola de demolição e a cena de arquivo).
+ * esferas: nEsferas x (x, y, z, raio); caixas: nCaixas x (xmin, ymin, zmin, xmax, ymax, zmax). */
+BRASIL_API int brasil_definir_obstaculos(BrasilSolver* solver, const double* esferas, int nEsferas,
+                                         const double* caixas, int nCaixas);
+
+/* Como brasil_definir_alvo e brasil_definir_obstaculos, mas a evolução em curso continua: a
+ * próxima execução reavalia a população inteira contra o problema novo e segue dali (alvo ou
+ * obstáculo em movimento). Antes da primeira execução equivalem às funções de definir. */
+BRASIL_API int brasil_mover_alvo(BrasilSolver* solver, double x, double y, double z);
+BRASIL_API int brasil_mover_obstaculos(BrasilSolver* solver, const double* esferas, int nEsferas,
+                                       const double* caixas, int nCaixas);
+
+/* Executa mais 'geracoes' gerações (ou até pararNaVitoria, se pedido) e preenche 'saida'
+ * (pode ser nulo). 0 = ok. */
+BRASIL_API int brasil_executar(BrasilSolver* solver, int geracoes, int pararNaVitoria, BrasilEstatisticas* saida);
+
+BRASIL_API int brasil_estatisticas(const BrasilSolver* solver, BrasilEstatisticas* saida);
+
+/* Trajetória cartesiana da ponta do melhor indivíduo: até 'capacidade' pontos (x, y, z) em
+ * 'xyz'. Devolve a quantidade total de pontos (0 antes da primeira execução). */
+BRASIL_API int brasil_trajetoria(const BrasilSolver* solver, double* xyz, int capacidade);
+
+/* Genoma do melhor indivíduo (nGenes x nJuntas velocidades, ou pontos de controle com
+ * "_gen" = "_gen_spline", junta variando mais rápido): até 'capacidade' valores em 'destino'.
+ * Devolve o tamanho total do genoma. */
+BRASIL_API int brasil_genoma(const BrasilSolver* solver, double* destino, int capacidade);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
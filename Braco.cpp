@@ -0,0 +1,170 @@
+#define _USE_MATH_DEFINES
+
+#include "Braco.h"
+#include "Config.h"
+#include "Trig.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+ModeloBraco braco = {};
+
+/// @brief Cosseno e seno de um ângulo em graus, exatos para múltiplos de 90 graus
+/// (cos(90°) em ponto flutuante daria 6e-17 em vez de 0 e a cadeia perderia a exatidão).
+static void cossenoSeno(double graus, double& cs, double& sn) {
+    double r = fmod(graus, 360.0);
+    if (r < 0) r += 360.0;
+    if (r == 0.0) { cs = 1.0; sn = 0.0; }
+    else if (r == 90.0) { cs = 0.0; sn = 1.0; }
+    else if (r == 180.0) { cs = -1.0; sn = 0.0; }
+    else if (r == 270.0) { cs = 0.0; sn = -1.0; }
+    else { cs = cos(graus * (M_PI / 180.0)); sn = sin(graus * (M_PI / 180.0)); }
+}
+
+/// @brief Seno e cosseno (radianos) no modo escolhido por Config::_trig.
+template <bool Rapida>
+inline void senoCosseno(double x, double& sn, double& cs) {
+    if (Rapida) sincosRapido(x, sn, cs);
+    else { cs = cos(x); sn = sin(x); }
+}
+
+/// @brief Cinemática direta de todas as juntas (ver ModeloBraco).
+/// @param m Modelo do braço.
+/// @param angulos Ângulos das juntas em graus.
+/// @param origens Recebe nJuntas + 1 pontos: a base e a extremidade de cada junta.
+template <int N, bool Rapida>
+void cadeiaCinematica(const ModeloBraco& m, const double* angulos, Ponto* origens) {
+    const int n = N > 0 ? N : m.nJuntas;
+    const double grausParaRad = M_PI / 180.0;
+
+    // Ângulos acumulados de cada trecho de eixos paralelos; os senos e cossenos não dependem
+    // da geometria e saem todos antes dela (as chamadas ficam independentes entre si)
+    double cp[N > 0 ? N : MAX_JUNTAS], sp[N > 0 ? N : MAX_JUNTAS];
+    double phi = 0.0;
+    for (int i = 0; i < n; i++) {
+        phi = (i > 0 && m.fechaTrecho[i - 1] ? 0.0 : phi) + (m.sinal[i] * angulos[i] * grausParaRad + m.offset[i]);
+        senoCosseno<Rapida>(phi, sp[i], cp[i]);
+    }
+
+    // Referencial (colunas x, y, z) e origem no início do trecho atual. Escalares soltos em
+    // vez de matrizes: ficam em registradores
+    double r00 = 1.0, r01 = 0.0, r02 = 0.0;
+    double r10 = 0.0, r11 = 1.0, r12 = 0.0;
+    double r20 = 0.0, r21 = 0.0, r22 = 1.0;
+    double ox = 0.0, oy = 0.0, oz = 0.0;
+    // Deslocamento dentro do trecho
+    double u = 0.0, v = 0.0, w = 0.0;
+
+    origens[0] = {0.0, 0.0, 0.0};
+    for (int i = 0; i < n; i++) {
+        u += m.a[i] * cp[i];
+        v += m.a[i] * sp[i];
+        w += m.d[i];
+
+        double px = ox + (r00 * u + r01 * v + r02 * w);
+        double py = oy + (r10 * u + r11 * v + r12 * w);
+        double pz = oz + (r20 * u + r21 * v + r22 * w);
+        origens[i + 1] = {px, py, pz};
+        if (!m.fechaTrecho[i] || i == n - 1) continue;
+
+        // Eixo seguinte não é paralelo: R = R * Rz(phi) * Rx(alfa)
+        double c = cp[i], s = sp[i], ca = m.cosAlfa[i], sa = m.sinAlfa[i];
+        double x0 = r00 * c + r01 * s, y0 = r01 * c - r00 * s;
+        double x1 = r10 * c + r11 * s, y1 = r11 * c - r10 * s;
+        double x2 = r20 * c + r21 * s, y2 = r21 * c - r20 * s;
+        r00 = x0; r01 = ca * y0 + sa * r02; r02 = ca * r02 - sa * y0;
+        r10 = x1; r11 = ca * y1 + sa * r12; r12 = ca * r12 - sa * y1;
+        r20 = x2; r21 = ca * y2 + sa * r22; r22 = ca * r22 - sa * y2;
+        ox = px; oy = py; oz = pz;
+        u = v = w = 0.0;
+    }
+}
+
+/// @brief Forma fechada do braço clássico (base + ombro + cotovelo, ver classico3R): as
+/// mesmas operações que a cadeia faria nesse caso, sem o referencial genérico.
+template <bool Rapida>
+static void cadeiaClassica3R(const ModeloBraco& m, const double* angulos, Ponto* origens) {
+    double angulo_base = angulos[0] * (M_PI / 180.0);
+    double angulo_ombro = angulos[1] * (M_PI / 180.0);
+    double angulo_abs = angulo_ombro - angulos[2] * (M_PI / 180.0);
+
+    double so, co, sa, ca, sb, cb;
+    senoCosseno<Rapida>(angulo_ombro, so, co);
+    senoCosseno<Rapida>(angulo_abs, sa, ca);
+    senoCosseno<Rapida>(angulo_base, sb, cb);
+
+    double r_cotovelo = m.comprimentoUmero * co;
+    double z_cotovelo = m.comprimentoUmero * so;
+    double r_total = r_cotovelo + m.comprimentoAntebraco * ca;
+
+    origens[0] = {0.0, 0.0, 0.0};
+    origens[1] = {0.0, 0.0, 0.0};
+    origens[2] = {r_cotovelo * cb, r_cotovelo * sb, z_cotovelo};
+    origens[3] = {r_total * cb, r_total * sb, z_cotovelo + m.comprimentoAntebraco * sa};
+}
+
+template void cadeiaCinematica<0, false>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<3, false>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<4, false>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<6, false>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<7, false>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<0, true>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<3, true>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<4, true>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<6, true>(const ModeloBraco&, const double*, Ponto*);
+template void cadeiaCinematica<7, true>(const ModeloBraco&, const double*, Ponto*);
+
+/// @brief Instância da cadeia para o número de juntas e o modo de seno e cosseno.
+template <bool Rapida>
+static void (*escolherCadeia(const ModeloBraco& m))(const ModeloBraco&, const double*, Ponto*) {
+    switch (m.classico3R ? -1 : m.nJuntas) {
+        case -1: return cadeiaClassica3R<Rapida>;
+        case 3: return cadeiaCinematica<3, Rapida>;
+        case 4: return cadeiaCinematica<4, Rapida>;
+        case 6: return cadeiaCinematica<6, Rapida>;
+        case 7: return cadeiaCinematica<7, Rapida>;
+        default: return cadeiaCinematica<0, Rapida>;
+    }
+}
+
+/// @brief Reconstrói o modelo global a partir de Config::tabelaDH e escolhe a instância
+/// de cadeiaCinematica (as comuns têm o número de juntas fixo; as demais usam a genérica).
+/// O braço clássico usa a forma fechada, como o kernel em lote. Com Config::_trig =
+/// "_trig_rapida" as instâncias usam sincosRapido.
+void montarBraco() {
+    ModeloBraco& m = braco;
+    m.nJuntas = (int)c.tabelaDH.size();
+    if (m.nJuntas > MAX_JUNTAS) {
+        cerr << "AVISO tabelaDH com mais de " << MAX_JUNTAS << " juntas; as excedentes foram ignoradas" << endl;
+        m.nJuntas = MAX_JUNTAS;
+    }
+
+    m.nSegmentos = 0;
+    for (int i = 0; i < m.nJuntas; i++) {
+        const LinhaDH& l = c.tabelaDH[i];
+        m.a[i] = l.a;
+        m.d[i] = l.d;
+        cossenoSeno(l.alfa, m.cosAlfa[i], m.sinAlfa[i]);
+        m.fechaTrecho[i] = m.cosAlfa[i] != 1.0 || m.sinAlfa[i] != 0.0;
+        m.offset[i] = l.offset * (M_PI / 180.0);
+        m.sinal[i] = l.sinal;
+        m.comprimento[i] = sqrt(l.a * l.a + l.d * l.d);
+        if (m.comprimento[i] > 0) m.segmentos[m.nSegmentos++] = i;
+    }
+    double soma = 0.0;
+    for (int i = m.nJuntas - 1; i >= 0; i--) {
+        soma += m.comprimento[i];
+        m.alcance[i] = soma;
+    }
+
+    const vector<LinhaDH>& t = c.tabelaDH;
+    m.classico3R = m.nJuntas == 3
+        && t[0].a == 0 && t[0].d == 0 && t[0].alfa == 90.0 && t[0].offset == 0 && t[0].sinal == 1.0
+        && t[1].d == 0 && t[1].alfa == 0 && t[1].offset == 0 && t[1].sinal == 1.0
+        && t[2].d == 0 && t[2].alfa == 0 && t[2].offset == 0 && t[2].sinal == -1.0;
+    m.comprimentoUmero = m.classico3R ? t[1].a : 0.0;
+    m.comprimentoAntebraco = m.classico3R ? t[2].a : 0.0;
+
+    m.cadeia = c._trig == "_trig_rapida" ? escolherCadeia<true>(m) : escolherCadeia<false>(m);
+}
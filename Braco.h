@@ -0,0 +1,63 @@
+#ifndef BRACO_H
+#define BRACO_H
+
+#include "Types.h"
+
+// Maior quantidade de juntas aceita na tabela DH (dimensiona os vetores de pilha)
+const int MAX_JUNTAS = 12;
+
+/// @brief Modelo cinemático do braço montado a partir de Config::tabelaDH.
+///
+/// A posição de cada junta vem da convenção de Denavit–Hartenberg padrão, mas juntas
+/// seguidas de eixos paralelos (alfa = 0) são somadas em um ângulo planar acumulado: o
+/// seno e o cosseno são calculados uma única vez por junta e a matriz do referencial só é
+/// multiplicada quando o eixo muda de direção. Para o braço de 3 juntas original isso dá
+/// exatamente as mesmas operações da fórmula fechada antiga (mesmos resultados, bit a bit).
+///
+/// O segmento físico da junta i liga a origem i à origem i+1 (a corda de a e d); juntas de
+/// comprimento zero não geram segmento.
+struct ModeloBraco {
+    int nJuntas;
+    double a[MAX_JUNTAS];
+    double d[MAX_JUNTAS];
+    double cosAlfa[MAX_JUNTAS];
+    double sinAlfa[MAX_JUNTAS];
+    bool fechaTrecho[MAX_JUNTAS];   // alfa != 0: o eixo da junta seguinte muda de direção
+    double offset[MAX_JUNTAS];      // radianos
+    double sinal[MAX_JUNTAS];
+    double comprimento[MAX_JUNTAS]; // distância entre a origem i e a i+1
+    double alcance[MAX_JUNTAS];     // soma dos comprimentos da junta i em diante (ver deslocamentoMaximo)
+
+    int nSegmentos;
+    int segmentos[MAX_JUNTAS];      // juntas com comprimento > 0
+
+    // Braço base + ombro + cotovelo no formato do kernel em lote (ver Lote.h)
+    bool classico3R;
+    double comprimentoUmero;
+    double comprimentoAntebraco;
+
+    // Instância de cadeiaCinematica escolhida para nJuntas e Config::_trig (ou a forma
+    // fechada do clássico)
+    void (*cadeia)(const ModeloBraco& m, const double* angulos, Ponto* origens);
+};
+
+/// Posições das origens 0..N (origem 0 = base). N > 0 fixa a quantidade de juntas em tempo
+/// de compilação (laços desenrolados); N = 0 lê m.nJuntas em tempo de execução. Rapida
+/// troca std::sin/std::cos por sincosRapido (Trig.h).
+/// Instanciada para 0, 3, 4, 6 e 7 em Braco.cpp.
+template <int N, bool Rapida = false>
+void cadeiaCinematica(const ModeloBraco& m, const double* angulos, Ponto* origens);
+
+// Modelo usado por Robot.cpp e Lote.cpp
+extern ModeloBraco braco;
+
+// Reconstrói o modelo global a partir de Config::tabelaDH (barato; chamado a cada execução)
+void montarBraco();
+
+// Origens das juntas (nJuntas + 1 pontos) na pose dada em graus
+inline void origensDasJuntas(const double* angulos, Ponto* origens) {
+    if (!braco.cadeia) montarBraco();
+    braco.cadeia(braco, angulos, origens);
+}
+
+#endif
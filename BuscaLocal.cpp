@@ -0,0 +1,113 @@
+#include "BuscaLocal.h"
+#include "Config.h"
+#include "Robot.h"
+#include "Braco.h"
+#include "Genoma.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+/// @brief Último gene que ainda influencia o fitness: depois da vitória a simulação para,
+/// então as velocidades seguintes não mudam nada e não vale a pena gastar avaliações nelas.
+static int fimGenesUteis(const Avaliacao& av) {
+    return av.venceu ? genesAtePasso(av.passoVitoria) : c.nGenes;
+}
+
+static double limitarVelocidade(double v) {
+    return v < -c.speed ? -c.speed : (v > c.speed ? c.speed : v);
+}
+
+// ---------------------------------------------------------------- Coordenadas
+
+/// @brief Descida por coordenadas com passo adaptativo por junta.
+///
+/// Cada avaliação testa uma única velocidade (gene, junta) sorteada, somando +passo e, se
+/// não melhorar, -passo. O passo de cada junta começa em speed/4, dobra a cada acerto (até
+/// speed) e cai pela metade quando os dois sentidos falham. O gene 0 não é usado pela
+/// simulação e fica de fora (com _gen_spline ele é o primeiro controle e entra).
+int BuscaCoordenadas::refinar(double* genoma, Ponto alvo, Avaliacao& av, Gerador& rng, int orcamento,
+                              vector<double>&) const {
+    double passos[MAX_JUNTAS];
+    for (int j = 0; j < c.nJuntas; j++) passos[j] = c.speed * 0.25;
+
+    int gastas = 0;
+    Avaliacao tentativa;
+    while (gastas < orcamento) {
+        int fim = fimGenesUteis(av), inicio = primeiroGeneUsado();
+        if (fim <= inicio) break;
+        int g = inicio + escolherIndiceDeLista(rng, fim - inicio);
+        int j = escolherIndiceDeLista(rng, c.nJuntas);
+        double& gene = genoma[g * c.nJuntas + j];
+        double original = gene;
+
+        bool melhorou = false;
+        for (int sentido = 0; sentido < 2 && gastas < orcamento && !melhorou; sentido++) {
+            double novo = limitarVelocidade(original + (sentido == 0 ? passos[j] : -passos[j]));
+            if (novo == original) continue;
+            gene = novo;
+            calcularFitness(genoma, alvo, tentativa);
+            gastas++;
+            if (tentativa.fitness > av.fitness) {
+                av = tentativa;
+                melhorou = true;
+            } else {
+                gene = original;
+            }
+        }
+
+        if (melhorou) passos[j] = min(passos[j] * 2.0, c.speed);
+        else passos[j] = max(passos[j] * 0.5, 1e-4);
+    }
+    return gastas;
+}
+
+// ---------------------------------------------------------------- (1+1)-ES
+
+/// @brief (1+1)-ES com a regra de 1/5 de Rechenberg.
+///
+/// O filho soma ruído N(0, sigma²) a todas as velocidades úteis do pai (ver fimGenesUteis) e
+/// só o substitui se tiver fitness maior. Sigma começa em speed/10 e é multiplicado por
+/// e^(1/3) a cada acerto e por e^(-1/12) a cada erro, o que o mantém estável quando cerca de
+/// 1 em cada 5 filhos é aceito.
+int BuscaES::refinar(double* genoma, Ponto alvo, Avaliacao& av, Gerador& rng, int orcamento,
+                     vector<double>& rascunho) const {
+    const double acerto = exp(1.0 / 3.0), erro = exp(-1.0 / 12.0);
+    int doubles = c.nGenes * c.nJuntas;
+    if ((int)rascunho.size() < 2 * doubles) rascunho.resize(2 * doubles);
+    double* filho = rascunho.data();
+    double* ruido = filho + doubles;
+
+    double sigma = c.speed * 0.1;
+    Avaliacao tentativa;
+    int gastas = 0;
+    while (gastas < orcamento) {
+        int fim = fimGenesUteis(av);
+        int inicio = primeiroGeneUsado() * c.nJuntas;
+        copy(genoma, genoma + doubles, filho);
+        if (fim * c.nJuntas > inicio) preencherNormais(rng, ruido, fim * c.nJuntas - inicio);
+        for (int k = inicio; k < fim * c.nJuntas; k++)
+            filho[k] = limitarVelocidade(filho[k] + sigma * ruido[k - inicio]);
+
+        calcularFitness(filho, alvo, tentativa);
+        gastas++;
+        if (tentativa.fitness > av.fitness) {
+            av = tentativa;
+            copy(filho, filho + doubles, genoma);
+            sigma = min(sigma * acerto, c.speed);
+        } else {
+            sigma = max(sigma * erro, 1e-4);
+        }
+    }
+    return gastas;
+}
+
+// ---------------------------------------------------------------- Fábrica
+
+BuscaLocal* criarBuscaLocal(const string& nome) {
+    if (nome == "_loc_coord") return new BuscaCoordenadas();
+    if (nome == "_loc_es") return new BuscaES();
+    if (nome != "_loc_off") cerr << "Busca local desconhecida '" << nome << "', desligada" << endl;
+    return nullptr;
+}
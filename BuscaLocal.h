@@ -0,0 +1,51 @@
+#ifndef BUSCA_LOCAL_H
+#define BUSCA_LOCAL_H
+
+#include "Types.h"
+#include "Utils.h"
+#include <string>
+#include <vector>
+
+/// @brief Interface dos otimizadores locais do estágio memético (escolhido por Config::_loc).
+///
+/// refinar() melhora um genoma no próprio lugar usando calcularFitness, com no máximo
+/// 'orcamento' avaliações. É chamada em paralelo, um indivíduo por tarefa, e não pode
+/// alterar o estado da estratégia: o estado da busca fica na pilha e no rascunho do
+/// trabalhador.
+class BuscaLocal {
+public:
+    virtual ~BuscaLocal() {}
+
+    /// @param genoma Genoma a refinar (sobrescrito só por candidatos melhores).
+    /// @param alvo Alvo da execução.
+    /// @param av Entra com a avaliação atual do genoma e sai com a do genoma refinado.
+    /// @param rng Gerador do trabalhador, já posicionado no fluxo do indivíduo.
+    /// @param orcamento Máximo de chamadas de calcularFitness.
+    /// @param rascunho Buffer do trabalhador (redimensionado se preciso).
+    /// @return Avaliações gastas.
+    virtual int refinar(double* genoma, Ponto alvo, Avaliacao& av, Gerador& rng, int orcamento,
+                        std::vector<double>& rascunho) const = 0;
+};
+
+/// Descida por coordenadas adaptativa: cada tentativa soma ±passo a uma velocidade sorteada
+/// (o que desloca todo o resto da trajetória). Acerto dobra o passo da junta, dois erros
+/// seguidos (nos dois sentidos) o cortam pela metade.
+class BuscaCoordenadas : public BuscaLocal {
+public:
+    int refinar(double* genoma, Ponto alvo, Avaliacao& av, Gerador& rng, int orcamento,
+                std::vector<double>& rascunho) const;
+};
+
+/// Estratégia evolutiva (1+1) com a regra de 1/5: perturba todas as velocidades até a
+/// vitória com ruído gaussiano de desvio sigma, que cresce nos acertos e encolhe nos erros.
+class BuscaES : public BuscaLocal {
+public:
+    int refinar(double* genoma, Ponto alvo, Avaliacao& av, Gerador& rng, int orcamento,
+                std::vector<double>& rascunho) const;
+};
+
+/// Cria o otimizador correspondente ao nome (_loc_coord, _loc_es); nullptr para _loc_off.
+/// Cada ContextoEvolutivo guarda o seu e só o recria quando o nome muda.
+BuscaLocal* criarBuscaLocal(const std::string& nome);
+
+#endif
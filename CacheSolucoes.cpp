@@ -0,0 +1,413 @@
+#include "CacheSolucoes.h"
+#include "Config.h"
+#include "Cena.h"
+#include "Arquivo.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+CacheSolucoes cacheSolucoes;
+
+static const size_t TAMANHO_CABECALHO = 128;
+static const uint32_t VERSAO_CACHE = 2; // 2: tamanho do genoma em cada entrada
+static const size_t CAPACIDADE_INICIAL = 64 * 1024;
+static const int DOUBLES_METADADOS = 7; // alvo (3), assinatura, fitness, segundos, doubles do genoma
+
+// Cabeçalho do arquivo, acessado diretamente na região mapeada
+struct CabecalhoCache {
+    char magica[4];
+    uint32_t versao;
+    uint32_t nEntradas;
+    uint32_t reservado;
+    uint64_t bytesUsados;  // entradas gravadas, depois do cabeçalho
+    uint64_t capacidade;   // bytes mapeados para entradas
+    uint64_t consultas;
+    uint64_t acertos;
+    uint64_t vitoriasComSemente;
+    uint64_t vitoriasSemSemente;
+    double segundosComSemente;
+    double segundosSemSemente;
+};
+
+// Cabeçalho da versão 1 (genoma de tamanho fixo para o arquivo inteiro), só para a conversão
+struct CabecalhoCacheV1 {
+    char magica[4];
+    uint32_t versao;
+    uint32_t nGenes;
+    uint32_t nJuntas;
+    uint32_t capacidade;
+    uint32_t nEntradas;
+    uint64_t consultas;
+    uint64_t acertos;
+    uint64_t vitoriasComSemente;
+    uint64_t vitoriasSemSemente;
+    double segundosComSemente;
+    double segundosSemSemente;
+};
+
+static CabecalhoCache* cabecalho(unsigned char* base) {
+    return reinterpret_cast<CabecalhoCache*>(base);
+}
+
+// FNV-1a de 64 bits
+static void misturar(uint64_t& h, const void* dados, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(dados);
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+}
+
+/// @brief Resume em 64 bits tudo o que muda o resultado de um genoma: obstáculos da cena
+/// (ver montarCena), teste contínuo, tabela DH do braço, pose inicial, limites das juntas,
+/// velocidade máxima e formato do genoma (inclusive a representação, Config::_gen). O
+/// tamanho do genoma de cada entrada é conferido à parte (ver buscarVizinhos).
+uint64_t assinaturaCenario() {
+    uint64_t h = 14695981039346656037ULL;
+    for (const Obstaculo& e : cena.esferas) {
+        double esfera[4] = {e.x, e.y, e.z, e.raio};
+        misturar(h, esfera, sizeof(esfera));
+    }
+    for (const Caixa& cx : cena.caixas) misturar(h, &cx, sizeof(cx));
+    misturar(h, &c.varreduraContinua, sizeof(c.varreduraContinua));
+    misturar(h, c.tabelaDH.data(), c.tabelaDH.size() * sizeof(LinhaDH));
+    misturar(h, c.poseInicial.data(), c.poseInicial.size() * sizeof(double));
+    misturar(h, c.baseLmin.data(), c.baseLmin.size() * sizeof(double));
+    misturar(h, c.baseLmax.data(), c.baseLmax.size() * sizeof(double));
+    misturar(h, &c.speed, sizeof(c.speed));
+    misturar(h, &c.nJuntas, sizeof(c.nJuntas));
+    misturar(h, &c.nWaypoints, sizeof(c.nWaypoints));
+    // Só o genoma por pontos de controle entra: as assinaturas de _gen_vel não mudam
+    if (c._gen == "_gen_spline") misturar(h, &c.nGenes, sizeof(c.nGenes));
+    return h;
+}
+
+static long long tamanhoDoArquivo(const string& caminho) {
+    ifstream arquivo(caminho.c_str(), ios::binary | ios::ate);
+    return arquivo ? (long long)arquivo.tellg() : -1;
+}
+
+CacheSolucoes::CacheSolucoes()
+    : base(nullptr), tamanhoMapeado(0), handleArquivo(nullptr), handleMapeamento(nullptr) {}
+
+CacheSolucoes::~CacheSolucoes() {
+    fechar();
+}
+
+void CacheSolucoes::fechar() {
+    if (!base) return;
+#ifdef _WIN32
+    FlushViewOfFile(base, 0);
+    UnmapViewOfFile(base);
+    CloseHandle((HANDLE)handleMapeamento);
+    CloseHandle((HANDLE)handleArquivo);
+#else
+    munmap(base, tamanhoMapeado);
+#endif
+    base = nullptr;
+    handleArquivo = nullptr;
+    handleMapeamento = nullptr;
+    tamanhoMapeado = 0;
+}
+
+/// @brief (Re)mapeia o arquivo com 'capacidade' bytes para entradas, aumentando-o se preciso.
+bool CacheSolucoes::mapear(size_t capacidade) {
+    fechar();
+    size_t tamanho = TAMANHO_CABECALHO + capacidade;
+
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                                 NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) return false;
+    // Um mapeamento maior que o arquivo o estende
+    HANDLE mapeamento = CreateFileMappingA(arquivo, NULL, PAGE_READWRITE,
+                                           (DWORD)((unsigned long long)tamanho >> 32), (DWORD)tamanho, NULL);
+    if (!mapeamento) { CloseHandle(arquivo); return false; }
+    void* p = MapViewOfFile(mapeamento, FILE_MAP_ALL_ACCESS, 0, 0, tamanho);
+    if (!p) { CloseHandle(mapeamento); CloseHandle(arquivo); return false; }
+    handleArquivo = arquivo;
+    handleMapeamento = mapeamento;
+#else
+    int fd = open(caminho.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || ((size_t)info.st_size < tamanho && ftruncate(fd, (off_t)tamanho) != 0)) {
+        close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+#endif
+
+    base = (unsigned char*)p;
+    tamanhoMapeado = tamanho;
+    return true;
+}
+
+/// @brief Converte um arquivo da versão 1 (lido inteiro em 'dados') para a atual, com o
+/// tamanho do genoma do cabeçalho antigo em cada entrada, e o grava por cima do original.
+static bool converterVersao1(const string& caminho, const vector<char>& dados) {
+    CabecalhoCacheV1 antigo;
+    memcpy(&antigo, dados.data(), sizeof(antigo));
+    uint64_t doubles = (uint64_t)antigo.nGenes * antigo.nJuntas;
+    size_t tamanhoAntigo = (size_t)(6 + doubles) * sizeof(double);
+    if (antigo.nEntradas > antigo.capacidade || dados.size() < TAMANHO_CABECALHO + antigo.nEntradas * tamanhoAntigo)
+        return false;
+
+    EscritorBinario entradas;
+    for (uint32_t i = 0; i < antigo.nEntradas; i++) {
+        const char* e = dados.data() + TAMANHO_CABECALHO + i * tamanhoAntigo;
+        entradas.bytes(e, 6 * sizeof(double));
+        entradas.valor(doubles);
+        entradas.bytes(e + 6 * sizeof(double), doubles * sizeof(double));
+    }
+
+    unsigned char bruto[TAMANHO_CABECALHO] = {};
+    CabecalhoCache* cab = cabecalho(bruto);
+    memcpy(cab->magica, "BRCS", 4);
+    cab->versao = VERSAO_CACHE;
+    cab->nEntradas = antigo.nEntradas;
+    cab->bytesUsados = cab->capacidade = entradas.dados.size();
+    cab->consultas = antigo.consultas;
+    cab->acertos = antigo.acertos;
+    cab->vitoriasComSemente = antigo.vitoriasComSemente;
+    cab->vitoriasSemSemente = antigo.vitoriasSemSemente;
+    cab->segundosComSemente = antigo.segundosComSemente;
+    cab->segundosSemSemente = antigo.segundosSemSemente;
+    return gravarArquivoAtomico(caminho, {{bruto, sizeof(bruto)}, {entradas.dados.data(), entradas.dados.size()}});
+}
+
+/// @brief Abre o arquivo de soluções e reconstrói o índice espacial.
+///
+/// Entradas de genomas de qualquer tamanho convivem no arquivo; cada execução só usa as do
+/// seu (ver buscarVizinhos). Um arquivo da versão 1 é convertido; um arquivo que não é um
+/// cache de soluções não é tocado, e o cache fica desativado.
+/// @param caminho Arquivo (criado se não existir).
+/// @return false se o arquivo não puder ser criado, convertido ou mapeado, ou se não for um
+/// cache de soluções (o cache fica desativado).
+bool CacheSolucoes::abrir(const string& caminho) {
+    fechar();
+    this->caminho = caminho;
+    voxels.clear();
+    deslocamentos.clear();
+
+    long long tamanho = tamanhoDoArquivo(caminho);
+    if (tamanho > 0) {
+        CabecalhoCache lido;
+        memset(&lido, 0, sizeof(lido));
+        ifstream arquivo(caminho.c_str(), ios::binary);
+        arquivo.read(reinterpret_cast<char*>(&lido), sizeof(lido));
+        if (!arquivo || tamanho < (long long)TAMANHO_CABECALHO || memcmp(lido.magica, "BRCS", 4) != 0 ||
+            (lido.versao != 1 && lido.versao != VERSAO_CACHE)) {
+            cerr << "AVISO " << caminho << " nao e um cache de solucoes desta versao; cache desativado" << endl;
+            return false;
+        }
+        if (lido.versao == 1) {
+            vector<char> dados((size_t)tamanho);
+            arquivo.seekg(0);
+            arquivo.read(dados.data(), tamanho);
+            arquivo.close();
+            if (!converterVersao1(caminho, dados)) {
+                cerr << "AVISO cache " << caminho << " da versao 1 nao convertido; cache desativado" << endl;
+                return false;
+            }
+            arquivo.open(caminho.c_str(), ios::binary);
+            arquivo.read(reinterpret_cast<char*>(&lido), sizeof(lido));
+            tamanho = tamanhoDoArquivo(caminho);
+        }
+        if (lido.bytesUsados > lido.capacidade || tamanho < (long long)(TAMANHO_CABECALHO + lido.capacidade)) {
+            cerr << "AVISO cache " << caminho << " truncado; cache desativado" << endl;
+            return false;
+        }
+        if (!mapear(lido.capacidade)) return false;
+    } else {
+        if (!mapear(CAPACIDADE_INICIAL)) return false;
+        memset(base, 0, TAMANHO_CABECALHO);
+        CabecalhoCache* cab = cabecalho(base);
+        memcpy(cab->magica, "BRCS", 4);
+        cab->versao = VERSAO_CACHE;
+        cab->capacidade = CAPACIDADE_INICIAL;
+    }
+
+    // Percorre as entradas; uma entrada inconsistente encerra a lista (o resto é sobrescrito)
+    CabecalhoCache* cab = cabecalho(base);
+    size_t deslocamento = 0;
+    for (uint32_t i = 0; i < cab->nEntradas; i++) {
+        if (deslocamento + DOUBLES_METADADOS * sizeof(double) > cab->bytesUsados) break;
+        uint64_t doubles = doublesDoGenoma(base + TAMANHO_CABECALHO + deslocamento);
+        size_t tamanhoEntrada = (DOUBLES_METADADOS + doubles) * sizeof(double);
+        if (doubles > cab->bytesUsados || deslocamento + tamanhoEntrada > cab->bytesUsados) break;
+        deslocamentos.push_back(deslocamento);
+        indexar((int)i);
+        deslocamento += tamanhoEntrada;
+    }
+    if (deslocamentos.size() != cab->nEntradas) {
+        cerr << "AVISO cache " << caminho << ": " << cab->nEntradas - deslocamentos.size()
+             << " entradas inconsistentes descartadas" << endl;
+        cab->nEntradas = (uint32_t)deslocamentos.size();
+        cab->bytesUsados = deslocamento;
+    }
+    return true;
+}
+
+unsigned char* CacheSolucoes::entrada(int i) const {
+    return base + TAMANHO_CABECALHO + deslocamentos[i];
+}
+
+// Doubles do genoma de uma entrada (u64 guardado na posição 6)
+uint64_t CacheSolucoes::doublesDoGenoma(const unsigned char* e) {
+    uint64_t doubles;
+    memcpy(&doubles, e + 6 * sizeof(double), sizeof(doubles));
+    return doubles;
+}
+
+const double* CacheSolucoes::genoma(int i) const {
+    return reinterpret_cast<const double*>(entrada(i)) + DOUBLES_METADADOS;
+}
+
+/// @brief Chave do voxel que contém o ponto (21 bits por eixo).
+uint64_t CacheSolucoes::chaveVoxel(const double* p) const {
+    uint64_t chave = 0;
+    for (int k = 0; k < 3; k++) {
+        int64_t celula = (int64_t)floor(p[k] / c.voxelCache) + (1 << 20);
+        chave = (chave << 21) | ((uint64_t)celula & 0x1FFFFF);
+    }
+    return chave;
+}
+
+void CacheSolucoes::indexar(int i) {
+    voxels[chaveVoxel(reinterpret_cast<const double*>(entrada(i)))].push_back(i);
+}
+
+/// @brief Procura soluções do cenário atual próximas do alvo.
+///
+/// Percorre o cubo de voxels que contém a esfera de raio 'raio' e filtra pela distância
+/// real, pela assinatura do cenário e pelo tamanho do genoma da configuração atual.
+///
+/// @param alvo Alvo da nova execução.
+/// @param raio Distância máxima entre o alvo e o alvo da solução guardada.
+/// @param maximo Quantidade máxima de índices devolvidos.
+/// @param indices Saída: índices das entradas, da mais próxima para a mais distante.
+/// @return Quantidade encontrada.
+int CacheSolucoes::buscarVizinhos(Ponto alvo, double raio, int maximo, vector<int>& indices) const {
+    indices.clear();
+    if (!base || maximo <= 0) return 0;
+
+    uint64_t cenario = assinaturaCenario();
+    int alcance = (int)ceil(raio / c.voxelCache);
+    vector<pair<double, int>> candidatos;
+
+    for (int dx = -alcance; dx <= alcance; dx++)
+    for (int dy = -alcance; dy <= alcance; dy++)
+    for (int dz = -alcance; dz <= alcance; dz++) {
+        double centro[3] = {alvo.x + dx * c.voxelCache, alvo.y + dy * c.voxelCache, alvo.z + dz * c.voxelCache};
+        auto it = voxels.find(chaveVoxel(centro));
+        if (it == voxels.end()) continue;
+        for (int i : it->second) {
+            const double* e = reinterpret_cast<const double*>(entrada(i));
+            uint64_t assinatura;
+            memcpy(&assinatura, e + 3, sizeof(assinatura));
+            // Genomas de outro tamanho (outro braço, nWaypoints ou nControles) não servem
+            if (assinatura != cenario || doublesDoGenoma(entrada(i)) != (uint64_t)c.nGenes * c.nJuntas) continue;
+            double d2 = (e[0]-alvo.x)*(e[0]-alvo.x) + (e[1]-alvo.y)*(e[1]-alvo.y) + (e[2]-alvo.z)*(e[2]-alvo.z);
+            if (d2 <= raio * raio) candidatos.push_back(make_pair(d2, i));
+        }
+    }
+
+    sort(candidatos.begin(), candidatos.end());
+    for (int k = 0; k < (int)candidatos.size() && k < maximo; k++) indices.push_back(candidatos[k].second);
+    return (int)indices.size();
+}
+
+/// @brief Guarda a solução de um alvo no cenário atual.
+///
+/// Se o mesmo alvo já tiver uma solução neste cenário e com este tamanho de genoma, ela só
+/// é substituída por uma de fitness maior (o menor tempo até a solução é mantido); senão a
+/// solução é acrescentada no fim.
+///
+/// @param alvo Alvo resolvido.
+/// @param genoma Genoma vencedor (nGenes * nJuntas doubles).
+/// @param fitness Fitness do genoma.
+/// @param segundos Tempo até a primeira vitória.
+void CacheSolucoes::registrar(Ponto alvo, const double* genoma, double fitness, double segundos) {
+    if (!base) return;
+    uint64_t cenario = assinaturaCenario();
+    uint64_t doubles = (uint64_t)c.nGenes * c.nJuntas;
+    size_t tamanhoEntrada = (DOUBLES_METADADOS + doubles) * sizeof(double);
+
+    vector<int> proximos;
+    buscarVizinhos(alvo, 1e-6, 1, proximos);
+    int i;
+    if (!proximos.empty()) {
+        i = proximos[0];
+        double* e = reinterpret_cast<double*>(entrada(i));
+        if (fitness <= e[4]) return;
+        segundos = min(segundos, e[5]);
+    } else {
+        CabecalhoCache* cab = cabecalho(base);
+        if (cab->bytesUsados + tamanhoEntrada > cab->capacidade) {
+            uint64_t novaCapacidade = max(cab->capacidade * 2, cab->bytesUsados + tamanhoEntrada);
+            if (!mapear(novaCapacidade)) return;
+            cabecalho(base)->capacidade = novaCapacidade;
+        }
+        i = (int)cabecalho(base)->nEntradas;
+        deslocamentos.push_back(cabecalho(base)->bytesUsados);
+    }
+
+    double* e = reinterpret_cast<double*>(entrada(i));
+    e[0] = alvo.x; e[1] = alvo.y; e[2] = alvo.z;
+    memcpy(e + 3, &cenario, sizeof(cenario));
+    e[4] = fitness;
+    e[5] = segundos;
+    memcpy(e + 6, &doubles, sizeof(doubles));
+    memcpy(e + DOUBLES_METADADOS, genoma, doubles * sizeof(double));
+
+    // A entrada só passa a contar depois de escrita por completo
+    CabecalhoCache* cab = cabecalho(base);
+    if (i == (int)cab->nEntradas) {
+        cab->bytesUsados += tamanhoEntrada;
+        cab->nEntradas++;
+        indexar(i);
+    }
+}
+
+void CacheSolucoes::registrarConsulta(bool acerto) {
+    if (!base) return;
+    cabecalho(base)->consultas++;
+    if (acerto) cabecalho(base)->acertos++;
+}
+
+void CacheSolucoes::registrarVitoria(bool comSemente, double segundos) {
+    if (!base) return;
+    CabecalhoCache* cab = cabecalho(base);
+    if (comSemente) { cab->vitoriasComSemente++; cab->segundosComSemente += segundos; }
+    else { cab->vitoriasSemSemente++; cab->segundosSemSemente += segundos; }
+}
+
+EstatisticasCache CacheSolucoes::estatisticas() const {
+    EstatisticasCache est = {0, 0, 0, 0, 0, 0.0, 0.0};
+    if (!base) return est;
+    const CabecalhoCache* cab = cabecalho(base);
+    est.entradas = (int)cab->nEntradas;
+    est.consultas = cab->consultas;
+    est.acertos = cab->acertos;
+    est.vitoriasComSemente = cab->vitoriasComSemente;
+    est.vitoriasSemSemente = cab->vitoriasSemSemente;
+    est.segundosComSemente = cab->segundosComSemente;
+    est.segundosSemSemente = cab->segundosSemSemente;
+    return est;
+}
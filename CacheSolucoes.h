@@ -0,0 +1,82 @@
+#ifndef CACHE_SOLUCOES_H
+#define CACHE_SOLUCOES_H
+
+#include "Types.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+// Medidas acumuladas no arquivo (sobrevivem entre execuções)
+struct EstatisticasCache {
+    int entradas;
+    unsigned long long consultas;          // execuções que procuraram sementes
+    unsigned long long acertos;            // execuções que receberam pelo menos uma semente
+    unsigned long long vitoriasComSemente;
+    unsigned long long vitoriasSemSemente;
+    double segundosComSemente;             // soma dos tempos até a primeira vitória
+    double segundosSemSemente;
+};
+
+/// @brief Armazém persistente de trajetórias vencedoras, indexado pela posição do alvo.
+///
+/// O arquivo é mapeado em memória; entradas novas são visíveis no disco assim que
+/// escritas, então nada se perde quando o Python mata o processo. Layout (little-endian):
+///
+///   cabeçalho (128 bytes): "BRCS", versão u32 (2), nEntradas u32, reservado u32,
+///                          bytes usados u64, capacidade em bytes u64, seguido dos
+///                          contadores de EstatisticasCache
+///   entrada i (em sequência): alvo x, y, z (f64), assinatura do cenário u64, fitness f64,
+///              segundos até a solução f64, tamanho do genoma em doubles u64, genoma (f64)
+///
+/// A assinatura do cenário resume tudo que muda o significado de um genoma (obstáculos,
+/// pose inicial, velocidade máxima, limites, representação): só entradas do mesmo cenário e
+/// com o tamanho de genoma da configuração atual são usadas. Entradas de outros braços e
+/// genomas continuam no arquivo e voltam a valer quando a configuração volta.
+/// O índice espacial (hash de voxels de lado Config::voxelCache) fica só em memória e é
+/// reconstruído ao abrir o arquivo.
+class CacheSolucoes {
+public:
+    CacheSolucoes();
+    ~CacheSolucoes();
+
+    /// Abre (ou cria) o arquivo; um da versão 1 é convertido. Nunca apaga o arquivo.
+    bool abrir(const std::string& caminho);
+    void fechar();
+    bool aberto() const { return base != nullptr; }
+
+    /// Índices das soluções do cenário atual a até 'raio' do alvo, da mais próxima para a mais distante.
+    int buscarVizinhos(Ponto alvo, double raio, int maximo, std::vector<int>& indices) const;
+    const double* genoma(int i) const;
+
+    /// Guarda (ou melhora) a solução de um alvo no cenário atual.
+    void registrar(Ponto alvo, const double* genoma, double fitness, double segundos);
+
+    void registrarConsulta(bool acerto);
+    void registrarVitoria(bool comSemente, double segundos);
+    EstatisticasCache estatisticas() const;
+
+private:
+    bool mapear(size_t capacidade);
+    unsigned char* entrada(int i) const;
+    static uint64_t doublesDoGenoma(const unsigned char* entrada);
+    uint64_t chaveVoxel(const double* p) const;
+    void indexar(int i);
+
+    std::string caminho;
+    unsigned char* base;
+    size_t tamanhoMapeado;
+    std::vector<size_t> deslocamentos; // início de cada entrada depois do cabeçalho
+    std::unordered_map<uint64_t, std::vector<int>> voxels;
+    void* handleArquivo;     // Windows: HANDLE do arquivo e do mapeamento (não usados em POSIX)
+    void* handleMapeamento;
+};
+
+// Assinatura do cenário atual (cena montada e parâmetros físicos do braço)
+uint64_t assinaturaCenario();
+
+// Cache usado pelo laço principal (fechado = desativado)
+extern CacheSolucoes cacheSolucoes;
+
+#endif
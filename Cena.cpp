@@ -0,0 +1,227 @@
+#include "Cena.h"
+#include "Config.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+Cena cena;
+
+// Obstáculos por folha da BVH
+static const int OBSTACULOS_POR_FOLHA = 2;
+
+void Cena::limpar() {
+    esferas.clear();
+    caixas.clear();
+    nos.clear();
+    ordem.clear();
+}
+
+void Cena::adicionarEsfera(const Obstaculo& esfera) {
+    esferas.push_back(esfera);
+}
+
+void Cena::adicionarCaixa(const Caixa& caixa) {
+    Caixa normalizada;
+    for (int k = 0; k < 3; k++) {
+        normalizada.min[k] = min(caixa.min[k], caixa.max[k]);
+        normalizada.max[k] = max(caixa.min[k], caixa.max[k]);
+    }
+    caixas.push_back(normalizada);
+}
+
+/// @brief Lê um arquivo de cena e acrescenta os obstáculos às listas.
+/// @param caminho Arquivo no formato descrito em Cena.h.
+/// @return false se o arquivo não puder ser aberto ou tiver linhas inválidas.
+bool Cena::carregar(const string& caminho) {
+    ifstream arquivo(caminho.c_str());
+    if (!arquivo) return false;
+
+    bool ok = true;
+    string linha;
+    int numero = 0;
+    while (getline(arquivo, linha)) {
+        numero++;
+        size_t comentario = linha.find('#');
+        if (comentario != string::npos) linha.erase(comentario);
+
+        istringstream entrada(linha);
+        string tipo;
+        if (!(entrada >> tipo)) continue;
+
+        if (tipo == "esfera") {
+            Obstaculo e;
+            if (entrada >> e.x >> e.y >> e.z >> e.raio) { adicionarEsfera(e); continue; }
+        } else if (tipo == "caixa") {
+            Caixa cx;
+            if (entrada >> cx.min[0] >> cx.min[1] >> cx.min[2] >> cx.max[0] >> cx.max[1] >> cx.max[2]) {
+                adicionarCaixa(cx);
+                continue;
+            }
+        }
+        cerr << "AVISO " << caminho << ":" << numero << " linha de cena invalida" << endl;
+        ok = false;
+    }
+    return ok;
+}
+
+Caixa Cena::limitesDe(int id) const {
+    if (id < (int)esferas.size()) {
+        const Obstaculo& e = esferas[id];
+        return {{e.x - e.raio, e.y - e.raio, e.z - e.raio}, {e.x + e.raio, e.y + e.raio, e.z + e.raio}};
+    }
+    return caixas[id - esferas.size()];
+}
+
+/// @brief Monta a BVH: divide pela mediana dos centros no eixo mais longo até restarem
+/// no máximo OBSTACULOS_POR_FOLHA obstáculos por folha.
+void Cena::construir() {
+    nos.clear();
+    ordem.resize(tamanho());
+    for (int i = 0; i < tamanho(); i++) ordem[i] = i;
+    if (!ordem.empty()) construirNo(0, tamanho());
+}
+
+int Cena::construirNo(int inicio, int fim) {
+    int indice = (int)nos.size();
+    nos.push_back(No());
+
+    Caixa limites = limitesDe(ordem[inicio]);
+    Caixa centros = {{0, 0, 0}, {0, 0, 0}};
+    for (int i = inicio; i < fim; i++) {
+        Caixa b = limitesDe(ordem[i]);
+        for (int k = 0; k < 3; k++) {
+            double centro = (b.min[k] + b.max[k]) / 2;
+            limites.min[k] = min(limites.min[k], b.min[k]);
+            limites.max[k] = max(limites.max[k], b.max[k]);
+            centros.min[k] = i == inicio ? centro : min(centros.min[k], centro);
+            centros.max[k] = i == inicio ? centro : max(centros.max[k], centro);
+        }
+    }
+    nos[indice].limites = limites;
+
+    if (fim - inicio <= OBSTACULOS_POR_FOLHA) {
+        nos[indice].inicio = inicio;
+        nos[indice].quantidade = fim - inicio;
+        nos[indice].filhoDireito = -1;
+        return indice;
+    }
+
+    int eixo = 0;
+    for (int k = 1; k < 3; k++)
+        if (centros.max[k] - centros.min[k] > centros.max[eixo] - centros.min[eixo]) eixo = k;
+
+    int meio = (inicio + fim) / 2;
+    nth_element(ordem.begin() + inicio, ordem.begin() + meio, ordem.begin() + fim, [&](int a, int b) {
+        Caixa ba = limitesDe(a), bb = limitesDe(b);
+        return ba.min[eixo] + ba.max[eixo] < bb.min[eixo] + bb.max[eixo];
+    });
+
+    nos[indice].inicio = inicio;
+    nos[indice].quantidade = 0;
+    construirNo(inicio, meio);
+    int direito = construirNo(meio, fim);
+    nos[indice].filhoDireito = direito;
+    return indice;
+}
+
+/// @brief Teste de slabs: o segmento [a, b] cruza a caixa inflada por 'margem'?
+static bool segmentoCruzaCaixa(Ponto a, Ponto b, const Caixa& caixa, double margem) {
+    double origem[3] = {a.x, a.y, a.z};
+    double direcao[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    double t0 = 0.0, t1 = 1.0;
+    for (int k = 0; k < 3; k++) {
+        double lo = caixa.min[k] - margem, hi = caixa.max[k] + margem;
+        if (direcao[k] == 0.0) {
+            if (origem[k] < lo || origem[k] > hi) return false;
+            continue;
+        }
+        double ta = (lo - origem[k]) / direcao[k];
+        double tb = (hi - origem[k]) / direcao[k];
+        if (ta > tb) swap(ta, tb);
+        t0 = max(t0, ta);
+        t1 = min(t1, tb);
+        if (t0 > t1) return false;
+    }
+    return true;
+}
+
+/// @brief Mesma álgebra de segmentoColideEsfera (Robot.cpp), com o raio aumentado pela margem.
+static bool segmentoCruzaEsfera(Ponto a, Ponto b, const Obstaculo& e, double margem) {
+    double abx = b.x - a.x, aby = b.y - a.y, abz = b.z - a.z;
+    double acx = e.x - a.x, acy = e.y - a.y, acz = e.z - a.z;
+    double dot = abx * acx + aby * acy + abz * acz;
+    double lenSq = abx * abx + aby * aby + abz * abz;
+    double t = lenSq != 0 ? dot / lenSq : -1.0;
+    t = max(0.0, min(1.0, t));
+
+    double dx = a.x + abx * t - e.x;
+    double dy = a.y + aby * t - e.y;
+    double dz = a.z + abz * t - e.z;
+    double raio = e.raio + margem;
+    return dx * dx + dy * dy + dz * dz < raio * raio;
+}
+
+bool Cena::obstaculoColide(int id, Ponto a, Ponto b, double margem) const {
+    if (id < (int)esferas.size()) return segmentoCruzaEsfera(a, b, esferas[id], margem);
+    return segmentoCruzaCaixa(a, b, caixas[id - esferas.size()], margem);
+}
+
+/// @brief Percorre a BVH com uma pilha fixa e testa só os obstáculos das folhas alcançadas.
+/// @param a Início do segmento.
+/// @param b Fim do segmento.
+/// @param margem Distância extra exigida entre o segmento e os obstáculos (0 = teste exato).
+bool Cena::segmentoColide(Ponto a, Ponto b, double margem) const {
+    if (nos.empty()) return false;
+
+    int pilha[64];
+    int topo = 0;
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        const No& no = nos[pilha[--topo]];
+        if (!segmentoCruzaCaixa(a, b, no.limites, margem)) continue;
+
+        if (no.quantidade > 0) {
+            for (int i = no.inicio; i < no.inicio + no.quantidade; i++)
+                if (obstaculoColide(ordem[i], a, b, margem)) return true;
+        } else {
+            pilha[topo++] = no.filhoDireito;
+            pilha[topo++] = (int)(&no - nos.data()) + 1;
+        }
+    }
+    return false;
+}
+
+// Obstáculos de Config::arquivoCena, lidos na última montarCena que precisou do arquivo
+static Cena doArquivo;
+static string caminhoLido;
+static bool arquivoEmDia = false;
+
+/// @brief Faz a próxima montarCena reler Config::arquivoCena mesmo que o caminho não mude
+/// (o arquivo pode ter sido editado).
+void recarregarArquivoCena() {
+    arquivoEmDia = false;
+}
+
+/// @brief Reconstrói a cena global: a bola de demolição (se tiver raio) mais os obstáculos
+/// de Config::arquivoCena. O arquivo só é relido quando o caminho muda ou depois de
+/// recarregarArquivoCena.
+void montarCena() {
+    if (!arquivoEmDia || c.arquivoCena != caminhoLido) {
+        doArquivo.limpar();
+        if (!c.arquivoCena.empty() && !doArquivo.carregar(c.arquivoCena))
+            cerr << "AVISO cena " << c.arquivoCena << " nao carregada por completo" << endl;
+        caminhoLido = c.arquivoCena;
+        arquivoEmDia = true;
+    }
+
+    cena.limpar();
+    if (c.bolaDeDemolicao.raio > 0) cena.adicionarEsfera(c.bolaDeDemolicao);
+    for (const Obstaculo& e : doArquivo.esferas) cena.adicionarEsfera(e);
+    for (const Caixa& cx : doArquivo.caixas) cena.adicionarCaixa(cx);
+    for (const Obstaculo& e : c.esferasCena) cena.adicionarEsfera(e);
+    for (const Caixa& cx : c.caixasCena) cena.adicionarCaixa(cx);
+    cena.construir();
+}
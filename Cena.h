@@ -0,0 +1,58 @@
+#ifndef CENA_H
+#define CENA_H
+
+#include "Types.h"
+#include <string>
+#include <vector>
+
+/// @brief Conjunto de obstáculos do ambiente (esferas e caixas) com uma BVH de caixas
+/// envolventes para a fase larga.
+///
+/// A consulta de um segmento só desce pelos nós cuja caixa (inflada pela margem) o
+/// segmento atravessa, então o custo cresce com log(obstáculos) quando os obstáculos
+/// estão espalhados, em vez de testar todos.
+///
+/// Arquivo de cena (texto, uma linha por obstáculo, '#' começa um comentário):
+///   esfera x y z raio
+///   caixa xmin ymin zmin xmax ymax zmax
+class Cena {
+public:
+    std::vector<Obstaculo> esferas;
+    std::vector<Caixa> caixas;
+
+    void limpar();
+    void adicionarEsfera(const Obstaculo& esfera);
+    void adicionarCaixa(const Caixa& caixa);
+    bool carregar(const std::string& caminho); // acrescenta os obstáculos do arquivo
+    void construir();                          // (re)monta a BVH; chamar depois de alterar as listas
+
+    int tamanho() const { return (int)(esferas.size() + caixas.size()); }
+
+    /// Se o segmento [a, b] passa a menos de 'margem' de algum obstáculo (caixas são infladas
+    /// pela margem em cada eixo, o que é conservador nos cantos).
+    bool segmentoColide(Ponto a, Ponto b, double margem) const;
+
+private:
+    struct No {
+        Caixa limites;
+        int inicio, quantidade; // folha: intervalo em 'ordem'; nó interno: quantidade = 0
+        int filhoDireito;       // o esquerdo é o nó seguinte no vetor
+    };
+
+    int construirNo(int inicio, int fim);
+    bool obstaculoColide(int id, Ponto a, Ponto b, double margem) const;
+    Caixa limitesDe(int id) const;
+
+    std::vector<No> nos;
+    std::vector<int> ordem; // ids: [0, esferas) esferas, depois caixas
+};
+
+// Cena usada pela avaliação (montada a partir de Config em montarCena)
+extern Cena cena;
+
+// Reconstrói 'cena' com Config::bolaDeDemolicao, os obstáculos de Config::arquivoCena e os
+// de Config::esferasCena/caixasCena
+void montarCena();
+void recarregarArquivoCena();
+
+#endif
@@ -0,0 +1,267 @@
+#include "Checkpoint.h"
+#include "Config.h"
+#include "CacheSolucoes.h"
+#include "Robot.h"
+#include "Arquivo.h"
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char MAGICA_CHECKPOINT[4] = {'B', 'R', 'C', 'K'};
+static const uint32_t VERSAO_CHECKPOINT = 3; // 2: gerador Philox; 3: contadores de replanejamento e prazo
+
+// Cabeçalho do arquivo de checkpoint
+struct CabecalhoCheckpoint {
+    char magica[4];
+    uint32_t versao;
+    uint64_t tamanhoDados;
+    uint64_t verificacao;
+    uint64_t assinatura;
+    double alvo[3];
+    int32_t nGenes;
+    int32_t nJuntas;
+    int32_t nWaypoints;
+    int32_t camposPorWaypoint;
+    int32_t capacidade;
+    int32_t reservado;
+};
+
+static uint64_t fnv1a(const unsigned char* p, size_t n) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// ---------------------------------------------------------------- Gravação
+
+// Campo a campo, para que o arquivo não dependa do alinhamento das structs
+static void escreverQuadro(EscritorBinario& e, const QuadroCheckpoint& q) {
+    e.valor((uint32_t)q.semente);
+    e.valor((int32_t)q.est.geracao);
+    e.valor((int32_t)q.est.estagAtual);
+    e.valor(q.est.incAtual);
+    e.valor(q.segundos);
+    e.valor((int32_t)q.geracaoAvanco);
+    e.valor((int32_t)q.geracaoPlato);
+    e.valor(q.fitnessPlato);
+    e.valor((int64_t)q.avaliacoes);
+    e.valor((int32_t)q.geracaoPrimeiraVitoria);
+    e.valor((int64_t)q.avaliacoesPrimeiraVitoria);
+    e.valor(q.segundosPrimeiraVitoria);
+    e.valor((int32_t)q.semeadosCache);
+    e.valor((int32_t)q.catastrofes);
+    e.valor((int32_t)q.replanejamentos);
+    e.valor((int32_t)q.prazosEstourados);
+}
+
+static void escreverPopulacao(EscritorBinario& e, const Populacao& pop) {
+    int cap = pop.capacidade;
+    e.valor((int32_t)pop.tamanho());
+    for (int i = 0; i < cap; i++) e.bytes(pop.genoma(i), pop.doublesPorGenoma() * sizeof(double));
+    e.vetor(pop.fitness, cap);
+    e.vetor(pop.passoVitoria, cap);
+    e.vetor(pop.venceu, cap);
+    e.vetor(pop.passoReavaliacao, cap);
+    e.vetor(pop.linhasPrefixo, cap);
+    for (int i = 0; i < cap; i++)
+        e.bytes(pop.prefixo(i), (size_t)pop.linhasPrefixo[i] * pop.camposPorWaypoint * sizeof(double));
+}
+
+bool gravarCheckpoint(const string& caminho, Ponto alvo, const QuadroCheckpoint& quadro,
+                      const Individuo& melhor, const Populacao& pop, const Populacao& proxima) {
+    if (pop.capacidade != proxima.capacidade || (int)melhor.genoma.size() != pop.doublesPorGenoma()) return false;
+
+    EscritorBinario e;
+    e.dados.reserve(2 * ((size_t)pop.capacidade * pop.doublesPorGenoma() * sizeof(double) + pop.prefixos.size() * sizeof(double)));
+    escreverQuadro(e, quadro);
+    e.valor(melhor.fitness);
+    e.valor((int32_t)melhor.passoVitoria);
+    e.valor((uint8_t)melhor.venceu);
+    e.vetor(melhor.genoma, melhor.genoma.size());
+    escreverPopulacao(e, pop);
+    escreverPopulacao(e, proxima);
+
+    CabecalhoCheckpoint cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA_CHECKPOINT, 4);
+    cab.versao = VERSAO_CHECKPOINT;
+    cab.tamanhoDados = e.dados.size();
+    cab.verificacao = fnv1a(e.dados.data(), e.dados.size());
+    cab.assinatura = assinaturaCenario();
+    cab.alvo[0] = alvo.x;
+    cab.alvo[1] = alvo.y;
+    cab.alvo[2] = alvo.z;
+    cab.nGenes = pop.nGenes;
+    cab.nJuntas = pop.nJuntas;
+    cab.nWaypoints = pop.nWaypoints;
+    cab.camposPorWaypoint = pop.camposPorWaypoint;
+    cab.capacidade = pop.capacidade;
+
+    // Um processo morto no meio da escrita deixa o checkpoint anterior intacto
+    return gravarArquivoAtomico(caminho, {{&cab, sizeof(cab)}, {e.dados.data(), e.dados.size()}});
+}
+
+// ---------------------------------------------------------------- Leitura
+
+// Percorre a região mapeada; qualquer leitura além do fim marca o arquivo como inválido
+struct Leitor {
+    const unsigned char* p;
+    const unsigned char* fim;
+    bool ok;
+
+    bool bytes(void* destino, size_t n) {
+        if (!ok || (size_t)(fim - p) < n) return ok = false;
+        memcpy(destino, p, n);
+        p += n;
+        return true;
+    }
+    template <typename T> bool valor(T& v) { return bytes(&v, sizeof(T)); }
+    template <typename T> bool vetor(vector<T>& v, size_t n) { return bytes(v.data(), n * sizeof(T)); }
+};
+
+static bool lerQuadro(Leitor& l, QuadroCheckpoint& q) {
+    uint32_t semente = 0;
+    int32_t geracao = 0, estagAtual = 0, geracaoAvanco = 0, geracaoPlato = 0, geracaoPrimeiraVitoria = 0,
+            semeadosCache = 0, catastrofes = 0, replanejamentos = 0, prazosEstourados = 0;
+    int64_t avaliacoes = 0, avaliacoesPrimeiraVitoria = 0;
+    l.valor(semente);
+    l.valor(geracao);
+    l.valor(estagAtual);
+    l.valor(q.est.incAtual);
+    l.valor(q.segundos);
+    l.valor(geracaoAvanco);
+    l.valor(geracaoPlato);
+    l.valor(q.fitnessPlato);
+    l.valor(avaliacoes);
+    l.valor(geracaoPrimeiraVitoria);
+    l.valor(avaliacoesPrimeiraVitoria);
+    l.valor(q.segundosPrimeiraVitoria);
+    l.valor(semeadosCache);
+    l.valor(catastrofes);
+    l.valor(replanejamentos);
+    l.valor(prazosEstourados);
+    q.semente = semente;
+    q.est.geracao = geracao;
+    q.est.estagAtual = estagAtual;
+    q.geracaoAvanco = geracaoAvanco;
+    q.geracaoPlato = geracaoPlato;
+    q.avaliacoes = avaliacoes;
+    q.geracaoPrimeiraVitoria = geracaoPrimeiraVitoria;
+    q.avaliacoesPrimeiraVitoria = avaliacoesPrimeiraVitoria;
+    q.semeadosCache = semeadosCache;
+    q.catastrofes = catastrofes;
+    q.replanejamentos = replanejamentos;
+    q.prazosEstourados = prazosEstourados;
+    return l.ok && geracao >= 0;
+}
+
+static bool lerPopulacao(Leitor& l, const CabecalhoCheckpoint& cab, Populacao& pop) {
+    int cap = cab.capacidade;
+    pop.redimensionar(cap, cab.nGenes, cab.nJuntas, cab.nWaypoints, cab.camposPorWaypoint);
+    int32_t tamanho = 0;
+    if (!l.valor(tamanho) || tamanho < 1 || tamanho > cap) return false;
+    for (int i = 0; i < cap; i++) l.bytes(pop.genoma(i), pop.doublesPorGenoma() * sizeof(double));
+    l.vetor(pop.fitness, cap);
+    l.vetor(pop.passoVitoria, cap);
+    l.vetor(pop.venceu, cap);
+    l.vetor(pop.passoReavaliacao, cap);
+    l.vetor(pop.linhasPrefixo, cap);
+    for (int i = 0; i < cap && l.ok; i++) {
+        if (pop.linhasPrefixo[i] < 0 || pop.linhasPrefixo[i] > cab.nWaypoints) return false;
+        l.bytes(pop.prefixo(i), (size_t)pop.linhasPrefixo[i] * pop.camposPorWaypoint * sizeof(double));
+    }
+    pop.ajustarTamanho(tamanho);
+    return l.ok;
+}
+
+/// @brief Confere o cabeçalho e a verificação dos dados e reconstrói o estado em cópias locais,
+/// que só substituem as do chamador no fim.
+static bool decodificar(const unsigned char* base, size_t tamanho, Ponto alvo, QuadroCheckpoint& quadro,
+                        Individuo& melhor, Populacao& pop, Populacao& proxima) {
+    CabecalhoCheckpoint cab;
+    if (tamanho < sizeof(cab)) return false;
+    memcpy(&cab, base, sizeof(cab));
+    if (memcmp(cab.magica, MAGICA_CHECKPOINT, 4) != 0 || cab.versao != VERSAO_CHECKPOINT) return false;
+    if (cab.tamanhoDados != tamanho - sizeof(cab)) return false;
+    if (cab.assinatura != assinaturaCenario() || cab.alvo[0] != alvo.x || cab.alvo[1] != alvo.y || cab.alvo[2] != alvo.z)
+        return false;
+    if (cab.nGenes != c.nGenes || cab.nJuntas != c.nJuntas || cab.nWaypoints != c.nWaypoints ||
+        cab.capacidade != c.nIndv || cab.camposPorWaypoint != camposPrefixo())
+        return false;
+    const unsigned char* dados = base + sizeof(cab);
+    if (fnv1a(dados, (size_t)cab.tamanhoDados) != cab.verificacao) return false;
+
+    Leitor l = {dados, dados + cab.tamanhoDados, true};
+    QuadroCheckpoint q;
+    Individuo m;
+    Populacao a, b;
+    int32_t passoVitoria = 0;
+    uint8_t venceu = 0;
+    if (!lerQuadro(l, q)) return false;
+    l.valor(m.fitness);
+    l.valor(passoVitoria);
+    l.valor(venceu);
+    m.passoVitoria = passoVitoria;
+    m.venceu = venceu != 0;
+    m.genoma.resize((size_t)cab.nGenes * cab.nJuntas);
+    l.vetor(m.genoma, m.genoma.size());
+    if (!l.ok || !lerPopulacao(l, cab, a) || !lerPopulacao(l, cab, b) || l.p != l.fim) return false;
+
+    quadro = q;
+    melhor.genoma.swap(m.genoma);
+    melhor.fitness = m.fitness;
+    melhor.passoVitoria = m.passoVitoria;
+    melhor.venceu = m.venceu;
+    melhor.trajetoria.clear();
+    swap(pop, a);
+    swap(proxima, b);
+    return true;
+}
+
+bool lerCheckpoint(const string& caminho, Ponto alvo, QuadroCheckpoint& quadro,
+                   Individuo& melhor, Populacao& pop, Populacao& proxima) {
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                 FILE_ATTRIBUTE_NORMAL, NULL);
+    if (arquivo == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER tamanhoArquivo;
+    if (!GetFileSizeEx(arquivo, &tamanhoArquivo) || tamanhoArquivo.QuadPart == 0) { CloseHandle(arquivo); return false; }
+    size_t tamanho = (size_t)tamanhoArquivo.QuadPart;
+    HANDLE mapeamento = CreateFileMappingA(arquivo, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapeamento) { CloseHandle(arquivo); return false; }
+    void* p = MapViewOfFile(mapeamento, FILE_MAP_READ, 0, 0, 0);
+    if (!p) { CloseHandle(mapeamento); CloseHandle(arquivo); return false; }
+    bool ok = decodificar((const unsigned char*)p, tamanho, alvo, quadro, melhor, pop, proxima);
+    UnmapViewOfFile(p);
+    CloseHandle(mapeamento);
+    CloseHandle(arquivo);
+#else
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    size_t tamanho = (size_t)info.st_size;
+    void* p = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED) return false;
+    bool ok = decodificar((const unsigned char*)p, tamanho, alvo, quadro, melhor, pop, proxima);
+    munmap(p, tamanho);
+#endif
+    return ok;
+}
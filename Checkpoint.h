@@ -0,0 +1,59 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "Types.h"
+#include "Populacao.h"
+#include <string>
+#include <cstdint>
+
+/// @brief Estado escalar do laço evolutivo guardado no checkpoint (o resto são as populações
+/// e o melhor global). Os campos de ControleParada e ResultadoExecucao vão separados para
+/// que este módulo não dependa do laço.
+struct QuadroCheckpoint {
+    unsigned int semente;  // sementeBase: com ela e a geração, todos os fluxos aleatórios se refazem
+    EstadoEvolutivo est;   // geração seguinte à última concluída, estagAtual e incAtual
+    double segundos;       // tempo de execução já decorrido
+
+    // ControleParada
+    int geracaoAvanco;
+    int geracaoPlato;
+    double fitnessPlato;
+
+    // ResultadoExecucao
+    long long avaliacoes;
+    int geracaoPrimeiraVitoria;
+    long long avaliacoesPrimeiraVitoria;
+    double segundosPrimeiraVitoria;
+    int semeadosCache;
+    int catastrofes;
+    int replanejamentos;
+    int prazosEstourados;
+
+    QuadroCheckpoint() : semente(0), segundos(0.0), geracaoAvanco(0), geracaoPlato(0), fitnessPlato(-1e18),
+                         avaliacoes(0), geracaoPrimeiraVitoria(-1), avaliacoesPrimeiraVitoria(-1),
+                         segundosPrimeiraVitoria(-1.0), semeadosCache(0), catastrofes(0), replanejamentos(0),
+                         prazosEstourados(0) {}
+};
+
+/// @brief Checkpoint binário do laço de população única (Config::arquivoCheckpoint).
+///
+/// Layout (little-endian): cabeçalho "BRCK", versão u32 (3), tamanho dos dados u64, verificação
+/// u64 (FNV-1a dos dados), assinatura do cenário u64, alvo 3 f64, nGenes, nJuntas,
+/// nWaypoints, camposPorWaypoint e capacidade i32; seguido do quadro, do melhor global
+/// (fitness, passoVitoria, venceu, genoma) e das duas populações. Cada população guarda a
+/// capacidade inteira (com o tamanho adaptativo as posições fora de uso ainda disputam a
+/// elite): nIndv, genomas, fitness, passoVitoria, venceu, passoReavaliacao, linhasPrefixo e
+/// só as linhas válidas do cache de prefixo, para que a retomada não reavalie ninguém.
+///
+/// A gravação monta tudo em memória e escreve em um arquivo temporário renomeado por cima do
+/// antigo; a leitura mapeia o arquivo e o recusa inteiro se qualquer verificação falhar.
+bool gravarCheckpoint(const std::string& caminho, Ponto alvo, const QuadroCheckpoint& quadro,
+                      const Individuo& melhor, const Populacao& pop, const Populacao& proxima);
+
+/// Lê um checkpoint do mesmo alvo, cenário e dimensões da configuração atual. As populações
+/// são redimensionadas para a capacidade gravada; a trajetória do melhor fica vazia.
+/// @return false (sem alterar nada) se o arquivo não existir, estiver corrompido ou não servir.
+bool lerCheckpoint(const std::string& caminho, Ponto alvo, QuadroCheckpoint& quadro,
+                   Individuo& melhor, Populacao& pop, Populacao& proxima);
+
+#endif
@@ -1,14 +1,182 @@
 #include "Config.h"
+#include "Genoma.h"
+#include "Cena.h"
+#include <algorithm>
+#include <cstdlib>
 
 // Criação da variável global de configurações
 Config c;
 
 Config::Config() {
-    nGenes = nWaypoints;
+    dimensionarGenoma();
+}
+
+/// @brief Uma velocidade por waypoint (_gen_vel) ou nControles pontos de controle por junta
+/// (_gen_spline, no máximo um por passo), com probabilidades uniformes por gene.
+void Config::dimensionarGenoma() {
+    nGenes = _gen == "_gen_spline" ? max(1, min(nControles, nWaypoints - 1)) : nWaypoints;
 
     // Inicializa probabilidades uniformes
     if (nGenes > 0) {
         listaPNumGene.assign(nGenes, 1.0/nGenes);
         listaPCadaGene.assign(nGenes, 1.0/nGenes);
     }
-}
\ No newline at end of file
+}
+
+/// @brief Troca o braço simulado por um dos modelos predefinidos.
+///
+/// As medidas usam a mesma unidade do braço original (alcance perto de 20); os modelos de
+/// 6 e 7 juntas seguem as tabelas DH de braços industriais comuns, em escala.
+///
+/// @param nome _braco_3r, _braco_4r, _braco_6r ou _braco_7r.
+/// @return false se o nome for desconhecido (a configuração não muda).
+bool selecionarBraco(const string& nome) {
+    if (nome == "_braco_3r") {
+        c.tabelaDH = {{0.0, 90.0, 0.0, 0.0, 1.0}, {10.0, 0.0, 0.0, 0.0, 1.0}, {10.0, 0.0, 0.0, 0.0, -1.0}};
+        c.baseLmin = {-180.0, 0.0, 0.0};
+        c.baseLmax = {180.0, 90.0, 180.0};
+        c.poseInicial = {0.0, 90.0, 0.0};
+    } else if (nome == "_braco_4r") {
+        // 3R com punho no mesmo plano do ombro e do cotovelo
+        c.tabelaDH = {{0.0, 90.0, 0.0, 0.0, 1.0}, {10.0, 0.0, 0.0, 0.0, 1.0},
+                      {7.0, 0.0, 0.0, 0.0, -1.0}, {3.0, 0.0, 0.0, 0.0, 1.0}};
+        c.baseLmin = {-180.0, 0.0, 0.0, -90.0};
+        c.baseLmax = {180.0, 90.0, 180.0, 90.0};
+        c.poseInicial = {0.0, 90.0, 0.0, 0.0};
+    } else if (nome == "_braco_6r") {
+        // Tipo UR5, escala 20x
+        c.tabelaDH = {{0.0, 90.0, 1.78, 0.0, 1.0}, {-8.5, 0.0, 0.0, 0.0, 1.0}, {-7.85, 0.0, 0.0, 0.0, 1.0},
+                      {0.0, 90.0, 2.18, 0.0, 1.0}, {0.0, -90.0, 1.89, 0.0, 1.0}, {0.0, 0.0, 1.65, 0.0, 1.0}};
+        c.baseLmin = {-180.0, -180.0, -160.0, -180.0, -180.0, -180.0};
+        c.baseLmax = {180.0, 0.0, 160.0, 180.0, 180.0, 180.0};
+        c.poseInicial = {0.0, -90.0, 0.0, -90.0, 0.0, 0.0};
+    } else if (nome == "_braco_7r") {
+        // Tipo KUKA iiwa, escala 15x
+        c.tabelaDH = {{0.0, -90.0, 5.4, 0.0, 1.0}, {0.0, 90.0, 0.0, 0.0, 1.0}, {0.0, 90.0, 6.3, 0.0, 1.0},
+                      {0.0, -90.0, 0.0, 0.0, 1.0}, {0.0, -90.0, 6.0, 0.0, 1.0}, {0.0, 90.0, 0.0, 0.0, 1.0},
+                      {0.0, 0.0, 1.89, 0.0, 1.0}};
+        c.baseLmin = {-170.0, -120.0, -170.0, -120.0, -170.0, -120.0, -175.0};
+        c.baseLmax = {170.0, 120.0, 170.0, 120.0, 170.0, 120.0, 175.0};
+        c.poseInicial = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    } else {
+        return false;
+    }
+    c._braco = nome;
+    c.nJuntas = (int)c.tabelaDH.size();
+    return true;
+}
+
+// Seletores de texto e os valores que cada um aceita (o resto das posições fica nulo)
+struct Seletor {
+    const char* chave;
+    string Config::* campo;
+    const char* valores[5];
+};
+
+static const Seletor SELETORES[] = {
+    {"_sel", &Config::_sel, {"_sel_rol", "_sel_tor", "_sel_sus"}},
+    {"_cat", &Config::_cat, {"_cat_dis"}},
+    {"_simd", &Config::_simd, {"_simd_auto", "_simd_avx2", "_simd_sse2", "_simd_esc", "_simd_off"}},
+    {"_aq", &Config::_aq, {"_aq_pop", "_aq_mel", "_aq_off"}},
+    {"_mig", &Config::_mig, {"_mig_anel", "_mig_total", "_mig_aleatoria"}},
+    {"_trig", &Config::_trig, {"_trig_exata", "_trig_rapida"}},
+    {"_pop", &Config::_pop, {"_pop_fixa", "_pop_adaptativa"}},
+    {"_ik", &Config::_ik, {"_ik_off", "_ik_on"}},
+    {"_loc", &Config::_loc, {"_loc_off", "_loc_coord", "_loc_es"}},
+    {"_mapa", &Config::_mapa, {"_mapa_off", "_mapa_on"}}
+};
+
+/// @brief Altera um campo da configuração a partir do seu nome, como recebido pelo modo servidor.
+///
+/// Só os campos que podem mudar entre dois alvos estão disponíveis. Mudar nWaypoints, _gen
+/// ou nControles também recalcula nGenes e as listas de probabilidade.
+///
+/// @param chave Nome do campo (igual ao da struct Config).
+/// @param valor Novo valor em texto.
+/// @return false se a chave não existir ou o valor for inválido.
+bool definirConfig(const string& chave, const string& valor) {
+    char* fim = nullptr;
+    double numero = strtod(valor.c_str(), &fim);
+    bool ehNumero = !valor.empty() && *fim == '\0';
+    int inteiro = (int)numero;
+
+    if (chave == "_braco") return selecionarBraco(valor);
+    if (chave == "_gen") {
+        if (valor != "_gen_vel" && valor != "_gen_spline") return false;
+        c._gen = valor;
+        c.dimensionarGenoma();
+        return true;
+    }
+    for (const Seletor& sel : SELETORES) {
+        if (chave != sel.chave) continue;
+        for (const char* opcao : sel.valores) {
+            if (opcao && valor == opcao) {
+                c.*sel.campo = valor;
+                return true;
+            }
+        }
+        return false;
+    }
+    if (chave == "arquivoCena") {
+        // Reenviar o mesmo caminho relê o arquivo (ele pode ter sido editado)
+        c.arquivoCena = valor;
+        recarregarArquivoCena();
+        return true;
+    }
+    if (chave == "arquivoCheckpoint" || chave == "arquivoMapa") {
+        (chave == "arquivoMapa" ? c.arquivoMapa : c.arquivoCheckpoint) = valor;
+        return true;
+    }
+    if (!ehNumero) return false;
+
+    if (chave == "nIndv" && inteiro > 0) c.nIndv = inteiro;
+    else if (chave == "nMortosCat" && inteiro >= 0) c.nMortosCat = inteiro;
+    else if (chave == "pCat") c.pCat = numero;
+    else if (chave == "nWaypoints" && inteiro > 1) {
+        c.nWaypoints = inteiro;
+        c.dimensionarGenoma();
+    }
+    else if (chave == "nControles" && inteiro > 0 && inteiro <= MAX_CONTROLES) {
+        c.nControles = inteiro;
+        c.dimensionarGenoma();
+    }
+    else if (chave == "nThreads" && inteiro >= 0) c.nThreads = inteiro;
+    else if (chave == "semente" && numero >= 0) c.semente = (unsigned int)numero;
+    else if (chave == "printGeracoes" && inteiro > 0) c.printGeracoes = inteiro;
+    else if (chave == "intervaloMetricas" && inteiro >= 0) c.intervaloMetricas = inteiro;
+    else if (chave == "speed" && numero > 0) c.speed = numero;
+    else if (chave == "pMutPos") c.pMutPos = numero;
+    else if (chave == "mutBase") c.mutBase = numero;
+    else if (chave == "incMutBase") c.incMutBase = numero;
+    else if (chave == "tetoMut") c.tetoMut = numero;
+    else if (chave == "minEstag") c.minEstag = inteiro;
+    else if (chave == "minEstagCat") c.minEstagCat = inteiro;
+    else if (chave == "tamTorneio" && inteiro > 0) c.tamTorneio = inteiro;
+    else if (chave == "fracaoIK" && numero >= 0 && numero <= 1) c.fracaoIK = numero;
+    else if (chave == "resolucaoMapa" && numero > 0) c.resolucaoMapa = numero;
+    else if (chave == "intervaloLocal" && inteiro >= 0) c.intervaloLocal = inteiro;
+    else if (chave == "nRefinados" && inteiro >= 0) c.nRefinados = inteiro;
+    else if (chave == "orcamentoLocal" && inteiro >= 0) c.orcamentoLocal = inteiro;
+    else if (chave == "nIndvMin" && inteiro > 1) c.nIndvMin = inteiro;
+    else if (chave == "estagReducao" && inteiro > 0) c.estagReducao = inteiro;
+    else if (chave == "geracoesAposVitoria" && inteiro >= 0) c.geracoesAposVitoria = inteiro;
+    else if (chave == "geracoesPlato" && inteiro >= 0) c.geracoesPlato = inteiro;
+    else if (chave == "toleranciaPlato" && numero >= 0) c.toleranciaPlato = numero;
+    else if (chave == "maxSegundosAlvo" && numero >= 0) c.maxSegundosAlvo = numero;
+    else if (chave == "maxAvaliacoes" && numero >= 0) c.maxAvaliacoes = (long long)numero;
+    else if (chave == "prazoGeracaoMs" && numero >= 0) c.prazoGeracaoMs = numero;
+    else if (chave == "nIlhas" && inteiro > 0) c.nIlhas = inteiro;
+    else if (chave == "intervaloMigracao" && inteiro > 0) c.intervaloMigracao = inteiro;
+    else if (chave == "nMigrantes" && inteiro >= 0) c.nMigrantes = inteiro;
+    else if (chave == "fixarNucleos") c.fixarNucleos = inteiro != 0;
+    else if (chave == "reavaliacaoIncremental") c.reavaliacaoIncremental = inteiro != 0;
+    else if (chave == "fracaoAquecimento" && numero >= 0 && numero <= 1) c.fracaoAquecimento = numero;
+    else if (chave == "raioCache" && numero >= 0) c.raioCache = numero;
+    else if (chave == "fracaoCache" && numero >= 0 && numero <= 1) c.fracaoCache = numero;
+    else if (chave == "varreduraContinua") c.varreduraContinua = inteiro != 0;
+    else if (chave == "toleranciaVarredura" && numero > 0) c.toleranciaVarredura = numero;
+    else if (chave == "intervaloCheckpoint" && inteiro > 0) c.intervaloCheckpoint = inteiro;
+    else if (chave == "retomarCheckpoint") c.retomarCheckpoint = inteiro != 0;
+    else return false;
+    return true;
+}
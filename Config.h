@@ -12,14 +12,49 @@ struct Config {
     double pCat = 0.01;        
     
     int nWaypoints = 100;      
-    int nJuntas = 3;
-    int nGenes; // Calculado no construtor
+    int nJuntas = 3; // sempre igual a tabelaDH.size() (ver selecionarBraco)
+    // Genoma (ver Genoma.h): _gen_vel (uma velocidade por junta em cada waypoint) ou _gen_spline
+    // (nControles pontos de controle por junta de uma B-spline cúbica das velocidades)
+    string _gen = "_gen_vel";
+    int nControles = 8;
+    int nGenes; // Calculado por dimensionarGenoma
+
+    // Paralelismo e reprodutibilidade
+    int nThreads = 0;          // 0 = usa todos os núcleos disponíveis
+    unsigned int semente = 0;  // 0 = semente aleatória; fixa = mesmo resultado para qualquer nThreads
 
     // Quantidades de gerações que serão mandados para o print (simulador)
     int printGeracoes = 3;
+    // A cada quantas gerações um retrato das métricas (ver Metricas.h) acompanha o STATS; 0 = nunca
+    int intervaloMetricas = 0;
 
     Obstaculo bolaDeDemolicao = {10.0, 5.0, 5.0, 5.0}; 
+
+    // Cena com vários obstáculos (esferas e caixas, ver Cena.h), somada à bola de demolição; vazio = só a bola
+    string arquivoCena = "";
+    // Obstáculos passados por programa (Biblioteca.h), somados aos de cima
+    vector<Obstaculo> esferasCena;
+    vector<Caixa> caixasCena;
+    // Teste contínuo entre waypoints (o braço não atravessa obstáculos finos em movimentos rápidos)
+    bool varreduraContinua = true;
+    double toleranciaVarredura = 0.05; // folga máxima do teste contínuo conservador
+
+    // Mapa de colisão no espaço das juntas (ver MapaColisao.h): _mapa_on responde por consulta
+    // as poses longe dos obstáculos (o resto cai no teste exato), _mapa_off sempre usa a geometria.
+    // Células de resolucaoMapa graus; arquivoMapa guarda o último mapa construído (vazio desativa)
+    string _mapa = "_mapa_off";
+    double resolucaoMapa = 2.0;
+    string arquivoMapa = "mapa_colisao.cache";
     vector<double> poseInicial = {0.0, 90.0, 0.0};
+
+    // Braço: _braco_3r (base + ombro + cotovelo), _braco_4r, _braco_6r (tipo UR) ou _braco_7r (tipo iiwa).
+    // A tabela abaixo é a do _braco_3r; selecionarBraco troca tabela, limites e pose inicial juntos.
+    string _braco = "_braco_3r";
+    vector<LinhaDH> tabelaDH = {
+        {0.0, 90.0, 0.0, 0.0, 1.0},   // base: gira em torno do eixo z
+        {10.0, 0.0, 0.0, 0.0, 1.0},   // ombro: úmero de 10
+        {10.0, 0.0, 0.0, 0.0, -1.0}   // cotovelo (dobra para baixo): antebraço de 10
+    };
     
     // Limites
     vector<double> baseLmin = {-180.0, 0.0, 0.0};
@@ -36,15 +71,95 @@ struct Config {
     // Catástrofe e Seleção
     string _cat = "_cat_dis"; 
     int minEstagCat = 6;
-    string _sel = "_sel_rol"; 
+    string _sel = "_sel_rol"; // _sel_rol (roleta), _sel_tor (torneio) ou _sel_sus (amostragem universal)
+    int tamTorneio = 3;
+
+    // Sementes de cinemática inversa (braço clássico): _ik_on põe na população inicial, no
+    // aquecimento e nos novos indivíduos da catástrofe trajetórias da pose inicial até cada
+    // solução analítica do alvo (fracaoIK deles, pelo menos uma por solução); _ik_off desliga
+    string _ik = "_ik_off";
+    double fracaoIK = 0.1;
+
+    // Estágio memético (ver BuscaLocal.h): a cada intervaloLocal gerações os nRefinados melhores
+    // passam por uma busca local com até orcamentoLocal avaliações cada. _loc_coord (descida por
+    // coordenadas adaptativa), _loc_es ((1+1)-ES com a regra de 1/5) ou _loc_off
+    string _loc = "_loc_off";
+    int intervaloLocal = 10;
+    int nRefinados = 4;
+    int orcamentoLocal = 60;
+
+    // Tamanho da população: _pop_fixa (sempre nIndv) ou _pop_adaptativa. Na adaptativa, enquanto
+    // o melhor sobe a população converge para ele e é cortada pela metade a cada avanço (até
+    // nIndvMin); com o melhor parado há estagReducao gerações, ou na catástrofe, volta a nIndv.
+    // Só no laço de população única.
+    string _pop = "_pop_fixa";
+    int nIndvMin = 25;
+    int estagReducao = 3;
+
+    // Critérios de parada dos modos visual e servidor (0 = desligado; ver LimitesExecucao)
+    int geracoesAposVitoria = 200; // alvo alcançado e melhor sem avanço há tantas gerações: SOLVED
+    int geracoesPlato = 3000;      // melhor subiu menos que toleranciaPlato nessas gerações: SOLVED ou GAVE_UP
+    double toleranciaPlato = 1.0;
+    double maxSegundosAlvo = 0;    // orçamento de tempo por alvo
+    long long maxAvaliacoes = 0;   // orçamento de avaliações por alvo
+    // Prazo de cada geração em milissegundos (0 = sem prazo): a população encolhe para a geração
+    // caber nele e volta a nIndv com folga, para o melhor sair a tempo em replanejamento ao vivo
+    double prazoGeracaoMs = 0;
+
+    // Modelo de ilhas (ver Ilhas.h): nIlhas > 1 divide nIndv em sub-populações que evoluem em
+    // paralelo e trocam os nMigrantes melhores a cada intervaloMigracao gerações.
+    // Topologia: _mig_anel (para a vizinha), _mig_total (para todas) ou _mig_aleatoria (para uma sorteada)
+    int nIlhas = 1;
+    int intervaloMigracao = 20;
+    int nMigrantes = 2;
+    string _mig = "_mig_anel";
+    bool fixarNucleos = true; // prende cada thread do pool (não a que chama) a um núcleo permitido
+
+    // Avaliação em lote: _simd_auto (melhor suportado), _simd_avx2, _simd_sse2, _simd_esc
+    // ou _simd_off (avaliação original, um indivíduo por vez com calcularFitness)
+    string _simd = "_simd_auto";
+
+    // Seno e cosseno da cinemática: _trig_exata (std::sin/std::cos e polinômio de 1 ulp no lote)
+    // ou _trig_rapida (polinômio mais curto, erro < ERRO_TRIG_RAPIDA; ver Trig.h)
+    string _trig = "_trig_exata";
+
+    // Reavaliação incremental: filhos só são simulados a partir do primeiro gene alterado
+    bool reavaliacaoIncremental = true;
+
+    // Aquecimento no modo servidor (novo alvo parte da população anterior):
+    // _aq_pop (melhores da população anterior), _aq_mel (variações da melhor trajetória) ou _aq_off
+    string _aq = "_aq_pop";
+    double fracaoAquecimento = 0.5; // fração da população herdada; o resto é aleatório
+
+    // Cache persistente de soluções (ver CacheSolucoes.h); vazio desativa
+    string arquivoCache = "solucoes.cache";
+    double raioCache = 5.0;     // distância máxima até um alvo já resolvido para usá-lo como semente
+    double voxelCache = 2.0;    // lado do voxel do índice espacial
+    double fracaoCache = 0.2;   // fração máxima da população semeada pelo cache
+
+    // Checkpoint do laço de população única (ver Checkpoint.h): a cada intervaloCheckpoint gerações
+    // o estado é gravado em arquivoCheckpoint (vazio desativa); com retomarCheckpoint a execução
+    // continua do arquivo, se ele for do mesmo alvo, cenário e dimensões
+    string arquivoCheckpoint = "";
+    int intervaloCheckpoint = 100;
+    bool retomarCheckpoint = false;
 
     // Probabilidades
     vector<double> listaPNumGene; 
     vector<double> listaPCadaGene;
 
     Config(); // Construtor
+
+    // Recalcula nGenes e as listas de probabilidade a partir de _gen, nWaypoints e nControles
+    void dimensionarGenoma();
 };
 
+// Troca o braço (tabelaDH, nJuntas, limites e pose inicial). Retorna false se o nome for desconhecido.
+bool selecionarBraco(const string& nome);
+
+// Altera um campo pelo nome (modo servidor). Retorna false se a chave ou o valor forem inválidos.
+bool definirConfig(const string& chave, const string& valor);
+
 // Declaração da variável global 'c' (definida no .cpp)
 extern Config c;
 
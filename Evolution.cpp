@@ -1,156 +1,538 @@
 #include "Evolution.h"
 #include "Config.h"
 #include "Utils.h"
+#include "Robot.h"
+#include "Paralelo.h"
+#include "Lote.h"
+#include "Selecao.h"
+#include "Braco.h"
+#include "Genoma.h"
+#include "Metricas.h"
 #include <algorithm>
-#include <numeric>
+#include <cmath>
 
 using namespace std;
 
-/// @brief Cria um novo indivíduo com genoma inicializado aleatoriamente.
+ContextoEvolutivo contextoPrincipal;
+
+/// @brief Estratégia de seleção do contexto, recriada só quando o nome muda.
+EstrategiaSelecao& ContextoEvolutivo::obterSelecao(const string& nome) {
+    if (!selecao || nome != nomeSelecao) {
+        selecao.reset(criarSelecao(nome));
+        nomeSelecao = nome;
+    }
+    return *selecao;
+}
+
+/// @brief Busca local do contexto, recriada só quando o nome muda (nullptr com _loc_off).
+const BuscaLocal* ContextoEvolutivo::obterBuscaLocal(const string& nome) {
+    if (nome != nomeBuscaLocal) {
+        buscaLocal.reset(criarBuscaLocal(nome));
+        nomeBuscaLocal = nome;
+    }
+    return buscaLocal.get();
+}
+
+/// @brief Garante um gerador e um vetor de índices por trabalhador. Deve ser chamada antes
+/// de entrar no pool, nunca de dentro de uma tarefa paralela.
+static void prepararTrabalhadores(ContextoEvolutivo& ctx) {
+    int n = ctx.executor().tamanho();
+    if ((int)ctx.geradores.size() < n) ctx.geradores.resize(n);
+    if ((int)ctx.indicesPorTrabalhador.size() < n) ctx.indicesPorTrabalhador.resize(n);
+    for (auto& indices : ctx.indicesPorTrabalhador) 
+        if ((int)indices.size() != c.nGenes) indices.resize(c.nGenes);
+    if ((int)ctx.marcasPorTrabalhador.size() < n) ctx.marcasPorTrabalhador.resize(n);
+    for (auto& marcas : ctx.marcasPorTrabalhador)
+        if ((int)marcas.size() != c.nGenes) marcas.assign(c.nGenes, 0);
+    if ((int)ctx.genomasPorTrabalhador.size() < n) ctx.genomasPorTrabalhador.resize(n);
+}
+
+/// @brief Preenche um genoma com velocidades aleatórias.
 /// 
-/// Constrói a matriz genética de dimensão [nGenes x nJuntas], onde cada gene
-/// representa uma velocidade angular. Os valores são sorteados uniformemente 
-/// dentro dos limites de velocidade definidos em Config.
+/// Preenche a matriz genética de dimensão [nGenes x nJuntas], onde cada gene
+/// representa uma velocidade angular (ou um ponto de controle delas, com _gen_spline).
+/// Os valores são sorteados uniformemente dentro dos limites de velocidade definidos em Config.
 /// 
-/// @return Um objeto do tipo 'Individuo' contendo a matriz de velocidades gerada.
-Individuo gerarIndividuo() {
-    vector<vector<double>> genoma;
-    for (int i = 0; i < c.nGenes; i++) {
-        vector<double> gene;
-        for(int j=0; j<c.nJuntas; j++){
-            gene.push_back(escolherNumReal(-c.speed, c.speed));
+/// @param genoma Destino (nGenes * nJuntas doubles).
+/// @param rng Gerador do trabalhador que está criando o indivíduo.
+void gerarIndividuo(double* genoma, Gerador& rng) {
+    // O genoma é contíguo: um único preenchimento em bloco
+    preencherUniformes(rng, genoma, c.nGenes * c.nJuntas, -c.speed, c.speed);
+}
+
+// Soluções da cinemática inversa do alvo atual (vazia com _ik_off ou alvo inalcançável)
+static vector<vector<double>> solucoesIK;
+
+/// @brief Calcula as soluções de cinemática inversa do alvo que serão usadas como sementes
+/// (Config::_ik = "_ik_on"). Chamada no começo de cada execução, fora do pool.
+void prepararSementesIK(Ponto alvo) {
+    solucoesIK.clear();
+    if (c._ik == "_ik_on") cinematicaInversa(alvo, solucoesIK);
+}
+
+int quantidadeSolucoesIK() {
+    return (int)solucoesIK.size();
+}
+
+/// @brief Soluções que semeiam as populações do contexto: as próprias, se ele tiver, ou as
+/// do alvo atual.
+static const vector<vector<double>>& solucoesDe(const ContextoEvolutivo& ctx) {
+    return ctx.solucoesIK ? *ctx.solucoesIK : solucoesIK;
+}
+
+/// @brief Quantas sementes de cinemática inversa entram entre 'vagas' indivíduos novos:
+/// fracaoIK delas, e pelo menos uma por solução (se couber).
+static int sementesIK(int vagas, const vector<vector<double>>& solucoes) {
+    if (solucoes.empty() || vagas <= 0) return 0;
+    int n = max((int)(c.fracaoIK * vagas), (int)solucoes.size());
+    return min(n, vagas);
+}
+
+/// @brief Genoma que leva o braço da pose inicial à solução k % solucoes.size().
+///
+/// Sem perturbação, as velocidades interpolam as juntas em linha reta (no espaço das
+/// juntas) na menor quantidade de passos que respeita Config::speed, e o braço chega à
+/// solução e fica parado. Com perturbação, a velocidade de cruzeiro é sorteada entre metade
+/// e o máximo e cada passo recebe ruído; como cada passo mira o que ainda falta dividido
+/// pelos passos restantes, o caminho se curva mas termina na mesma solução.
+///
+/// Com _gen_spline as velocidades por passo são montadas no rascunho e o genoma recebe os
+/// controles da curva mais próxima delas (ajustarControles): o braço chega perto da solução,
+/// sem a parada brusca.
+///
+/// @param genoma Destino (nGenes * nJuntas doubles).
+/// @param rng Gerador do trabalhador (só usado com perturbação).
+/// @param k Índice da semente (escolhe a solução).
+/// @param perturbada Sorteia velocidade e ruído.
+/// @param solucoes Soluções da cinemática inversa do alvo (não vazia).
+/// @param rascunho Buffer do trabalhador (só usado com _gen_spline).
+static void gerarSementeIK(double* genoma, Gerador& rng, int k, bool perturbada,
+                           const vector<vector<double>>& solucoes, vector<double>& rascunho) {
+    const vector<double>& solucao = solucoes[k % solucoes.size()];
+    double pose[MAX_JUNTAS];
+    double maiorDistancia = 0.0;
+    for (int j = 0; j < c.nJuntas; j++) {
+        pose[j] = c.poseInicial[j];
+        maiorDistancia = max(maiorDistancia, fabs(solucao[j] - pose[j]));
+    }
+
+    double cruzeiro = perturbada ? c.speed * escolherNumReal(rng, 0.5, 1.0) : c.speed;
+    double ruido = perturbada ? 0.5 * cruzeiro : 0.0;
+    int passos = max(1, min(c.nWaypoints - 1, (int)ceil(maiorDistancia / cruzeiro - 1e-9)));
+
+    double* velocidades = genoma;
+    if (modeloGenoma.spline) {
+        if (rascunho.size() < (size_t)c.nWaypoints * c.nJuntas) rascunho.resize((size_t)c.nWaypoints * c.nJuntas);
+        velocidades = rascunho.data();
+    }
+    for (int j = 0; j < c.nJuntas; j++) velocidades[j] = 0.0; // o gene 0 não é aplicado
+    for (int i = 1; i < c.nWaypoints; i++) {
+        int restantes = max(1, passos - i + 1);
+        for (int j = 0; j < c.nJuntas; j++) {
+            double v = (solucao[j] - pose[j]) / restantes;
+            if (restantes > 1 && ruido > 0) v += escolherNumReal(rng, -ruido, ruido);
+            v = max(-c.speed, min(c.speed, v));
+            velocidades[i * c.nJuntas + j] = v;
+            // Mesmo passo de move(): a pose fica nos limites das juntas
+            pose[j] = max(c.baseLmin[j], min(c.baseLmax[j], pose[j] + v));
         }
-        genoma.push_back(gene);
     }
-    return Individuo(genoma);
+    if (modeloGenoma.spline) ajustarControles(velocidades, genoma);
 }
 
-/// @brief Aplica a mutação adaptativa em um indivíduo.
+/// @brief Aplica a mutação adaptativa em um genoma (no próprio lugar).
 /// 
 /// 1. Define quantos e quais genes serão alterados.
 /// 2. Calcula a magnitude da mutação baseada na estagnação atual (incAtual), permitindo
 ///    saltos maiores se o algoritmo estiver preso (lógica adaptativa).
 /// 3. Aplica a alteração na velocidade de uma junta aleatória garantindo que a velocidade não exceda o limite físico.
 /// 
-/// @param ind O indivíduo original a ser mutado.
-/// @return Uma cópia do indivíduo com as modificações aplicadas. 
-Individuo realizarMutacao(Individuo ind) {
-    int qtdeMutados = escolherIndiceDeProbabilidades(c.listaPNumGene) + 1;
-    
-    vector<int> genesParaMutar;
-    vector<int> indicesDisponiveis(c.nGenes); 
-    iota(indicesDisponiveis.begin(), indicesDisponiveis.end(), 0);
-    shuffle(indicesDisponiveis.begin(), indicesDisponiveis.end(), rng);
-    
-    for(int i=0; i<qtdeMutados && i < (int)indicesDisponiveis.size(); i++) {
-        genesParaMutar.push_back(indicesDisponiveis[i]);
-    }
+/// @param genoma O genoma a ser mutado.
+/// @param rng Gerador do trabalhador que está aplicando a mutação.
+/// @param est Estado evolutivo atual (apenas leitura, compartilhado entre as threads).
+/// @param tabelaNumGenes Sorteio da quantidade de genes mutados (ver c.listaPNumGene).
+/// @param indices Vetor auxiliar de tamanho nGenes do trabalhador (conteúdo é sobrescrito).
+/// @param marcas Marcas de tamanho nGenes do trabalhador (zeradas na entrada e na saída).
+/// @return O menor índice de gene alterado (usado pela reavaliação incremental).
+int realizarMutacao(double* genoma, Gerador& rng, const EstadoEvolutivo& est, const TabelaAlias& tabelaNumGenes,
+                    vector<int>& indices, vector<unsigned char>& marcas) {
+    int qtdeMutados = min(tabelaNumGenes.sortear(rng) + 1, (int)indices.size());
+    int menorAlterado = c.nGenes;
 
-    for (int idx : genesParaMutar) {
-        double sinal = escolherZeroUm(c.pMutPos) ? 1.0 : -1.0;
+    // Só os genes mutados são sorteados (qtdeMutados sorteios, sem embaralhar os nGenes)
+    sortearSemRepeticao(rng, (int)indices.size(), qtdeMutados, indices.data(), marcas.data());
+
+    for (int i = 0; i < qtdeMutados; i++) {
+        int idx = indices[i];
+        menorAlterado = min(menorAlterado, idx);
+        double sinal = escolherZeroUm(rng, c.pMutPos) ? 1.0 : -1.0;
         double mutacao = 0;
 
-        mutacao = sinal * (c.mutBase + c.incMutBase * incAtual);
+        mutacao = sinal * (c.mutBase + c.incMutBase * est.incAtual);
 
-        int r = escolherIndiceDeLista(c.nJuntas);
-        ind.genoma[idx][r] += mutacao;
+        int r = escolherIndiceDeLista(rng, c.nJuntas);
+        double& gene = genoma[idx * c.nJuntas + r];
+        gene += mutacao;
 
-        if (ind.genoma[idx][r] < -c.speed) 
-            ind.genoma[idx][r] = -c.speed;
+        if (gene < -c.speed) 
+            gene = -c.speed;
         
-        if (ind.genoma[idx][r] > c.speed)
-            ind.genoma[idx][r] = c.speed;
+        if (gene > c.speed)
+            gene = c.speed;
     }
-    return ind;
+    return menorAlterado;
 }
 
-/// @brief Realiza o Crossover Aritmético entre dois indivíduos.
+/// @brief Realiza o Crossover Aritmético entre dois genomas.
 ///
-/// O novo indivíduo herda a média simples dos genes (velocidades) dos pais.
+/// O novo indivíduo herda a média simples dos genes (velocidades ou pontos de controle) dos pais.
 ///
 /// @param pai1 
 /// @param pai2 
-/// @return Novo indivíduo resultante do cruzamento.
-Individuo realizarCruzamento(const Individuo& pai1, const Individuo& pai2) {
-    vector<vector<double>> novoGenoma;
-    for(int i=0;i<c.nGenes;i++){
-        vector<double> passoFilho;
-        for(int j=0;j<c.nJuntas;j++){
-            double gene = (pai1.genoma[i][j] + pai2.genoma[i][j]) / 2.0;
-            passoFilho.push_back(gene);
-        }
-        novoGenoma.push_back(passoFilho);
+/// @param filho Destino do genoma resultante do cruzamento.
+/// @return O primeiro gene em que os pais diferem (nGenes se forem iguais). Antes dele o
+///         filho é idêntico aos dois pais, pois (a + a) / 2 == a.
+int realizarCruzamento(const double* pai1, const double* pai2, double* filho) {
+    int n = c.nGenes * c.nJuntas;
+    int primeiraDiferenca = n;
+    for (int k = 0; k < n; k++) {
+        filho[k] = (pai1[k] + pai2[k]) / 2.0;
+        if (primeiraDiferenca == n && pai1[k] != pai2[k]) primeiraDiferenca = k;
+    }
+    return primeiraDiferenca / c.nJuntas;
+}
+
+/// @brief Reaproveita a avaliação do pai para o trecho do filho que não mudou.
+///
+/// Os passos anteriores ao primeiro gene alterado produzem exatamente o mesmo estado no
+/// pai e no filho, então o filho copia essas linhas do cache de prefixo e só precisa
+/// ser simulado a partir dali. Se o pai venceu antes desse ponto, o filho repete a
+/// vitória e herda a avaliação inteira.
+///
+/// @param pais População de onde vem o pai (já avaliada).
+/// @param pai Índice do pai.
+/// @param filhos População do filho.
+/// @param filho Índice do filho.
+/// @param primeiroGeneAlterado Menor gene em que o filho difere do pai (nGenes se nenhum).
+static void herdarPrefixo(const Populacao& pais, int pai, Populacao& filhos, int filho, int primeiroGeneAlterado) {
+    int camposPorLinha = filhos.camposPorWaypoint;
+    if (!c.reavaliacaoIncremental || pais.passoReavaliacao[pai] != 0 || camposPorLinha == 0) {
+        filhos.passoReavaliacao[filho] = 1;
+        filhos.linhasPrefixo[filho] = 0;
+        return;
+    }
+
+    // O gene 0 não é usado na simulação: o passo i aplica o gene i (com _gen_spline, o
+    // primeiro passo em que o controle pesa)
+    int passo = max(primeiroPassoDoGene(primeiroGeneAlterado), 1);
+    bool mesmaAvaliacao = pais.venceu[pai] ? pais.passoVitoria[pai] < passo
+                                           : passo >= pais.nWaypoints;
+    int linhas = mesmaAvaliacao ? pais.linhasPrefixo[pai] : min(passo, pais.linhasPrefixo[pai]);
+
+    const double* origem = pais.prefixo(pai);
+    copy(origem, origem + (size_t)linhas * camposPorLinha, filhos.prefixo(filho));
+    filhos.linhasPrefixo[filho] = linhas;
+
+    if (mesmaAvaliacao) {
+        filhos.fitness[filho] = pais.fitness[pai];
+        filhos.venceu[filho] = pais.venceu[pai];
+        filhos.passoVitoria[filho] = pais.passoVitoria[pai];
+        filhos.passoReavaliacao[filho] = 0;
+    } else {
+        filhos.passoReavaliacao[filho] = max(linhas, 1);
+    }
+}
+
+/// @brief Cria a população inicial com genomas aleatórios.
+///
+/// Cada indivíduo usa o fluxo (geração 0, índice i), então a população gerada é a mesma
+/// independentemente de quantas threads participaram. Com sementes de cinemática inversa
+/// (ver prepararSementesIK), os primeiros indivíduos são trajetórias até as soluções: uma
+/// exata por solução e as demais perturbadas.
+///
+/// @param pop População já dimensionada (genomas são sobrescritos, ainda não avaliados).
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+void gerarPopulacaoInicial(Populacao& pop, ContextoEvolutivo& ctx) {
+    pop.marcarTodosParaReavaliar();
+    prepararTrabalhadores(ctx);
+    const vector<vector<double>>& solucoes = solucoesDe(ctx);
+    int nSementes = sementesIK(pop.tamanho(), solucoes);
+    ctx.executor().paraCada(pop.tamanho(), [&](int i, int id) {
+        Gerador& rng = ctx.geradores[id];
+        reposicionarGerador(rng, 0, ctx.primeiroIndice + i, FLUXO_INICIAL);
+        if (i < nSementes)
+            gerarSementeIK(pop.genoma(i), rng, i, i >= (int)solucoes.size(), solucoes, ctx.genomasPorTrabalhador[id]);
+        else gerarIndividuo(pop.genoma(i), rng);
+    });
+}
+
+/// @brief Calcula o fitness de toda a população em paralelo.
+///
+/// Cada indivíduo é avaliado de forma independente (calcularFitness só escreve na
+/// posição do próprio indivíduo), então a divisão entre threads não altera o resultado.
+/// Com o braço clássico de 3 juntas (ModeloBraco::classico3R) e _simd diferente de "_simd_off", cada tarefa avalia um lote
+/// de indivíduos em passo travado (ver Lote.h).
+///
+/// Nos dois caminhos só são simulados os indivíduos com passoReavaliacao != 0, e cada
+/// um a partir desse passo (reavaliação incremental). No lote os pendentes são ordenados
+/// pelo passo inicial para que as lanes de um mesmo lote comecem perto umas das outras.
+///
+/// @param pop População a ser avaliada (fitness e metadados são atualizados).
+/// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+/// @return Quantidade de indivíduos simulados (total ou parcialmente).
+int avaliarPopulacao(Populacao& pop, Ponto alvo, ContextoEvolutivo& ctx) {
+    if (c._simd == "_simd_off" || !braco.classico3R || pop.camposPorWaypoint != CAMPOS_PREFIXO) {
+        bool comPrefixo = pop.camposPorWaypoint == camposPrefixo();
+        int nPendentes = 0;
+        for (int i = 0; i < pop.tamanho(); i++) nPendentes += pop.passoReavaliacao[i] != 0;
+        ctx.executor().paraCada(pop.tamanho(), [&](int i, int) {
+            if (pop.passoReavaliacao[i] == 0) return;
+            unsigned long long inicio = instanteMetrica();
+            Avaliacao av;
+            calcularFitness(pop.genoma(i), alvo, av, nullptr, comPrefixo ? pop.prefixo(i) : nullptr,
+                            pop.passoReavaliacao[i]);
+            registrarAvaliacao(inicio);
+            pop.fitness[i] = av.fitness;
+            pop.passoVitoria[i] = av.passoVitoria;
+            pop.venceu[i] = av.venceu ? 1 : 0;
+            pop.passoReavaliacao[i] = 0;
+            pop.linhasPrefixo[i] = !comPrefixo ? 0 : av.venceu ? av.passoVitoria : pop.nWaypoints;
+        });
+        return nPendentes;
+    }
+
+    ctx.pendentes.clear();
+    for (int i = 0; i < pop.tamanho(); i++) {
+        if (pop.passoReavaliacao[i] != 0) ctx.pendentes.push_back(make_pair(pop.passoReavaliacao[i], i));
     }
-    return Individuo(novoGenoma);
+    sort(ctx.pendentes.begin(), ctx.pendentes.end());
+
+    NivelSimd nivel = escolherSimd();
+    int largura = larguraLote(nivel);
+    ParametrosLote prm = montarParametrosLote(alvo);
+    int nPendentes = (int)ctx.pendentes.size();
+    int nLotes = (nPendentes + largura - 1) / largura;
+
+    ctx.executor().paraCada(nLotes, [&](int lote, int) {
+        unsigned long long instante = instanteMetrica();
+        int inicio = lote * largura;
+        int n = min(largura, nPendentes - inicio);
+        LaneLote lanes[LARGURA_MAXIMA_LOTE];
+        Avaliacao av[LARGURA_MAXIMA_LOTE];
+        for (int l = 0; l < n; l++) {
+            int i = ctx.pendentes[inicio + l].second;
+            lanes[l].genoma = pop.genoma(i);
+            lanes[l].prefixo = pop.prefixo(i);
+            lanes[l].inicio = pop.passoReavaliacao[i];
+        }
+
+        avaliarLote(nivel, prm, lanes, n, av);
+        registrarAvaliacao(instante);
+        for (int l = 0; l < n; l++) {
+            int i = ctx.pendentes[inicio + l].second;
+            pop.fitness[i] = av[l].fitness;
+            pop.passoVitoria[i] = av[l].passoVitoria;
+            pop.venceu[i] = av[l].venceu ? 1 : 0;
+            pop.passoReavaliacao[i] = 0;
+            pop.linhasPrefixo[i] = av[l].venceu ? av[l].passoVitoria : pop.nWaypoints;
+        }
+    });
+    return nPendentes;
+}
+
+/// @brief Estágio memético: refina os Config::nRefinados melhores com a busca local de
+/// Config::_loc, a cada Config::intervaloLocal gerações.
+///
+/// Deve ser chamada logo depois de avaliarPopulacao (todas as avaliações em dia). Cada
+/// refinado é uma tarefa, com o gerador posicionado por (geração, indivíduo), então o
+/// resultado não depende do número de threads. Quem melhorar perde o cache de prefixo,
+/// porque o genoma mudou em posições arbitrárias.
+///
+/// @param pop População avaliada (genomas e fitness dos refinados são atualizados).
+/// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+/// @param est Estado evolutivo atual (a geração decide se há refinamento).
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+/// @return Quantidade de chamadas de calcularFitness gastas.
+int refinarMelhores(Populacao& pop, Ponto alvo, const EstadoEvolutivo& est, ContextoEvolutivo& ctx) {
+    if (c.intervaloLocal <= 0 || c.orcamentoLocal <= 0 || est.geracao % c.intervaloLocal != 0) return 0;
+    const BuscaLocal* busca = ctx.obterBuscaLocal(c._loc);
+    int k = min(c.nRefinados, pop.tamanho());
+    if (!busca || k <= 0) return 0;
+    MedidorFase medidor(FASE_BUSCA_LOCAL);
+
+    ctx.ordemFitness.resize(pop.tamanho());
+    for (int i = 0; i < pop.tamanho(); i++) ctx.ordemFitness[i] = make_pair(pop.fitness[i], i);
+    partial_sort(ctx.ordemFitness.begin(), ctx.ordemFitness.begin() + k, ctx.ordemFitness.end(),
+                 greater<pair<double, int>>());
+
+    prepararTrabalhadores(ctx);
+    ctx.avaliacoesLocais.assign(k, 0);
+    ctx.executor().paraCada(k, [&](int r, int id) {
+        int i = ctx.ordemFitness[r].second;
+        Gerador& rng = ctx.geradores[id];
+        reposicionarGerador(rng, est.geracao, ctx.primeiroIndice + i, FLUXO_BUSCA_LOCAL);
+
+        Avaliacao av;
+        av.fitness = pop.fitness[i];
+        av.passoVitoria = pop.passoVitoria[i];
+        av.venceu = pop.venceu[i] != 0;
+        ctx.avaliacoesLocais[r] = busca->refinar(pop.genoma(i), alvo, av, rng, c.orcamentoLocal,
+                                                 ctx.genomasPorTrabalhador[id]);
+        if (av.fitness > pop.fitness[i]) {
+            pop.fitness[i] = av.fitness;
+            pop.passoVitoria[i] = av.passoVitoria;
+            pop.venceu[i] = av.venceu ? 1 : 0;
+            pop.passoReavaliacao[i] = 0;
+            pop.linhasPrefixo[i] = 0;
+        }
+    });
+
+    int total = 0;
+    for (int gastas : ctx.avaliacoesLocais) total += gastas;
+    return total;
 }
 
 /// @brief Aplica uma catástrofe na população atual.
 ///
 /// 1.Ordena a população inteira por fitness (do melhor para o pior).
 /// 2.Preserva uma pequena elite (os sobreviventes) para garantir que a melhor solução não se perca.
-/// 3.Substitui todo o restante da população por novos indivíduos totalmente aleatórios.
+/// 3.Substitui todo o restante da população por novos indivíduos totalmente aleatórios
+///   (com sementes de cinemática inversa, parte deles são trajetórias perturbadas até as soluções).
 ///
 /// @param pop A população atual que se encontra em estagnação.
-/// @return Nova população composta pela elite sobrevivente e novos indivíduos aleatórios.
-vector<Individuo> realizarCatastrofe(vector<Individuo>& pop) {
-    vector<Individuo> popNova;
-    
+/// @param popNova Buffer da próxima geração (mesmas dimensões de 'pop'), sobrescrito.
+/// @param est Estado evolutivo atual (a geração define os fluxos aleatórios dos novos indivíduos).
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+void realizarCatastrofe(const Populacao& pop, Populacao& popNova, const EstadoEvolutivo& est, ContextoEvolutivo& ctx) {
+    MedidorFase medidor(FASE_CATASTROFE);
+
     // Ordena por fitness
-    vector<pair<double, int>> aux;
-    for(size_t i=0; i<pop.size(); i++) aux.push_back({pop[i].fitness, (int)i});
-    sort(aux.rbegin(), aux.rend()); 
+    ctx.ordemFitness.resize(pop.tamanho());
+    for(int i=0; i<pop.tamanho(); i++) ctx.ordemFitness[i] = make_pair(pop.fitness[i], i);
+    sort(ctx.ordemFitness.rbegin(), ctx.ordemFitness.rend()); 
 
-    int inicioZonaMorte = c.nMortosCat; 
+    int inicioZonaMorte = min(c.nMortosCat, pop.tamanho()); 
 
     // Mantém a elite
     for (int i = 0; i < inicioZonaMorte; i++) 
-        popNova.push_back(pop[aux[i].second]);
+        popNova.copiarDe(pop, ctx.ordemFitness[i].second, i);
 
     // Preenche o resto com novos indivíduos aleatórios
-    while (popNova.size() < pop.size()) {
-        popNova.push_back(gerarIndividuo());
-    }
-    return popNova;
+    prepararTrabalhadores(ctx);
+    const vector<vector<double>>& solucoes = solucoesDe(ctx);
+    int nSementes = sementesIK(pop.tamanho() - inicioZonaMorte, solucoes);
+    ctx.executor().paraCada(pop.tamanho() - inicioZonaMorte, [&](int k, int id) {
+        int i = inicioZonaMorte + k;
+        Gerador& rng = ctx.geradores[id];
+        reposicionarGerador(rng, est.geracao, ctx.primeiroIndice + i, FLUXO_CATASTROFE);
+        if (k < nSementes) gerarSementeIK(popNova.genoma(i), rng, k, true, solucoes, ctx.genomasPorTrabalhador[id]);
+        else gerarIndividuo(popNova.genoma(i), rng);
+        popNova.passoReavaliacao[i] = 1;
+        popNova.linhasPrefixo[i] = 0;
+    });
+}
+
+/// @brief Monta a população inicial de um novo alvo a partir da população anterior.
+///
+/// Todos os genomas partem da mesma pose inicial, então trajetórias boas para o alvo
+/// anterior costumam ser um bom ponto de partida para um alvo próximo. A população
+/// anterior já deve ter sido avaliada contra o NOVO alvo; a herança depende de Config::_aq:
+///   _aq_pop: os melhores (fracaoAquecimento da população) são mantidos;
+///   _aq_mel: o melhor é mantido e o restante da fração recebe cópias mutadas dele.
+/// As demais posições recebem indivíduos aleatórios, para manter a diversidade (e, com
+/// sementes de cinemática inversa, trajetórias até as soluções do novo alvo).
+///
+/// @param pop População anterior, avaliada contra o novo alvo.
+/// @param popNova Buffer de mesmas dimensões, sobrescrito.
+/// @param rodada Contador de aquecimentos (separa os fluxos aleatórios de alvos seguidos).
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+void aquecerPopulacao(const Populacao& pop, Populacao& popNova, int rodada, ContextoEvolutivo& ctx) {
+    MedidorFase medidor(FASE_AQUECIMENTO);
+
+    ctx.ordemFitness.resize(pop.tamanho());
+    for(int i=0; i<pop.tamanho(); i++) ctx.ordemFitness[i] = make_pair(pop.fitness[i], i);
+    sort(ctx.ordemFitness.rbegin(), ctx.ordemFitness.rend());
+
+    int nHerdados = min(pop.tamanho(), max(1, (int)(c.fracaoAquecimento * pop.tamanho())));
+    bool copiasDoMelhor = c._aq == "_aq_mel";
+    for (int i = 0; i < nHerdados; i++)
+        popNova.copiarDe(pop, ctx.ordemFitness[copiasDoMelhor ? 0 : i].second, i);
+
+    EstadoEvolutivo est;
+    ctx.tabelaNumGenes.construir(c.listaPNumGene);
+    prepararTrabalhadores(ctx);
+    const vector<vector<double>>& solucoes = solucoesDe(ctx);
+    int nSementes = sementesIK(pop.tamanho() - nHerdados, solucoes);
+    ctx.executor().paraCada(pop.tamanho() - 1, [&](int k, int id) {
+        int i = k + 1;
+        Gerador& rng = ctx.geradores[id];
+        reposicionarGerador(rng, rodada, ctx.primeiroIndice + i, FLUXO_AQUECIMENTO);
+        if (i >= nHerdados && i - nHerdados < nSementes) {
+            gerarSementeIK(popNova.genoma(i), rng, i - nHerdados, i - nHerdados >= (int)solucoes.size(), solucoes,
+                           ctx.genomasPorTrabalhador[id]);
+        } else if (i >= nHerdados) {
+            gerarIndividuo(popNova.genoma(i), rng);
+        } else if (copiasDoMelhor) {
+            realizarMutacao(popNova.genoma(i), rng, est, ctx.tabelaNumGenes, ctx.indicesPorTrabalhador[id],
+                            ctx.marcasPorTrabalhador[id]);
+        } else {
+            return;
+        }
+        popNova.passoReavaliacao[i] = 1;
+        popNova.linhasPrefixo[i] = 0;
+    });
 }
 
-/// @brief Gera a próxima geração de indivíduos aplicando Seleção por Roleta.
+/// @brief Gera a próxima geração: seleção de pais, cruzamento e mutação.
 /// 
-///  Reprodução: Seleciona pais via Roleta (maior fitness = maior chance), realiza o 
-///  Cruzamento Aritmético e aplica a Mutação no filho gerado.
+///  Reprodução: Seleciona pais com a estratégia escolhida em Config::_sel (roleta,
+///  torneio ou SUS, ver Selecao.h), realiza o Cruzamento Aritmético e aplica a
+///  Mutação no filho gerado.
+///  Os filhos são gerados em paralelo; o filho i sempre usa o fluxo (geração, i).
 /// 
 /// @param pop A população da geração atual.
-/// @return A nova população evoluída (mesmo tamanho da anterior).
-vector<Individuo> selecaoPorRoleta(vector<Individuo>& pop) {
-    int idxPior = 0, idxMelhor = 0;
-    for(size_t i=1; i<pop.size(); i++) {
-        if(pop[i].fitness < pop[idxPior].fitness) idxPior = i;
-        if(pop[i].fitness > pop[idxMelhor].fitness) idxMelhor = i;
+/// @param novaPop Buffer da próxima geração, sobrescrito. Pode ser menor que 'pop' (tamanho
+///                adaptativo): os pais saem de 'pop' inteira e só novaPop.tamanho() filhos são gerados.
+/// @param est Estado evolutivo atual (geração e incremento da mutação).
+/// @param ctx Pool e buffers de trabalho (o principal ou o de uma ilha).
+void realizarSelecao(const Populacao& pop, Populacao& novaPop, const EstadoEvolutivo& est, ContextoEvolutivo& ctx) {
+    int idxMelhor = 0;
+    for(int i=1; i<pop.tamanho(); i++) {
+        if(pop.fitness[i] > pop.fitness[idxMelhor]) idxMelhor = i;
     }
 
-    vector<Individuo> novaPop;
-    
-    // Elitismo: Mantém o melhor absoluto
-    novaPop.push_back(pop[idxMelhor]); 
+    // Elitismo: Mantém o melhor absoluto (com avaliação e cache, sem ser simulado de novo)
+    novaPop.copiarDe(pop, idxMelhor, 0); 
 
-    // Prepara a roleta
-    vector<double> roleta;
-    double fitnessPior = pop[idxPior].fitness;
-    
-    // Normalização para garantir probabilidades positivas
-    double normalizacao = (fitnessPior < 0) ? (-fitnessPior + 1.0) : 0.0;
-
-    for(const auto& ind : pop) {
-        roleta.push_back(ind.fitness + normalizacao + 0.1); // +0.1 para evitar zero absoluto
-    }
+    // Prepara a seleção e o sorteio da mutação (uma vez por geração, fora do pool)
+    unsigned long long inicioPreparo = instanteMetrica();
+    EstrategiaSelecao& selecao = ctx.obterSelecao(c._sel);
+    selecao.preparar(pop, est);
+    ctx.tabelaNumGenes.construir(c.listaPNumGene);
+    registrarFase(FASE_SELECAO, inicioPreparo);
 
     // Geração da nova população
-    while(novaPop.size() < pop.size()) {
-        int genitor1Idx = escolherIndiceDeProbabilidades(roleta);
-        int genitor2Idx = escolherIndiceDeProbabilidades(roleta);
+    prepararTrabalhadores(ctx);
+    ctx.executor().paraCada(min(novaPop.tamanho(), pop.tamanho()) - 1, [&](int k, int id) {
+        int i = k + 1;
+        Gerador& rng = ctx.geradores[id];
+        reposicionarGerador(rng, est.geracao, ctx.primeiroIndice + i, FLUXO_FILHO);
+
+        unsigned long long instante = instanteMetrica();
+        int genitor1Idx, genitor2Idx;
+        selecao.escolherPais(i, rng, genitor1Idx, genitor2Idx);
+        registrarFase(FASE_SELECAO, instante);
         
-        Individuo filho = realizarCruzamento(pop[genitor1Idx], pop[genitor2Idx]);
-        filho = realizarMutacao(filho);
-        novaPop.push_back(filho);
-    }
-    return novaPop;
+        instante = instanteMetrica();
+        double* filho = novaPop.genoma(i);
+        int geneCruzamento = realizarCruzamento(pop.genoma(genitor1Idx), pop.genoma(genitor2Idx), filho);
+        registrarFase(FASE_CRUZAMENTO, instante);
+
+        instante = instanteMetrica();
+        int geneMutacao = realizarMutacao(filho, rng, est, ctx.tabelaNumGenes, ctx.indicesPorTrabalhador[id],
+                                          ctx.marcasPorTrabalhador[id]);
+        registrarFase(FASE_MUTACAO, instante);
+        herdarPrefixo(pop, genitor1Idx, novaPop, i, min(geneCruzamento, geneMutacao));
+    });
 }
@@ -2,12 +2,62 @@
 #define EVOLUTION_H
 
 #include "Types.h"
+#include "Utils.h"
+#include "Populacao.h"
+#include "Selecao.h"
+#include "BuscaLocal.h"
+#include "Paralelo.h"
 #include <vector>
+#include <string>
+#include <memory>
+#include <utility>
 
-Individuo gerarIndividuo();
-Individuo realizarMutacao(Individuo ind);
-Individuo realizarCruzamento(const Individuo& pai1, const Individuo& pai2);
-std::vector<Individuo> realizarCatastrofe(std::vector<Individuo>& pop);
-std::vector<Individuo> selecaoPorRoleta(std::vector<Individuo>& pop);
+/// @brief Pool e buffers de trabalho usados pelos operadores evolutivos.
+///
+/// O contexto principal usa o pool global (todos os núcleos). No modo de ilhas cada ilha
+/// tem o seu, com um pool de tamanho 1: os operadores rodam inteiros na thread da ilha,
+/// sem disputar buffers com as outras (ver Ilhas.h).
+struct ContextoEvolutivo {
+    PoolDeThreads* pool;   // nullptr = pool global
+    int primeiroIndice;    // índice global do indivíduo 0 (separa os fluxos aleatórios das ilhas)
+    const std::vector<std::vector<double>>* solucoesIK; // sementes de IK próprias; nullptr = as de prepararSementesIK
+
+    std::vector<Gerador> geradores;                    // um por trabalhador
+    std::vector<std::vector<int>> indicesPorTrabalhador; // vetor de índices da mutação, um por trabalhador
+    std::vector<std::vector<unsigned char>> marcasPorTrabalhador; // marcas do sorteio sem repetição da mutação
+    std::vector<std::vector<double>> genomasPorTrabalhador; // rascunho da busca local, um por trabalhador
+    TabelaAlias tabelaNumGenes;                        // sorteio da quantidade de genes mutados
+    std::vector<std::pair<double, int>> ordemFitness;
+    std::vector<std::pair<int, int>> pendentes;
+    std::unique_ptr<EstrategiaSelecao> selecao;
+    std::string nomeSelecao;
+    std::unique_ptr<BuscaLocal> buscaLocal;
+    std::string nomeBuscaLocal;
+    std::vector<int> avaliacoesLocais; // gastas por refinado na última chamada de refinarMelhores
+
+    ContextoEvolutivo() : pool(nullptr), primeiroIndice(0), solucoesIK(nullptr) {}
+    PoolDeThreads& executor() { return pool ? *pool : *::pool; }
+    EstrategiaSelecao& obterSelecao(const std::string& nome);
+    const BuscaLocal* obterBuscaLocal(const std::string& nome); // nullptr com _loc_off
+};
+
+// Contexto do laço principal (população única)
+extern ContextoEvolutivo contextoPrincipal;
+
+void gerarIndividuo(double* genoma, Gerador& rng);
+void prepararSementesIK(Ponto alvo);
+int quantidadeSolucoesIK();
+int realizarMutacao(double* genoma, Gerador& rng, const EstadoEvolutivo& est, const TabelaAlias& tabelaNumGenes,
+                    std::vector<int>& indices, std::vector<unsigned char>& marcas);
+int realizarCruzamento(const double* pai1, const double* pai2, double* filho);
+void gerarPopulacaoInicial(Populacao& pop, ContextoEvolutivo& ctx = contextoPrincipal);
+int avaliarPopulacao(Populacao& pop, Ponto alvo, ContextoEvolutivo& ctx = contextoPrincipal);
+int refinarMelhores(Populacao& pop, Ponto alvo, const EstadoEvolutivo& est,
+                    ContextoEvolutivo& ctx = contextoPrincipal);
+void realizarCatastrofe(const Populacao& pop, Populacao& popNova, const EstadoEvolutivo& est,
+                        ContextoEvolutivo& ctx = contextoPrincipal);
+void aquecerPopulacao(const Populacao& pop, Populacao& popNova, int rodada, ContextoEvolutivo& ctx = contextoPrincipal);
+void realizarSelecao(const Populacao& pop, Populacao& novaPop, const EstadoEvolutivo& est,
+                     ContextoEvolutivo& ctx = contextoPrincipal);
 
 #endif
@@ -0,0 +1,580 @@
+#include "Execucao.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Robot.h"
+#include "Evolution.h"
+#include "Populacao.h"
+#include "Lote.h"
+#include "Saida.h"
+#include "Metricas.h"
+#include "MapaColisao.h"
+#include "CacheSolucoes.h"
+#include "Checkpoint.h"
+#include "Cena.h"
+#include "Braco.h"
+#include "Genoma.h"
+#include "Ilhas.h"
+#include <chrono>
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Variável para armazenar o melhor global
+Individuo melhorGeral;
+
+// Geração atual e buffer da próxima: mantidas entre execuções para o aquecimento do modo servidor
+static Populacao pop, popProxima;
+static int rodadasAquecimento = 0;
+static Arquipelago arquipelago;
+
+/// @brief Segundos decorridos desde 'inicio'.
+static double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+LimitesExecucao limitesDaConfig() {
+    LimitesExecucao lim;
+    lim.maxSegundos = c.maxSegundosAlvo;
+    lim.maxAvaliacoes = c.maxAvaliacoes;
+    lim.geracoesAposVitoria = c.geracoesAposVitoria;
+    lim.geracoesPlato = c.geracoesPlato;
+    lim.toleranciaPlato = c.toleranciaPlato;
+    lim.prazoGeracao = c.prazoGeracaoMs / 1000.0;
+    return lim;
+}
+
+void CanalReplanejamento::moverAlvo(Ponto novo) {
+    lock_guard<mutex> lock(trava);
+    alvo = novo;
+    temAlvo = true;
+    pendentes.store(true, memory_order_release);
+}
+
+void CanalReplanejamento::moverObstaculo(const Obstaculo& bolaDeDemolicao) {
+    lock_guard<mutex> lock(trava);
+    bola = bolaDeDemolicao;
+    temBola = true;
+    pendentes.store(true, memory_order_release);
+}
+
+void CanalReplanejamento::substituirObstaculos(const vector<Obstaculo>& novasEsferas, const vector<Caixa>& novasCaixas) {
+    lock_guard<mutex> lock(trava);
+    esferas = novasEsferas;
+    caixas = novasCaixas;
+    temCena = true;
+    pendentes.store(true, memory_order_release);
+}
+
+int CanalReplanejamento::aplicar(Ponto& alvoAtual) {
+    lock_guard<mutex> lock(trava);
+    int mudancas = 0;
+    if (temAlvo && (alvo.x != alvoAtual.x || alvo.y != alvoAtual.y || alvo.z != alvoAtual.z)) {
+        alvoAtual = alvo;
+        mudancas |= REPLANEJAR_ALVO;
+    }
+    if (temBola) {
+        c.bolaDeDemolicao = bola;
+        mudancas |= REPLANEJAR_OBSTACULOS;
+    }
+    if (temCena) {
+        c.esferasCena.swap(esferas);
+        c.caixasCena.swap(caixas);
+        mudancas |= REPLANEJAR_OBSTACULOS;
+    }
+    temAlvo = temBola = temCena = false;
+    pendentes.store(false, memory_order_release);
+    return mudancas;
+}
+
+void CanalReplanejamento::descartar() {
+    lock_guard<mutex> lock(trava);
+    temAlvo = temBola = temCena = false;
+    pendentes.store(false, memory_order_release);
+}
+
+/// @brief Encolhe a população para cada geração caber no prazo (LimitesExecucao::prazoGeracao).
+///
+/// O custo de uma avaliação é medido a cada geração (tempo da geração inteira dividido pelas
+/// avaliações feitas nela, em média móvel, então seleção, busca local e streaming entram no
+/// custo). A geração seguinte usa só os indivíduos que cabem em FRACAO_PRAZO do prazo; com
+/// folga, a população volta a crescer até nIndv. As posições fora de uso continuam guardadas,
+/// como no tamanho adaptativo.
+struct ControlePrazo {
+    static constexpr double FRACAO_PRAZO = 0.8;
+    double prazo = 0.0;          // segundos; 0 = sem prazo
+    double custoAvaliacao = 0.0; // segundos por avaliação; 0 = ainda não medido
+
+    void observar(double segundos, long long avaliacoes) {
+        if (prazo <= 0 || avaliacoes <= 0) return;
+        double custo = segundos / avaliacoes;
+        custoAvaliacao = custoAvaliacao > 0 ? 0.7 * custoAvaliacao + 0.3 * custo : custo;
+    }
+
+    // Indivíduos que cabem no prazo (nIndv sem prazo ou antes da primeira medida)
+    int tamanho() const {
+        if (prazo <= 0 || custoAvaliacao <= 0) return c.nIndv;
+        double cabem = FRACAO_PRAZO * prazo / custoAvaliacao;
+        return cabem >= c.nIndv ? c.nIndv : max(2, (int)cabem);
+    }
+};
+
+/// @brief Estado escalar do laço (o que não está nas populações nem no melhor global).
+static QuadroCheckpoint montarQuadro(const EstadoEvolutivo& est, const ControleParada& parada,
+                                     const ResultadoExecucao& res, double segundos) {
+    QuadroCheckpoint q;
+    q.semente = sementeBase;
+    q.est = est;
+    q.segundos = segundos;
+    q.geracaoAvanco = parada.geracaoAvanco;
+    q.geracaoPlato = parada.geracaoPlato;
+    q.fitnessPlato = parada.fitnessPlato;
+    q.avaliacoes = res.avaliacoes;
+    q.geracaoPrimeiraVitoria = res.geracaoPrimeiraVitoria;
+    q.avaliacoesPrimeiraVitoria = res.avaliacoesPrimeiraVitoria;
+    q.segundosPrimeiraVitoria = res.segundosPrimeiraVitoria;
+    q.semeadosCache = res.semeadosCache;
+    q.catastrofes = res.catastrofes;
+    q.replanejamentos = res.replanejamentos;
+    q.prazosEstourados = res.prazosEstourados;
+    return q;
+}
+
+static void aplicarQuadro(const QuadroCheckpoint& q, EstadoEvolutivo& est, ControleParada& parada,
+                          ResultadoExecucao& res, double& segundos) {
+    sementeBase = q.semente;
+    est = q.est;
+    segundos = q.segundos;
+    parada.geracaoAvanco = q.geracaoAvanco;
+    parada.geracaoPlato = q.geracaoPlato;
+    parada.fitnessPlato = q.fitnessPlato;
+    res.avaliacoes = q.avaliacoes;
+    res.geracoes = est.geracao;
+    res.geracaoPrimeiraVitoria = q.geracaoPrimeiraVitoria;
+    res.avaliacoesPrimeiraVitoria = q.avaliacoesPrimeiraVitoria;
+    res.segundosPrimeiraVitoria = q.segundosPrimeiraVitoria;
+    res.semeadosCache = q.semeadosCache;
+    res.catastrofes = q.catastrofes;
+    res.replanejamentos = q.replanejamentos;
+    res.prazosEstourados = q.prazosEstourados;
+}
+
+/// @brief Grava o estado do laço no início da geração est.geracao (ver Checkpoint.h).
+static void gravarEstado(Ponto alvo, const EstadoEvolutivo& est, const ControleParada& parada,
+                         const ResultadoExecucao& res, double segundos) {
+    MedidorFase medidor(FASE_CHECKPOINT);
+    QuadroCheckpoint q = montarQuadro(est, parada, res, segundos);
+    if (!gravarCheckpoint(c.arquivoCheckpoint, alvo, q, melhorGeral, pop, popProxima))
+        cerr << "AVISO checkpoint nao gravado em " << c.arquivoCheckpoint << endl;
+}
+
+/// @brief Continua do checkpoint de Config::arquivoCheckpoint: populações, melhor global,
+/// semente e contadores voltam a ser os do início da geração gravada, então o resto da
+/// execução é idêntico ao da execução que não foi interrompida.
+/// @param segundos Recebe o tempo que a execução já tinha quando foi gravada.
+/// @return false se não houver checkpoint utilizável (a execução começa do zero).
+static bool retomarEstado(Ponto alvo, EstadoEvolutivo& est, ControleParada& parada, ResultadoExecucao& res,
+                          double& segundos) {
+    QuadroCheckpoint q;
+    if (!lerCheckpoint(c.arquivoCheckpoint, alvo, q, melhorGeral, pop, popProxima)) {
+        cerr << "AVISO checkpoint " << c.arquivoCheckpoint << " ausente ou incompativel; execucao do zero" << endl;
+        return false;
+    }
+    aplicarQuadro(q, est, parada, res, segundos);
+    return true;
+}
+
+/// @brief Continua do estado em memória (LimitesExecucao::estado); as populações e o melhor
+/// são trocados, não copiados.
+static bool retomarDaMemoria(EstadoLaco& estado, Ponto alvo, EstadoEvolutivo& est, ControleParada& parada,
+                             ResultadoExecucao& res, double& segundos) {
+    bool mesmasDimensoes = estado.pop.capacidade == c.nIndv && estado.pop.nGenes == c.nGenes &&
+                           estado.pop.nJuntas == c.nJuntas && estado.proxima.capacidade == c.nIndv;
+    if (!estado.valido || !mesmasDimensoes || estado.alvo.x != alvo.x || estado.alvo.y != alvo.y ||
+        estado.alvo.z != alvo.z)
+        return false;
+    swap(pop, estado.pop);
+    swap(popProxima, estado.proxima);
+    swap(melhorGeral, estado.melhor);
+    aplicarQuadro(estado.quadro, est, parada, res, segundos);
+    estado.valido = false;
+    return true;
+}
+
+/// @brief Devolve ao estado em memória o laço no início da geração est.geracao.
+static void guardarNaMemoria(EstadoLaco& estado, Ponto alvo, const EstadoEvolutivo& est,
+                             const ControleParada& parada, const ResultadoExecucao& res, double segundos) {
+    swap(pop, estado.pop);
+    swap(popProxima, estado.proxima);
+    estado.melhor = melhorGeral;
+    estado.quadro = montarQuadro(est, parada, res, segundos);
+    estado.alvo = alvo;
+    estado.valido = true;
+}
+
+/// @brief Invalida todas as avaliações guardadas na população (inclusive nas posições fora de
+/// uso): fitness, vitória e cache de prefixo. Custa uma passada pelos metadados, sem tocar nos
+/// genomas; quem estiver em uso é reavaliado na próxima avaliarPopulacao.
+static void descartarAvaliacoes(Populacao& p) {
+    p.marcarTodosParaReavaliar();
+    fill(p.fitness.begin(), p.fitness.end(), -1e9);
+    fill(p.passoVitoria.begin(), p.passoVitoria.end(), 0);
+    fill(p.venceu.begin(), p.venceu.end(), (unsigned char)0);
+}
+
+/// @brief Tamanho da próxima geração sem o prazo: o adaptativo com _pop_adaptativa, nIndv
+/// nos demais (mesmo que o prazo tenha encolhido a atual, para ela voltar quando houver folga).
+static int tamanhoDesejado(const Populacao& pop, const EstadoEvolutivo& est) {
+    return c._pop == "_pop_adaptativa" ? tamanhoAdaptativo(pop, est) : c.nIndv;
+}
+
+/// @brief Aplica no início de uma geração as mudanças pendentes do canal (replanejamento ao vivo).
+///
+/// Ao contrário do aquecimento do modo servidor, nenhum indivíduo é trocado: a população
+/// inteira continua e só as avaliações são descartadas, então a geração em curso reavalia
+/// todos contra o alvo e a cena novos (com prazo, só os que cabem nele). O melhor global é
+/// reavaliado na hora e disputa com eles; estagnação e platô voltam a contar desta geração.
+/// @return false se o canal não tinha mudança de fato.
+static bool replanejar(CanalReplanejamento& canal, Ponto& alvo, EstadoEvolutivo& est, ControleParada& parada,
+                       ResultadoExecucao& res, const LimitesExecucao& lim, const ControlePrazo& prazo) {
+    int mudancas = canal.aplicar(alvo);
+    if (!mudancas) return false;
+    if (mudancas & REPLANEJAR_OBSTACULOS) {
+        montarCena();
+        prepararMapaColisao();
+    }
+    if (mudancas & REPLANEJAR_ALVO) prepararSementesIK(alvo);
+
+    descartarAvaliacoes(pop);
+    descartarAvaliacoes(popProxima);
+    pop.ajustarTamanho(min(tamanhoDesejado(pop, est), prazo.tamanho()));
+    reavaliarIndividuo(melhorGeral, alvo);
+
+    est.estagAtual = 0;
+    parada = ControleParada();
+    parada.geracaoAvanco = parada.geracaoPlato = est.geracao;
+    res.replanejamentos++;
+    if (lim.streaming) {
+        if (mudancas & REPLANEJAR_ALVO) imprimirAlvo(alvo);
+        if (mudancas & REPLANEJAR_OBSTACULOS) imprimirObstaculo();
+    }
+    return true;
+}
+
+/// @brief Tamanho da próxima geração com Config::_pop = "_pop_adaptativa".
+///
+/// Logo depois de um avanço do melhor a população está concentrada na bacia dele e poucos
+/// indivíduos bastam para continuar subindo: a geração seguinte tem metade do tamanho (até
+/// nIndvMin). Com o melhor parado há estagReducao gerações a população volta ao tamanho
+/// cheio; as posições fora de uso guardam indivíduos de gerações anteriores, já avaliados
+/// contra este alvo, então a volta não custa avaliações.
+int tamanhoAdaptativo(const Populacao& pop, const EstadoEvolutivo& est) {
+    if (c._pop != "_pop_adaptativa") return pop.tamanho();
+    if (est.estagAtual >= c.estagReducao) return c.nIndv;
+    if (est.estagAtual == 0) return max(min(c.nIndvMin, c.nIndv), pop.tamanho() / 2);
+    return pop.tamanho();
+}
+
+GeracaoAvaliada avaliarGeracao(Populacao& pop, Ponto alvo, EstadoEvolutivo& est, ControleParada& parada,
+                               ResultadoExecucao& res, Individuo& melhor, double toleranciaPlato,
+                               chrono::steady_clock::time_point inicio, ContextoEvolutivo& ctx) {
+    GeracaoAvaliada g;
+
+    // Avaliação da população (paralela), busca local nos melhores e redução sequencial, em ordem fixa
+    res.avaliacoes += avaliarPopulacao(pop, alvo, ctx);
+    res.avaliacoes += refinarMelhores(pop, alvo, est, ctx);
+    int idxMelhorLocal = 0;
+    double somaFitness = 0.0;
+    for (int i = 0; i < pop.tamanho(); i++) {
+        somaFitness += pop.fitness[i];
+        if (pop.fitness[i] > pop.fitness[idxMelhorLocal]) idxMelhorLocal = i;
+    }
+    double fitnessMelhorLocal = pop.fitness[idxMelhorLocal];
+    g.mediaFitness = somaFitness / pop.tamanho();
+
+    g.melhorou = fitnessMelhorLocal > melhor.fitness;
+    if (g.melhorou) {
+        // Só aqui o genoma é copiado (nos buffers do melhor); a trajetória cartesiana só é
+        // reconstruída quando for enviada
+        extrairIndividuo(pop, idxMelhorLocal, melhor);
+        reavaliarIndividuo(melhor, alvo);
+        alterarIncrementoDaMutacaoAtual(est, true);
+    } else if (abs(fitnessMelhorLocal - melhor.fitness) < 0.5) {
+        est.estagAtual++;
+        if (est.estagAtual > c.minEstag) alterarIncrementoDaMutacaoAtual(est, false);
+    }
+    parada.observar(est.geracao, g.melhorou, melhor.fitness, toleranciaPlato);
+
+    g.primeiraVitoria = melhor.venceu && res.geracaoPrimeiraVitoria < 0;
+    if (g.primeiraVitoria) {
+        res.geracaoPrimeiraVitoria = est.geracao;
+        res.avaliacoesPrimeiraVitoria = res.avaliacoes;
+        res.segundosPrimeiraVitoria = segundosDesde(inicio);
+    }
+    res.geracoes = est.geracao + 1;
+    return g;
+}
+
+void fecharGeracao(Populacao& pop, Populacao& proxima, Ponto alvo, EstadoEvolutivo& est, ResultadoExecucao& res,
+                   int tamanhoMaximo, ContextoEvolutivo& ctx) {
+    // Catástrofe. Com o tamanho adaptativo (ou o prazo), a população volta ao tamanho máximo
+    // antes: as posições fora de uso guardam indivíduos de gerações anteriores, já avaliados
+    // contra este alvo, que disputam a elite com os atuais
+    if (est.estagAtual > c.minEstagCat) {
+        alterarIncrementoDaMutacaoAtual(est, true);
+        pop.ajustarTamanho(tamanhoMaximo);
+        proxima.ajustarTamanho(tamanhoMaximo);
+        realizarCatastrofe(pop, proxima, est, ctx);
+        swap(pop, proxima);
+        res.avaliacoes += avaliarPopulacao(pop, alvo, ctx);
+        res.catastrofes++;
+    }
+
+    // Seleção e mutação
+    proxima.ajustarTamanho(min(tamanhoDesejado(pop, est), tamanhoMaximo));
+    realizarSelecao(pop, proxima, est, ctx);
+    swap(pop, proxima);
+    est.geracao++;
+}
+
+/// @brief Substitui os últimos indivíduos (os aleatórios) pelas soluções guardadas de
+/// alvos próximos no mesmo cenário.
+/// @return Quantidade de indivíduos semeados.
+static int semearDoCache(Populacao& pop, Ponto alvo) {
+    if (!cacheSolucoes.aberto()) return 0;
+
+    static vector<int> vizinhos;
+    int maximo = (int)(c.fracaoCache * pop.tamanho());
+    int n = cacheSolucoes.buscarVizinhos(alvo, c.raioCache, maximo, vizinhos);
+    for (int k = 0; k < n; k++) {
+        int i = pop.tamanho() - 1 - k;
+        const double* origem = cacheSolucoes.genoma(vizinhos[k]);
+        copy(origem, origem + pop.doublesPorGenoma(), pop.genoma(i));
+        pop.passoReavaliacao[i] = 1;
+        pop.linhasPrefixo[i] = 0;
+    }
+    cacheSolucoes.registrarConsulta(n > 0);
+    return n;
+}
+
+/// @brief Laço do modelo de ilhas (Config::nIlhas > 1, ver Arquipelago).
+///
+/// As ilhas evoluem uma época inteira sem sincronizar; melhor global, streaming e
+/// critérios de parada são verificados entre as épocas, então a execução pode passar
+/// até intervaloMigracao - 1 gerações do momento da vitória. O aquecimento do modo
+/// servidor não se aplica: cada execução parte de ilhas novas.
+static ResultadoExecucao executarEmIlhas(Ponto alvo, const LimitesExecucao& lim) {
+    ResultadoExecucao res;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+    if (!c.arquivoCheckpoint.empty()) cerr << "AVISO checkpoint nao suportado no modelo de ilhas; ignorado" << endl;
+
+    int nIlhas = c.nIlhas;
+    int tamanhoIlha = max(2, c.nIndv / nIlhas);
+    arquipelago.iniciar(nIlhas, tamanhoIlha);
+    res.semeadosCache = semearDoCache(arquipelago.ilha(0).pop, alvo);
+
+    melhorGeral = Individuo();
+    if (lim.streaming) {
+        imprimirAlvo(alvo);
+        imprimirObstaculo();
+    }
+
+    ControleParada parada;
+    int geracao = 0;
+    for (int epoca = 0; ; epoca++) {
+        int geracoes = c.intervaloMigracao;
+        if (lim.maxGeracoes > 0) geracoes = min(geracoes, lim.maxGeracoes - geracao);
+        res.avaliacoes += arquipelago.evoluirEpoca(alvo, geracoes, epoca);
+        geracao += geracoes;
+
+        // Redução em ordem fixa de ilha: o melhor global não depende da ordem das threads
+        bool melhorou = false;
+        double somaMedias = 0.0;
+        int vitoria = -1;
+        res.catastrofes = 0;
+        for (int i = 0; i < nIlhas; i++) {
+            Ilha& il = arquipelago.ilha(i);
+            somaMedias += il.mediaFitness;
+            res.catastrofes += il.catastrofes;
+            if (il.geracaoVitoria >= 0 && (vitoria < 0 || il.geracaoVitoria < vitoria)) vitoria = il.geracaoVitoria;
+            if (il.melhor.fitness > melhorGeral.fitness) {
+                melhorGeral.genoma.assign(il.melhor.genoma.begin(), il.melhor.genoma.end());
+                melhorGeral.fitness = il.melhor.fitness;
+                melhorou = true;
+            }
+        }
+        // A trajetória só é reconstruída quando vai ser enviada
+        if (melhorou) reavaliarIndividuo(melhorGeral, alvo);
+        parada.observar(geracao - 1, melhorou, melhorGeral.fitness, lim.toleranciaPlato);
+
+        if (vitoria >= 0 && res.geracaoPrimeiraVitoria < 0) {
+            res.geracaoPrimeiraVitoria = vitoria;
+            res.avaliacoesPrimeiraVitoria = res.avaliacoes;
+            res.segundosPrimeiraVitoria = segundosDesde(inicio);
+            cacheSolucoes.registrarVitoria(res.semeadosCache > 0, res.segundosPrimeiraVitoria);
+            cacheSolucoes.registrar(alvo, melhorGeral.genoma.data(), melhorGeral.fitness, res.segundosPrimeiraVitoria);
+        }
+
+        if (lim.streaming) {
+            if (melhorou) {
+                registrarTrajetoria(melhorGeral, alvo);
+                imprimirTrajetoria(melhorGeral);
+            }
+            imprimirEstatisticas(geracao - 1, melhorGeral, somaMedias / nIlhas);
+            // Uma época cobre várias gerações: vale se o intervalo foi cruzado nela
+            if (c.intervaloMetricas > 0 && geracao / c.intervaloMetricas != (geracao - geracoes) / c.intervaloMetricas)
+                imprimirMetricas();
+        }
+
+        res.geracoes = geracao;
+        if (parada.deveParar(lim, res, geracao - 1, segundosDesde(inicio), melhorGeral.venceu, res.desfecho)) break;
+    }
+
+    res.segundos = segundosDesde(inicio);
+    if (melhorGeral.venceu)
+        cacheSolucoes.registrar(alvo, melhorGeral.genoma.data(), melhorGeral.fitness, res.segundosPrimeiraVitoria);
+    if (lim.streaming && res.desfecho != DESFECHO_INTERROMPIDO) imprimirDesfecho(res, melhorGeral);
+    return res;
+}
+
+/// @brief Executa o algoritmo evolutivo para um alvo até atingir um dos limites.
+///
+/// Com os limites padrão (todos zero) o laço é infinito, como no modo visual: o
+/// programa roda até o Python matar o processo.
+///
+/// Com 'aquecer', a população que sobrou da execução anterior (se tiver as mesmas
+/// dimensões) é reavaliada contra o novo alvo e serve de ponto de partida (ver
+/// aquecerPopulacao); caso contrário a população inicial é aleatória. Em ambos os casos,
+/// com o cache de soluções aberto, parte da população vem de alvos próximos já resolvidos,
+/// e a solução encontrada é guardada nele.
+///
+/// Com Config::nIlhas > 1 a população é dividida em ilhas (ver executarEmIlhas).
+///
+/// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+/// @param lim Limites de gerações/tempo, parada na vitória, streaming e interrupção.
+/// @param aquecer Reaproveita a população da execução anterior.
+/// @return Medidas da execução (gerações, avaliações, tempo até a primeira vitória).
+ResultadoExecucao executarEvolucao(Ponto alvo, const LimitesExecucao& lim, bool aquecer) {
+    // Obstáculos, braço e genoma podem ter mudado desde a execução anterior (modo servidor, benchmark)
+    montarBraco();
+    montarGenoma();
+    montarCena();
+    prepararMapaColisao();
+    prepararSementesIK(alvo);
+    // As métricas cobrem só esta execução (montagem do braço, da cena e das sementes ficam de fora)
+    zerarMetricas();
+    if (c.nIlhas > 1) return executarEmIlhas(alvo, lim);
+
+    ResultadoExecucao res;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+    EstadoEvolutivo est;
+    ControleParada parada;
+    ControlePrazo prazo;
+    prazo.prazo = lim.prazoGeracao;
+
+    double segundosAnteriores = 0.0;
+    bool retomada = lim.estado && retomarDaMemoria(*lim.estado, alvo, est, parada, res, segundosAnteriores);
+    if (!retomada && c.retomarCheckpoint && !c.arquivoCheckpoint.empty())
+        retomada = retomarEstado(alvo, est, parada, res, segundosAnteriores);
+    bool mesmasDimensoes = pop.capacidade == c.nIndv && pop.nGenes == c.nGenes && pop.nJuntas == c.nJuntas;
+    if (retomada) {
+        // O relógio continua de onde a execução gravada parou
+        inicio -= chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(segundosAnteriores));
+    } else if (aquecer && c._aq != "_aq_off" && mesmasDimensoes) {
+        // O alvo (ou o obstáculo) mudou: nenhuma avaliação guardada vale mais
+        pop.ajustarTamanho(c.nIndv);
+        popProxima.ajustarTamanho(c.nIndv);
+        pop.marcarTodosParaReavaliar();
+        res.avaliacoes += avaliarPopulacao(pop, alvo);
+        aquecerPopulacao(pop, popProxima, ++rodadasAquecimento);
+        swap(pop, popProxima);
+    } else {
+        // Alocados uma vez e trocados a cada geração
+        pop.redimensionar(c.nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+        popProxima.redimensionar(c.nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+        gerarPopulacaoInicial(pop);
+    }
+    if (!retomada) {
+        res.semeadosCache = semearDoCache(pop, alvo);
+        chrono::steady_clock::time_point inicioAvaliacao = chrono::steady_clock::now();
+        int avaliadas = avaliarPopulacao(pop, alvo);
+        res.avaliacoes += avaliadas;
+        prazo.observar(segundosDesde(inicioAvaliacao), avaliadas);
+        extrairIndividuo(pop, 0, melhorGeral);
+        reavaliarIndividuo(melhorGeral, alvo);
+    }
+    if (lim.streaming) {
+        imprimirAlvo(alvo);
+        imprimirObstaculo();
+    }
+
+    // A trajetória só é reenviada quando o melhor global muda
+    bool trajetoriaPendente = true;
+    int geracaoGravada = est.geracao;
+
+    while (true) {
+        chrono::steady_clock::time_point inicioGeracao = chrono::steady_clock::now();
+        long long avaliacoesAntes = res.avaliacoes;
+
+        // Alvo ou obstáculos movidos durante a execução: a população continua, reavaliada
+        bool replanejou = lim.replanejamento && lim.replanejamento->pendente() &&
+                          replanejar(*lim.replanejamento, alvo, est, parada, res, lim, prazo);
+        if (replanejou) trajetoriaPendente = true;
+
+        // Checkpoint no início da geração: a população ainda não foi avaliada contra ela
+        if (!c.arquivoCheckpoint.empty() && est.geracao > geracaoGravada && est.geracao % c.intervaloCheckpoint == 0) {
+            gravarEstado(alvo, est, parada, res, segundosDesde(inicio));
+            geracaoGravada = est.geracao;
+        }
+
+        // Avaliação, melhor global, estagnação e primeira vitória
+        GeracaoAvaliada g = avaliarGeracao(pop, alvo, est, parada, res, melhorGeral, lim.toleranciaPlato, inicio,
+                                           contextoPrincipal);
+        if (g.melhorou) trajetoriaPendente = true;
+        if (g.primeiraVitoria) {
+            // Guardada já na primeira vitória: o modo visual nunca sai do laço
+            cacheSolucoes.registrarVitoria(res.semeadosCache > 0, res.segundosPrimeiraVitoria);
+            cacheSolucoes.registrar(alvo, melhorGeral.genoma.data(), melhorGeral.fitness, res.segundosPrimeiraVitoria);
+        }
+
+        // Streaming de dados. Com prazo por geração, ou logo depois de um replanejamento, a
+        // trajetória nova sai na mesma geração em que apareceu
+        bool enviar = est.geracao % c.printGeracoes == 0 || (trajetoriaPendente && (replanejou || prazo.prazo > 0));
+        if (lim.streaming && enviar) {
+            if (trajetoriaPendente) {
+                registrarTrajetoria(melhorGeral, alvo);
+                imprimirTrajetoria(melhorGeral);
+                trajetoriaPendente = false;
+            }
+            imprimirEstatisticas(est.geracao, melhorGeral, g.mediaFitness);
+        }
+        if (lim.streaming && c.intervaloMetricas > 0 && (est.geracao + 1) % c.intervaloMetricas == 0)
+            imprimirMetricas();
+
+        // Critérios de parada (o laço visual não tem nenhum). Com o estado guardado em memória
+        // a geração termina (catástrofe e seleção) antes de sair, para a próxima chamada
+        // começar exatamente onde esta começaria
+        bool parar = parada.deveParar(lim, res, est.geracao, segundosDesde(inicio), melhorGeral.venceu, res.desfecho);
+        if (parar && !lim.estado) break;
+
+        // Catástrofe e seleção, com a população limitada ao que cabe no prazo
+        fecharGeracao(pop, popProxima, alvo, est, res, prazo.tamanho(), contextoPrincipal);
+
+        double segundosGeracao = segundosDesde(inicioGeracao);
+        prazo.observar(segundosGeracao, res.avaliacoes - avaliacoesAntes);
+        if (prazo.prazo > 0 && segundosGeracao > prazo.prazo) res.prazosEstourados++;
+        if (parar) break;
+    }
+
+    res.segundos = segundosDesde(inicio);
+    if (lim.estado) guardarNaMemoria(*lim.estado, alvo, est, parada, res, res.segundos);
+    if (melhorGeral.venceu)
+        cacheSolucoes.registrar(alvo, melhorGeral.genoma.data(), melhorGeral.fitness, res.segundosPrimeiraVitoria);
+    if (lim.streaming && res.desfecho != DESFECHO_INTERROMPIDO) imprimirDesfecho(res, melhorGeral);
+    return res;
+}
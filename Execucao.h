@@ -0,0 +1,180 @@
+#ifndef EXECUCAO_H
+#define EXECUCAO_H
+
+#include "Types.h"
+#include "Populacao.h"
+#include "Checkpoint.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+/// @brief Estado do laço de população única no início de uma geração, guardado em memória
+/// entre duas chamadas de executarEvolucao (o mesmo conteúdo do checkpoint em arquivo).
+/// Usado pela biblioteca (Biblioteca.h) para executar N gerações por vez.
+struct EstadoLaco {
+    bool valido;
+    Ponto alvo;
+    QuadroCheckpoint quadro;
+    Populacao pop, proxima;
+    Individuo melhor;
+
+    EstadoLaco() : valido(false), alvo({0.0, 0.0, 0.0}) {}
+};
+
+// O que CanalReplanejamento::aplicar mudou
+enum MudancaReplanejamento {
+    REPLANEJAR_ALVO = 1,
+    REPLANEJAR_OBSTACULOS = 2
+};
+
+/// @brief Canal de atualização ao vivo do alvo e dos obstáculos (LimitesExecucao::replanejamento).
+///
+/// Qualquer thread deposita a posição nova (a última de cada tipo vale); o laço de população
+/// única a aplica no início da geração seguinte, sem interromper a execução: a população é
+/// mantida e reavaliada contra a cena nova (ver replanejar em Execucao.cpp).
+class CanalReplanejamento {
+public:
+    CanalReplanejamento() : pendentes(false), temAlvo(false), temBola(false), temCena(false), alvo({0.0, 0.0, 0.0}),
+                            bola({0.0, 0.0, 0.0, 0.0}) {}
+
+    void moverAlvo(Ponto novo);
+    void moverObstaculo(const Obstaculo& bolaDeDemolicao); // r = 0 remove
+    void substituirObstaculos(const std::vector<Obstaculo>& esferas, const std::vector<Caixa>& caixas);
+
+    bool pendente() const { return pendentes.load(std::memory_order_acquire); }
+
+    /// Passa as mudanças pendentes para 'alvoAtual' e para Config (bolaDeDemolicao, esferasCena e
+    /// caixasCena). Chamar só fora do pool.
+    /// @return Combinação de MudancaReplanejamento (0 se não havia nada pendente).
+    int aplicar(Ponto& alvoAtual);
+
+    /// Esquece as mudanças pendentes (a evolução que as receberia foi descartada).
+    void descartar();
+
+private:
+    std::mutex trava;
+    std::atomic<bool> pendentes;
+    bool temAlvo, temBola, temCena;
+    Ponto alvo;
+    Obstaculo bola;
+    std::vector<Obstaculo> esferas;
+    std::vector<Caixa> caixas;
+};
+
+// Limites de uma execução do algoritmo (0 = sem limite)
+struct LimitesExecucao {
+    int maxGeracoes;
+    double maxSegundos;
+    long long maxAvaliacoes;
+    bool pararNaVitoria;      // encerra assim que algum indivíduo alcança o alvo
+    int geracoesAposVitoria;  // encerra com o alvo alcançado e o melhor sem avanço há tantas gerações
+    int geracoesPlato;        // encerra se o melhor subiu menos que toleranciaPlato nessas gerações
+    double toleranciaPlato;
+    bool streaming;           // envia trajetória e STATS ao simulador
+    const std::atomic<bool>* interromper; // se apontar para true, encerra na próxima geração (modo servidor)
+    // Continua deste estado, se válido e do mesmo alvo, e guarda nele o estado ao sair. Gerações
+    // e avaliações (inclusive maxGeracoes) contam desde o começo. Ignorado no modelo de ilhas
+    EstadoLaco* estado;
+    // Mudanças de alvo e obstáculos aplicadas sem interromper a execução. Ignorado no modelo de ilhas
+    CanalReplanejamento* replanejamento;
+    // Prazo (segundos) de cada geração: a população encolhe para caber nele (ver ControlePrazo)
+    double prazoGeracao;
+
+    LimitesExecucao() : maxGeracoes(0), maxSegundos(0.0), maxAvaliacoes(0), pararNaVitoria(false),
+                        geracoesAposVitoria(0), geracoesPlato(0), toleranciaPlato(0.0), streaming(true),
+                        interromper(nullptr), estado(nullptr), replanejamento(nullptr), prazoGeracao(0.0) {}
+};
+
+// Limites dos modos visual e servidor, a partir dos critérios de parada de Config
+LimitesExecucao limitesDaConfig();
+
+// Como a execução terminou
+enum DesfechoExecucao {
+    DESFECHO_INTERROMPIDO = 0, // pelo modo servidor (chegou comando)
+    DESFECHO_RESOLVIDO,        // SOLVED: parou com o alvo alcançado
+    DESFECHO_DESISTIU          // GAVE_UP: limite ou platô sem alcançar o alvo
+};
+
+// Medidas de uma execução (usadas pelo modo headless e pelo benchmark)
+struct ResultadoExecucao {
+    int geracoes;
+    long long avaliacoes;          // indivíduos simulados (total ou parcialmente), inclusive na busca local
+    double segundos;
+    int geracaoPrimeiraVitoria;    // -1 se nenhum indivíduo venceu
+    long long avaliacoesPrimeiraVitoria; // avaliações até ela (nas ilhas, até o fim da época); -1 sem vitória
+    double segundosPrimeiraVitoria;
+    int semeadosCache;             // indivíduos iniciais vindos do cache de soluções
+    int catastrofes;               // somadas de todas as ilhas no modelo de ilhas
+    int replanejamentos;           // mudanças de alvo/obstáculos aplicadas durante a execução
+    int prazosEstourados;          // gerações que passaram de LimitesExecucao::prazoGeracao
+    DesfechoExecucao desfecho;
+
+    ResultadoExecucao() : geracoes(0), avaliacoes(0), segundos(0.0),
+                          geracaoPrimeiraVitoria(-1), avaliacoesPrimeiraVitoria(-1), segundosPrimeiraVitoria(-1.0), semeadosCache(0),
+                          catastrofes(0), replanejamentos(0), prazosEstourados(0), desfecho(DESFECHO_INTERROMPIDO) {}
+};
+
+/// @brief Acompanha o melhor de uma execução para os critérios de parada por convergência.
+struct ControleParada {
+    int geracaoAvanco = 0;        // última geração em que o melhor subiu
+    int geracaoPlato = 0;         // última geração em que subiu mais que toleranciaPlato
+    double fitnessPlato = -1e18;  // melhor naquela geração
+
+    void observar(int geracao, bool melhorou, double fitness, double toleranciaPlato) {
+        if (melhorou) geracaoAvanco = geracao;
+        if (fitness > fitnessPlato + toleranciaPlato) {
+            fitnessPlato = fitness;
+            geracaoPlato = geracao;
+        }
+    }
+
+    /// @brief Verifica todos os limites depois da geração 'geracao' (já contada em res.geracoes).
+    /// @param venceu Se o melhor da execução alcança o alvo.
+    /// @param desfecho Recebe como a execução terminou (DESFECHO_INTERROMPIDO se foi por comando).
+    /// @return true se a execução deve parar.
+    bool deveParar(const LimitesExecucao& lim, const ResultadoExecucao& res, int geracao, double segundos,
+                   bool venceu, DesfechoExecucao& desfecho) const {
+        desfecho = venceu ? DESFECHO_RESOLVIDO : DESFECHO_DESISTIU;
+        if (lim.pararNaVitoria && venceu) return true;
+        if (lim.geracoesAposVitoria > 0 && venceu && geracao - geracaoAvanco >= lim.geracoesAposVitoria) return true;
+        if (lim.geracoesPlato > 0 && geracao - geracaoPlato >= lim.geracoesPlato) return true;
+        if (lim.maxGeracoes > 0 && res.geracoes >= lim.maxGeracoes) return true;
+        if (lim.maxAvaliacoes > 0 && res.avaliacoes >= lim.maxAvaliacoes) return true;
+        if (lim.maxSegundos > 0 && segundos >= lim.maxSegundos) return true;
+        desfecho = DESFECHO_INTERROMPIDO;
+        return lim.interromper && lim.interromper->load();
+    }
+};
+
+// Melhor indivíduo encontrado na execução atual
+extern Individuo melhorGeral;
+
+// Tamanho da próxima geração (menor que a capacidade só com Config::_pop = "_pop_adaptativa")
+int tamanhoAdaptativo(const Populacao& pop, const EstadoEvolutivo& est);
+
+struct ContextoEvolutivo;
+
+// O que avaliarGeracao encontrou
+struct GeracaoAvaliada {
+    double mediaFitness;
+    bool melhorou;        // o melhor da execução mudou (genoma copiado e reavaliado)
+    bool primeiraVitoria; // o melhor alcançou o alvo pela primeira vez nesta geração
+};
+
+/// @brief Primeira metade de uma geração do laço de população única, comum a executarEvolucao
+/// e ao modo lote (Planejador.cpp): avaliação, busca local, melhor da execução, estagnação,
+/// observação da parada e registro da primeira vitória (res.geracoes inclui esta geração).
+/// Streaming, cache e checkpoint ficam com quem chama, entre esta e fecharGeracao.
+GeracaoAvaliada avaliarGeracao(Populacao& pop, Ponto alvo, EstadoEvolutivo& est, ControleParada& parada,
+                               ResultadoExecucao& res, Individuo& melhor, double toleranciaPlato,
+                               std::chrono::steady_clock::time_point inicio, ContextoEvolutivo& ctx);
+
+/// @brief Segunda metade da geração: catástrofe (com a estagnação acima de minEstagCat) e
+/// seleção da próxima, de no máximo 'tamanhoMaximo' indivíduos; avança est.geracao.
+void fecharGeracao(Populacao& pop, Populacao& proxima, Ponto alvo, EstadoEvolutivo& est, ResultadoExecucao& res,
+                   int tamanhoMaximo, ContextoEvolutivo& ctx);
+
+ResultadoExecucao executarEvolucao(Ponto alvo, const LimitesExecucao& lim, bool aquecer = false);
+
+#endif
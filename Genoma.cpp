@@ -0,0 +1,128 @@
+#include "Genoma.h"
+#include "Config.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+ModeloGenoma modeloGenoma;
+
+/// @brief Pesos das funções de base não nulas no parâmetro t (algoritmo de Cox–de Boor).
+///
+/// Nós presos: grau + 1 zeros, os internos uniformes em (0, 1) e grau + 1 uns, então a curva
+/// começa no primeiro controle e termina no último.
+///
+/// @param n Quantidade de controles.
+/// @param grau Grau da curva (< n).
+/// @param t Parâmetro em [0, 1].
+/// @param pesos Recebe grau + 1 pesos, do controle 'primeiro' em diante.
+/// @return O primeiro controle com peso.
+static int baseSpline(int n, int grau, double t, double* pesos) {
+    int trechos = n - grau;
+    auto no = [&](int k) { return k <= grau ? 0.0 : (k >= n ? 1.0 : (double)(k - grau) / trechos); };
+    int s = t >= 1.0 ? n - 1 : min(n - 1, grau + (int)(t * trechos));
+
+    double esquerda[GRAU_SPLINE + 1], direita[GRAU_SPLINE + 1];
+    pesos[0] = 1.0;
+    for (int j = 1; j <= grau; j++) {
+        esquerda[j] = t - no(s + 1 - j);
+        direita[j] = no(s + j) - t;
+        double guardado = 0.0;
+        for (int r = 0; r < j; r++) {
+            double temp = pesos[r] / (direita[r + 1] + esquerda[j - r]);
+            pesos[r] = guardado + direita[r + 1] * temp;
+            guardado = esquerda[j - r] * temp;
+        }
+        pesos[j] = guardado;
+    }
+    return s - grau;
+}
+
+/// @brief Tabela de pesos por passo, primeiro passo de cada controle e o fator de Cholesky
+/// de BᵀB (B = matriz passos x controles), usado pelo ajuste das sementes.
+void montarGenoma() {
+    ModeloGenoma& m = modeloGenoma;
+    m.spline = c._gen == "_gen_spline";
+    m.nWaypoints = c.nWaypoints;
+    m.nControles = c.nGenes;
+    if (!m.spline) return;
+
+    int n = m.nControles, passos = m.nWaypoints;
+    int grau = min(GRAU_SPLINE, n - 1);
+    m.ordem = grau + 1;
+    m.primeiroControle.assign(passos, 0);
+    m.pesos.assign((size_t)passos * m.ordem, 0.0);
+    m.primeiroPasso.assign(n, passos);
+
+    // O passo 0 é a pose inicial: fica com pesos nulos
+    for (int i = 1; i < passos; i++) {
+        double t = passos > 2 ? (double)(i - 1) / (passos - 2) : 0.0;
+        double* w = m.pesos.data() + (size_t)i * m.ordem;
+        int primeiro = baseSpline(n, grau, t, w);
+        m.primeiroControle[i] = primeiro;
+        for (int k = 0; k < m.ordem; k++)
+            if (w[k] > 0.0 && m.primeiroPasso[primeiro + k] == passos) m.primeiroPasso[primeiro + k] = i;
+    }
+
+    // BᵀB (banda de largura 'ordem') e o seu fator de Cholesky, com um resíduo na diagonal
+    // para o caso de algum controle quase não pesar em passo nenhum
+    vector<double>& l = m.cholesky;
+    l.assign((size_t)n * n, 0.0);
+    for (int i = 1; i < passos; i++) {
+        const double* w = m.pesos.data() + (size_t)i * m.ordem;
+        int primeiro = m.primeiroControle[i];
+        for (int a = 0; a < m.ordem; a++)
+            for (int b = 0; b <= a; b++) l[(size_t)(primeiro + a) * n + primeiro + b] += w[a] * w[b];
+    }
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b <= a; b++) {
+            double soma = l[(size_t)a * n + b];
+            for (int k = 0; k < b; k++) soma -= l[(size_t)a * n + k] * l[(size_t)b * n + k];
+            l[(size_t)a * n + b] = a == b ? sqrt(max(soma, 0.0) + 1e-12) : soma / l[(size_t)b * n + b];
+        }
+    }
+}
+
+int primeiroPassoDoGene(int gene) {
+    const ModeloGenoma& m = modeloGenoma;
+    if (!m.spline) return gene;
+    return gene >= m.nControles ? m.nWaypoints : m.primeiroPasso[gene];
+}
+
+int primeiroGeneUsado() {
+    return modeloGenoma.spline ? 0 : 1;
+}
+
+int genesAtePasso(int passo) {
+    const ModeloGenoma& m = modeloGenoma;
+    if (!m.spline) return min(passo + 1, c.nGenes);
+    passo = max(1, min(passo, m.nWaypoints - 1));
+    return min(m.primeiroControle[passo] + m.ordem, m.nControles);
+}
+
+/// @brief Mínimos quadrados por junta: BᵀB x = Bᵀ v, resolvido com o fator de montarGenoma.
+void ajustarControles(const double* velocidades, double* genoma) {
+    const ModeloGenoma& m = modeloGenoma;
+    int n = m.nControles;
+    const vector<double>& l = m.cholesky;
+    double x[MAX_CONTROLES];
+
+    for (int j = 0; j < c.nJuntas; j++) {
+        fill(x, x + n, 0.0);
+        for (int i = 1; i < m.nWaypoints; i++) {
+            const double* w = m.pesos.data() + (size_t)i * m.ordem;
+            double v = velocidades[(size_t)i * c.nJuntas + j];
+            for (int k = 0; k < m.ordem; k++) x[m.primeiroControle[i] + k] += w[k] * v;
+        }
+        // L y = Bᵀ v, depois Lᵀ x = y (no mesmo vetor)
+        for (int a = 0; a < n; a++) {
+            for (int k = 0; k < a; k++) x[a] -= l[(size_t)a * n + k] * x[k];
+            x[a] /= l[(size_t)a * n + a];
+        }
+        for (int a = n - 1; a >= 0; a--) {
+            for (int k = a + 1; k < n; k++) x[a] -= l[(size_t)k * n + a] * x[k];
+            x[a] /= l[(size_t)a * n + a];
+        }
+        for (int a = 0; a < n; a++) genoma[a * c.nJuntas + j] = max(-c.speed, min(c.speed, x[a]));
+    }
+}
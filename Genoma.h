@@ -0,0 +1,78 @@
+#ifndef GENOMA_H
+#define GENOMA_H
+
+#include "Types.h"
+#include <vector>
+
+// Maior quantidade de pontos de controle por junta (dimensiona os vetores de pilha)
+const int MAX_CONTROLES = 64;
+
+// Grau da B-spline das velocidades (cúbica); cada passo depende de até GRAU_SPLINE + 1 controles
+const int GRAU_SPLINE = 3;
+
+/// @brief Representação do genoma escolhida por Config::_gen.
+///
+///   _gen_vel:    uma velocidade por junta em cada waypoint (nGenes = nWaypoints; o gene 0
+///                não é aplicado, o passo i aplica o gene i).
+///   _gen_spline: nControles pontos de controle por junta (nGenes = nControles) de uma
+///                B-spline cúbica uniforme presa nas pontas; a velocidade do passo i é a
+///                curva no parâmetro t = (i - 1) / (nWaypoints - 2), expandida na hora por
+///                calcularFitness e pelo kernel em lote.
+///
+/// O genoma continua linear (controle g da junta j em genoma[g * nJuntas + j]), então
+/// cruzamento, mutação, cache de soluções e checkpoint não mudam. Os pesos da B-spline são
+/// não negativos e somam 1, então com os controles em [-speed, speed] as velocidades
+/// expandidas também ficam. Cada controle só pesa em um trecho de passos, o que mantém a
+/// reavaliação incremental: o filho é simulado a partir do primeiro passo em que o primeiro
+/// controle alterado pesa.
+struct ModeloGenoma {
+    bool spline;
+    int nWaypoints;
+    int nControles;
+    int ordem;                         // controles por passo (grau + 1, menos se nControles for pequeno)
+    std::vector<int> primeiroControle; // [nWaypoints]: primeiro controle com peso no passo
+    std::vector<double> pesos;         // [nWaypoints x ordem]
+    std::vector<int> primeiroPasso;    // [nControles]: primeiro passo em que o controle pesa
+    std::vector<double> cholesky;      // [nControles x nControles]: fator de BᵀB (ver ajustarControles)
+
+    ModeloGenoma() : spline(false), nWaypoints(0), nControles(0), ordem(0) {}
+};
+
+// Modelo usado por Robot.cpp, Lote.cpp e Evolution.cpp
+extern ModeloGenoma modeloGenoma;
+
+// Reconstrói o modelo a partir de Config (_gen, nWaypoints, nGenes); chamado a cada execução
+void montarGenoma();
+
+/// Velocidade da junta j no passo i com _gen_spline (soma na ordem dos controles).
+inline double velocidadeSpline(const double* genoma, int i, int j, int nJuntas) {
+    const ModeloGenoma& m = modeloGenoma;
+    const double* w = m.pesos.data() + (size_t)i * m.ordem;
+    const double* g = genoma + (size_t)m.primeiroControle[i] * nJuntas + j;
+    double v = 0.0;
+    for (int k = 0; k < m.ordem; k++) v += w[k] * g[k * nJuntas];
+    return v;
+}
+
+/// Velocidades das juntas no passo i: o próprio gene com _gen_vel, ou a expansão em 'destino'
+/// (nJuntas doubles) com _gen_spline.
+inline const double* velocidadeDoPasso(const double* genoma, int i, int nJuntas, double* destino) {
+    if (!modeloGenoma.spline) return genoma + (size_t)i * nJuntas;
+    for (int j = 0; j < nJuntas; j++) destino[j] = velocidadeSpline(genoma, i, j, nJuntas);
+    return destino;
+}
+
+// Primeiro passo da simulação que muda quando o gene 'gene' muda (nWaypoints se nenhum)
+int primeiroPassoDoGene(int gene);
+
+// Primeiro gene que a simulação usa (1 com _gen_vel, 0 com _gen_spline)
+int primeiroGeneUsado();
+
+// Genes que influenciam os passos até 'passo' (inclusive): os genes [0, retorno)
+int genesAtePasso(int passo);
+
+/// Controles cuja curva mais se aproxima (mínimos quadrados) das velocidades dadas por passo
+/// ([nWaypoints x nJuntas], linha 0 ignorada), limitados a [-speed, speed]. Só com _gen_spline.
+void ajustarControles(const double* velocidades, double* genoma);
+
+#endif
@@ -0,0 +1,187 @@
+#include "Ilhas.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Robot.h"
+#include "Metricas.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void CaixaPostal::preparar(int capacidade, int doublesPorGenoma) {
+    if (capacidade != this->capacidade || doublesPorGenoma != this->doublesPorGenoma) {
+        this->capacidade = capacidade;
+        this->doublesPorGenoma = doublesPorGenoma;
+        genomas.assign((size_t)capacidade * doublesPorGenoma, 0.0);
+        origens.assign(capacidade, 0);
+        publicadas.reset(new atomic<int>[capacidade > 0 ? capacidade : 1]);
+    }
+    esvaziar();
+}
+
+/// @brief Deposita uma cópia do genoma (chamada por qualquer ilha, sem trava).
+/// @return false se a caixa estiver cheia.
+bool CaixaPostal::depositar(int origem, const double* genoma) {
+    int vaga = reservadas.fetch_add(1, memory_order_relaxed);
+    if (vaga >= capacidade) return false;
+    copy(genoma, genoma + doublesPorGenoma, genomas.begin() + (size_t)vaga * doublesPorGenoma);
+    origens[vaga] = origem;
+    publicadas[vaga].store(1, memory_order_release);
+    return true;
+}
+
+void CaixaPostal::recolher(vector<int>& vagas) const {
+    vagas.clear();
+    int n = min(reservadas.load(memory_order_acquire), capacidade);
+    for (int v = 0; v < n; v++)
+        if (publicadas[v].load(memory_order_acquire)) vagas.push_back(v);
+    stable_sort(vagas.begin(), vagas.end(), [&](int a, int b) { return origens[a] < origens[b]; });
+}
+
+void CaixaPostal::esvaziar() {
+    for (int v = 0; v < capacidade; v++) publicadas[v].store(0, memory_order_relaxed);
+    reservadas.store(0, memory_order_release);
+}
+
+/// @brief Ilhas que recebem os emigrantes de 'ilha' nesta época.
+static void escolherDestinos(int ilha, int nIlhas, int epoca, vector<int>& destinos) {
+    destinos.clear();
+    if (nIlhas < 2) return;
+    if (c._mig == "_mig_total") {
+        for (int j = 0; j < nIlhas; j++)
+            if (j != ilha) destinos.push_back(j);
+    } else if (c._mig == "_mig_aleatoria") {
+        Gerador rng;
+        reposicionarGerador(rng, epoca, ilha, FLUXO_MIGRACAO);
+        int j = escolherIndiceDeLista(rng, nIlhas - 1);
+        destinos.push_back(j >= ilha ? j + 1 : j);
+    } else {
+        destinos.push_back((ilha + 1) % nIlhas);
+    }
+}
+
+void Arquipelago::iniciar(int nIlhas, int tamanhoIlha) {
+    bool mesmas = (int)ilhas.size() == nIlhas && nIlhas > 0 && ilhas[0]->pop.tamanho() == tamanhoIlha &&
+                  ilhas[0]->pop.nGenes == c.nGenes && ilhas[0]->pop.nJuntas == c.nJuntas;
+    if (!mesmas) {
+        ilhas.clear();
+        for (int i = 0; i < nIlhas; i++) {
+            ilhas.push_back(unique_ptr<Ilha>(new Ilha()));
+            Ilha& il = *ilhas.back();
+            il.indice = i;
+            il.ctx.pool = &il.poolLocal;
+            il.ctx.primeiroIndice = i * tamanhoIlha;
+            il.pop.redimensionar(tamanhoIlha, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+            il.proxima.redimensionar(tamanhoIlha, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+        }
+    }
+
+    int capacidade = (nIlhas - 1) * c.nMigrantes;
+    pool->emCadaTrabalhador([&](int id) {
+        for (int i = id; i < nIlhas; i += pool->tamanho()) {
+            Ilha& il = *ilhas[i];
+            il.est = EstadoEvolutivo();
+            il.est.ilha = i;
+            il.melhor = Individuo();
+            il.mediaFitness = 0.0;
+            il.geracaoVitoria = -1;
+            il.avaliacoes = 0;
+            il.catastrofes = 0;
+            il.caixa.preparar(capacidade, il.pop.doublesPorGenoma());
+            gerarPopulacaoInicial(il.pop, il.ctx);
+        }
+    });
+}
+
+/// @brief Envia cópias dos melhores da última geração avaliada para as ilhas de destino.
+void Arquipelago::emigrar(Ilha& il, int epoca) {
+    int n = min(c.nMigrantes, il.pop.tamanho());
+    if (n <= 0 || quantidade() < 2) return;
+    MedidorFase medidor(FASE_MIGRACAO);
+
+    vector<pair<double, int>>& ordem = il.ctx.ordemFitness;
+    ordem.resize(il.pop.tamanho());
+    for (int i = 0; i < il.pop.tamanho(); i++) ordem[i] = make_pair(il.pop.fitness[i], i);
+    partial_sort(ordem.begin(), ordem.begin() + n, ordem.end(), greater<pair<double, int>>());
+
+    vector<int>& alvos = destinos[il.indice % destinos.size()];
+    escolherDestinos(il.indice, quantidade(), epoca, alvos);
+    for (int destino : alvos)
+        for (int k = 0; k < n; k++) ilhas[destino]->caixa.depositar(il.indice, il.pop.genoma(ordem[k].second));
+}
+
+/// @brief Imigrantes da época anterior ocupam os últimos filhos (o 0 é a elite).
+void Arquipelago::receberImigrantes(Ilha& il) {
+    MedidorFase medidor(FASE_MIGRACAO);
+    static thread_local vector<int> vagas;
+    il.caixa.recolher(vagas);
+    for (int k = 0; k < (int)vagas.size() && k < il.pop.tamanho() - 1; k++) {
+        int i = il.pop.tamanho() - 1 - k;
+        const double* genoma = il.caixa.genoma(vagas[k]);
+        copy(genoma, genoma + il.pop.doublesPorGenoma(), il.pop.genoma(i));
+        il.pop.passoReavaliacao[i] = 1;
+        il.pop.linhasPrefixo[i] = 0;
+    }
+    il.caixa.esvaziar();
+}
+
+/// @brief As gerações de uma época em uma ilha: o mesmo laço de executarEvolucao, com a
+/// estagnação e a catástrofe da própria ilha.
+void Arquipelago::evoluirIlha(Ilha& il, Ponto alvo, int geracoes, int epoca) {
+    for (int g = 0; g < geracoes; g++) {
+        il.avaliacoes += avaliarPopulacao(il.pop, alvo, il.ctx);
+        il.avaliacoes += refinarMelhores(il.pop, alvo, il.est, il.ctx);
+
+        int idxMelhor = 0;
+        double soma = 0.0;
+        for (int i = 0; i < il.pop.tamanho(); i++) {
+            soma += il.pop.fitness[i];
+            if (il.pop.fitness[i] > il.pop.fitness[idxMelhor]) idxMelhor = i;
+        }
+        il.mediaFitness = soma / il.pop.tamanho();
+
+        double fitnessMelhor = il.pop.fitness[idxMelhor];
+        if (fitnessMelhor > il.melhor.fitness) {
+            extrairIndividuo(il.pop, idxMelhor, il.melhor);
+            alterarIncrementoDaMutacaoAtual(il.est, true);
+        } else if (abs(fitnessMelhor - il.melhor.fitness) < 0.5) {
+            il.est.estagAtual++;
+            if (il.est.estagAtual > c.minEstag) alterarIncrementoDaMutacaoAtual(il.est, false);
+        }
+        if (il.melhor.venceu && il.geracaoVitoria < 0) il.geracaoVitoria = il.est.geracao;
+
+        if (g == geracoes - 1) emigrar(il, epoca);
+
+        if (il.est.estagAtual > c.minEstagCat) {
+            alterarIncrementoDaMutacaoAtual(il.est, true);
+            realizarCatastrofe(il.pop, il.proxima, il.est, il.ctx);
+            swap(il.pop, il.proxima);
+            il.avaliacoes += avaliarPopulacao(il.pop, alvo, il.ctx);
+            il.catastrofes++;
+        }
+
+        realizarSelecao(il.pop, il.proxima, il.est, il.ctx);
+        swap(il.pop, il.proxima);
+        il.est.geracao++;
+    }
+}
+
+long long Arquipelago::evoluirEpoca(Ponto alvo, int geracoes, int epoca) {
+    long long antes = 0;
+    for (auto& il : ilhas) antes += il->avaliacoes;
+
+    // Duas passadas: a caixa de uma ilha só é recolhida depois que todas terminaram de
+    // depositar na época anterior, e ninguém deposita enquanto outra ilha recolhe
+    destinos.resize(pool->tamanho());
+    pool->emCadaTrabalhador([&](int id) {
+        if (c.fixarNucleos && id > 0) fixarThreadNoNucleo(id);
+        for (int i = id; i < quantidade(); i += pool->tamanho()) receberImigrantes(*ilhas[i]);
+    });
+    pool->emCadaTrabalhador([&](int id) {
+        for (int i = id; i < quantidade(); i += pool->tamanho()) evoluirIlha(*ilhas[i], alvo, geracoes, epoca);
+    });
+
+    long long depois = 0;
+    for (auto& il : ilhas) depois += il->avaliacoes;
+    return depois - antes;
+}
@@ -0,0 +1,92 @@
+#ifndef ILHAS_H
+#define ILHAS_H
+
+#include "Types.h"
+#include "Populacao.h"
+#include "Evolution.h"
+#include "Paralelo.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+
+/// @brief Caixa postal sem trava: várias ilhas depositam emigrantes, só a dona recolhe.
+///
+/// Cada remetente reserva uma vaga com fetch_add e publica o genoma com um store de
+/// liberação na vaga; nenhum remetente espera pelo outro. A dona só recolhe entre
+/// épocas, depois que todas as ilhas terminaram de depositar. Depósitos além da
+/// capacidade são descartados.
+class CaixaPostal {
+public:
+    CaixaPostal() : capacidade(0), doublesPorGenoma(0), reservadas(0) {}
+
+    void preparar(int capacidade, int doublesPorGenoma);
+    bool depositar(int origem, const double* genoma);
+
+    /// Vagas publicadas, ordenadas pela ilha de origem e, para a mesma origem, pela ordem
+    /// de envio (a ordem de chegada entre ilhas não altera o resultado).
+    void recolher(std::vector<int>& vagas) const;
+    const double* genoma(int vaga) const { return &genomas[(size_t)vaga * doublesPorGenoma]; }
+    void esvaziar();
+
+private:
+    int capacidade;
+    int doublesPorGenoma;
+    std::vector<double> genomas;
+    std::vector<int> origens;
+    std::unique_ptr<std::atomic<int>[]> publicadas;
+    std::atomic<int> reservadas;
+};
+
+/// @brief Uma sub-população do modelo de ilhas, com estado evolutivo próprio.
+///
+/// A estagnação e a agressividade da mutação (est) são da ilha: uma ilha presa sobe a
+/// mutação e sofre catástrofe sem mexer nas outras. O contexto tem um pool de tamanho 1,
+/// então todos os operadores rodam na thread que evolui a ilha.
+struct Ilha {
+    int indice;
+    Populacao pop, proxima;
+    EstadoEvolutivo est;
+    PoolDeThreads poolLocal;
+    ContextoEvolutivo ctx;
+    CaixaPostal caixa;
+
+    Individuo melhor;        // melhor indivíduo já visto na ilha
+    double mediaFitness;     // da última geração avaliada
+    int geracaoVitoria;      // primeira geração com um vencedor (-1 = nenhuma)
+    long long avaliacoes;
+    int catastrofes;
+
+    Ilha() : indice(0), poolLocal(1), mediaFitness(0.0), geracaoVitoria(-1), avaliacoes(0), catastrofes(0) {}
+};
+
+/// @brief Conjunto de ilhas que evoluem em paralelo e trocam os melhores a cada época.
+///
+/// Uma época são Config::intervaloMigracao gerações. Cada trabalhador do pool global
+/// fica com as ilhas i tais que i % nTrabalhadores == id (as threads do pool presas ao seu
+/// núcleo com Config::fixarNucleos; a que chama fica solta), então as ilhas não disputam nada durante a época. No fim dela
+/// cada ilha deposita cópias dos seus Config::nMigrantes melhores nas caixas postais das
+/// vizinhas (topologia Config::_mig); antes da próxima, em uma passada separada, os
+/// imigrantes substituem os últimos filhos (nunca a elite). Como cada ilha usa fluxos aleatórios próprios e lê a
+/// caixa em ordem fixa, o resultado não depende da quantidade de threads.
+class Arquipelago {
+public:
+    /// Recria as ilhas se a quantidade ou as dimensões mudaram e gera as populações iniciais.
+    void iniciar(int nIlhas, int tamanhoIlha);
+
+    int quantidade() const { return (int)ilhas.size(); }
+    Ilha& ilha(int i) { return *ilhas[i]; }
+
+    /// Evolui todas as ilhas por 'geracoes' gerações e faz a migração do fim da época.
+    /// @return Avaliações feitas na época.
+    long long evoluirEpoca(Ponto alvo, int geracoes, int epoca);
+
+private:
+    void receberImigrantes(Ilha& il);
+    void evoluirIlha(Ilha& il, Ponto alvo, int geracoes, int epoca);
+    void emigrar(Ilha& il, int epoca);
+
+    std::vector<std::unique_ptr<Ilha>> ilhas;
+    std::vector<std::vector<int>> destinos; // por trabalhador (evita alocar na época)
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "Lote.h"
+#include "Config.h"
+#include "Cena.h"
+#include "Braco.h"
+#include "Genoma.h"
+
+/// @brief Descobre o melhor conjunto de instruções suportado pela CPU em execução.
+NivelSimd detectarSimd() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#endif
+    return SIMD_ESCALAR;
+}
+
+/// @brief Aplica a preferência de Config::_simd, sem nunca passar do que a CPU suporta.
+NivelSimd escolherSimd() {
+    NivelSimd suportado = detectarSimd();
+    NivelSimd pedido = suportado;
+
+    if (c._simd == "_simd_esc") pedido = SIMD_ESCALAR;
+    else if (c._simd == "_simd_sse2") pedido = SIMD_SSE2;
+    else if (c._simd == "_simd_avx2") pedido = SIMD_AVX2;
+
+    return pedido < suportado ? pedido : suportado;
+}
+
+int larguraLote(NivelSimd nivel) {
+    switch (nivel) {
+        case SIMD_AVX2: return 4;
+        case SIMD_SSE2: return 2;
+        default: return 1;
+    }
+}
+
+const char* nomeSimd(NivelSimd nivel) {
+    switch (nivel) {
+        case SIMD_AVX2: return "AVX2";
+        case SIMD_SSE2: return "SSE2";
+        default: return "escalar";
+    }
+}
+
+/// @brief Copia de Config e da cena atual (ver montarCena) os parâmetros usados pelo kernel.
+/// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+ParametrosLote montarParametrosLote(Ponto alvo) {
+    ParametrosLote prm;
+    prm.nWaypoints = c.nWaypoints;
+    for (int k = 0; k < 3; k++) {
+        prm.poseInicial[k] = c.poseInicial[k];
+        prm.limiteMin[k] = c.baseLmin[k];
+        prm.limiteMax[k] = c.baseLmax[k];
+    }
+    prm.comprimentoUmero = braco.comprimentoUmero;
+    prm.comprimentoAntebraco = braco.comprimentoAntebraco;
+    for (int k = 0; k < 3; k++) prm.alcance[k] = braco.alcance[k];
+    prm.alvo = alvo;
+
+    // Cena de no máximo uma esfera: teste vetorial direto
+    prm.colisaoPorCena = !cena.caixas.empty() || cena.esferas.size() > 1;
+    prm.varredura = c.varreduraContinua;
+    prm.trigRapida = c._trig == "_trig_rapida";
+    prm.spline = modeloGenoma.spline;
+    prm.obstaculo = cena.esferas.empty() ? Obstaculo{0.0, 0.0, 0.0, 0.0} : cena.esferas[0];
+    return prm;
+}
+
+/// @brief Avalia até larguraLote(nivel) genomas de uma vez.
+///
+/// Lotes incompletos (n menor que a largura) repetem o último genoma nas lanes
+/// vazias (que escrevem os mesmos valores no mesmo cache) e descartam o resultado delas.
+///
+/// @param nivel Conjunto de instruções (deve ter vindo de escolherSimd()).
+/// @param prm Parâmetros do ambiente (ver montarParametrosLote).
+/// @param lanes As n lanes (genoma, cache de prefixo e passo inicial).
+/// @param n Quantidade de lanes (1 a larguraLote(nivel)).
+/// @param saida Recebe n avaliações.
+void avaliarLote(NivelSimd nivel, const ParametrosLote& prm, const LaneLote* lanes, int n, Avaliacao* saida) {
+    int largura = larguraLote(nivel);
+    LaneLote completas[LARGURA_MAXIMA_LOTE];
+    Avaliacao resultado[LARGURA_MAXIMA_LOTE];
+    for (int l = 0; l < largura; l++) completas[l] = lanes[l < n ? l : n - 1];
+
+    switch (nivel) {
+        case SIMD_AVX2: avaliarLoteAVX2(prm, completas, resultado); break;
+        case SIMD_SSE2: avaliarLoteSSE2(prm, completas, resultado); break;
+        default: avaliarLoteEscalar(prm, completas, resultado); break;
+    }
+    for (int l = 0; l < n; l++) saida[l] = resultado[l];
+}
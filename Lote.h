@@ -0,0 +1,74 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "Types.h"
+#include <vector>
+
+// Conjuntos de instruções suportados pelo kernel em lote
+enum NivelSimd {
+    SIMD_ESCALAR = 0, // 1 indivíduo por vez (std::sin/std::cos, bit a bit igual a calcularFitness)
+    SIMD_SSE2 = 1,    // 2 indivíduos por vez
+    SIMD_AVX2 = 2     // 4 indivíduos por vez
+};
+
+// Tamanho máximo de lote entre todos os níveis
+const int LARGURA_MAXIMA_LOTE = 4;
+
+// Erro relativo máximo garantido entre o fitness do lote SIMD e o de calcularFitness.
+// O seno/cosseno polinomial tem erro da ordem de 1e-16; acumulado em 100 waypoints
+// ele fica bem abaixo deste limite. Vitória e passo da vitória só diferem se a distância
+// ficar a menos de ~1e-12 do raio de vitória (0.2) ou do raio do obstáculo.
+const double TOLERANCIA_LOTE = 1e-9;
+
+// Parâmetros do ambiente lidos pelo kernel (copiados de Config antes de cada avaliação)
+struct ParametrosLote {
+    int nWaypoints;
+    double poseInicial[3];
+    double limiteMin[3];
+    double limiteMax[3];
+    // Braço clássico de 3 juntas (ModeloBraco::classico3R), o único suportado pelo kernel
+    double comprimentoUmero;
+    double comprimentoAntebraco;
+    double alcance[3];
+    Obstaculo obstaculo;
+    Ponto alvo;
+    // Cena com mais de uma esfera ou com caixas: a colisão de cada lane é feita por
+    // colisaoNoPasso (Robot.h) em vez do teste vetorial contra 'obstaculo'
+    bool colisaoPorCena;
+    // Teste contínuo entre waypoints (Config::varreduraContinua)
+    bool varredura;
+    // Seno e cosseno de sincosRapido (Config::_trig); nesse modo todos os níveis dão o
+    // mesmo resultado que calcularFitness
+    bool trigRapida;
+    // Genoma por pontos de controle (Config::_gen = "_gen_spline"): as velocidades de cada
+    // passo são expandidas por velocidadeSpline (Genoma.h), na mesma ordem de calcularFitness
+    bool spline;
+};
+
+// Campos de cada linha do cache de prefixo: pose (3 juntas), penalidade acumulada e
+// distância ao alvo, sempre no estado logo após o passo da linha (linha 0 = pose inicial)
+const int CAMPOS_PREFIXO = 5;
+
+// Uma lane do lote: genoma, cache de prefixo e passo a partir do qual simular
+struct LaneLote {
+    const double* genoma;
+    double* prefixo; // [nWaypoints x CAMPOS_PREFIXO]; linhas < inicio são lidas, as demais escritas
+    int inicio;      // primeiro passo a simular (1 = trajetória inteira)
+};
+
+NivelSimd detectarSimd();
+NivelSimd escolherSimd(); // aplica a preferência de Config::_simd sobre o detectado
+int larguraLote(NivelSimd nivel);
+const char* nomeSimd(NivelSimd nivel);
+
+ParametrosLote montarParametrosLote(Ponto alvo);
+
+/// Avalia de 1 a larguraLote(nivel) genomas ao mesmo tempo (um por lane).
+void avaliarLote(NivelSimd nivel, const ParametrosLote& prm, const LaneLote* lanes, int n, Avaliacao* saida);
+
+// Implementações por conjunto de instruções (cada uma em sua unidade de compilação)
+void avaliarLoteEscalar(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida);
+void avaliarLoteSSE2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida);
+void avaliarLoteAVX2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida);
+
+#endif
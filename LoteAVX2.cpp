@@ -0,0 +1,53 @@
+#include "LoteKernel.h"
+
+// Esta unidade é compilada com -mavx2 (ver makefile) e só é chamada quando a CPU suporta AVX2
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+namespace {
+
+// Operações sobre 4 doubles (AVX2)
+struct OpsAVX2 {
+    typedef __m256d V;
+    typedef __m256d M;
+    static const int LARGURA = 4;
+
+    static V repetir(double a) { return _mm256_set1_pd(a); }
+    static V carregar(const double* p) { return _mm256_loadu_pd(p); }
+    static void guardar(double* p, V a) { _mm256_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V raiz(V a) { return _mm256_sqrt_pd(a); }
+    static V truncar(V a) { return _mm256_round_pd(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static M menor(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static M maiorIgual(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static M igual(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static M e(M a, M b) { return _mm256_and_pd(a, b); }
+    static M eNao(M a, M b) { return _mm256_andnot_pd(b, a); }
+    static M ou(M a, M b) { return _mm256_or_pd(a, b); }
+    static M ouExclusivo(M a, M b) { return _mm256_xor_pd(a, b); }
+    static M todos() { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+    static int bits(M m) { return _mm256_movemask_pd(m); }
+    static V selecionar(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+    static void sincos(V x, V& s, V& c) { sincosPolinomial<OpsAVX2>(x, s, c); }
+};
+
+} // namespace
+
+void avaliarLoteAVX2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    avaliarLoteKernel<OpsAVX2>(prm, lanes, saida);
+}
+
+#else
+
+// Compilado sem AVX2: o despachante nunca escolhe este nível
+void avaliarLoteAVX2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    for (int l = 0; l < 4; l++) avaliarLoteEscalar(prm, lanes + l, saida + l);
+}
+
+#endif
@@ -0,0 +1,43 @@
+#include "LoteKernel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Operações "vetoriais" de largura 1: usam std::sin/std::cos (ou sincosRapido), então o
+// resultado é idêntico ao de calcularFitness
+struct OpsEscalar {
+    typedef double V;
+    typedef bool M;
+    static const int LARGURA = 1;
+
+    static V repetir(double a) { return a; }
+    static V carregar(const double* p) { return p[0]; }
+    static void guardar(double* p, V a) { p[0] = a; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V min(V a, V b) { return std::min(a, b); }
+    static V max(V a, V b) { return std::max(a, b); }
+    static V abs(V a) { return std::abs(a); }
+    static V raiz(V a) { return std::sqrt(a); }
+    static V truncar(V a) { return (double)(long long)a; } // só usado com valores pequenos (sincosRapidoLote)
+    static M menor(V a, V b) { return a < b; }
+    static M maiorIgual(V a, V b) { return a >= b; }
+    static M igual(V a, V b) { return a == b; }
+    static M e(M a, M b) { return a && b; }
+    static M eNao(M a, M b) { return a && !b; }
+    static M ou(M a, M b) { return a || b; }
+    static M ouExclusivo(M a, M b) { return a != b; }
+    static M todos() { return true; }
+    static int bits(M m) { return m ? 1 : 0; }
+    static V selecionar(M m, V a, V b) { return m ? a : b; }
+    static void sincos(V x, V& s, V& c) { s = std::sin(x); c = std::cos(x); }
+};
+
+} // namespace
+
+void avaliarLoteEscalar(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    avaliarLoteKernel<OpsEscalar>(prm, lanes, saida);
+}
@@ -0,0 +1,341 @@
+#ifndef LOTE_KERNEL_H
+#define LOTE_KERNEL_H
+
+// Kernel genérico da avaliação em lote. Este arquivo só deve ser incluído pelas
+// unidades LoteEscalar.cpp, LoteSSE2.cpp e LoteAVX2.cpp: cada uma define a sua
+// estrutura de operações vetoriais (S) e instancia o kernel compilada com as
+// flags do seu conjunto de instruções. Tudo aqui fica em namespace anônimo
+// para que cada unidade tenha sua própria cópia.
+
+#include "Lote.h"
+#include "Robot.h"
+#include "Genoma.h"
+#include "Trig.h"
+#include <cmath>
+
+namespace {
+
+/// @brief Seno e cosseno vetoriais por redução a [-pi/4, pi/4] e polinômios (Cephes).
+///
+/// Válido para |x| até alguns milhares de radianos; no kernel os ângulos ficam em [-2pi, 2pi].
+/// Erro da ordem de 1 ulp em relação a std::sin/std::cos.
+template <class S>
+inline void sincosPolinomial(typename S::V x, typename S::V& seno, typename S::V& cosseno) {
+    typedef typename S::V V;
+    typedef typename S::M M;
+
+    const V DP1 = S::repetir(7.85398125648498535156E-1);
+    const V DP2 = S::repetir(3.77489470793079817668E-8);
+    const V DP3 = S::repetir(2.69515142907905952645E-15);
+    const V QUATRO_SOBRE_PI = S::repetir(1.27323954473516268615);
+    const V zero = S::repetir(0.0), um = S::repetir(1.0), dois = S::repetir(2.0);
+    const V quatro = S::repetir(4.0), seis = S::repetir(6.0), oito = S::repetir(8.0);
+
+    V ax = S::abs(x);
+
+    // Octante (sempre par após o ajuste) e resto j = y mod 8
+    V y = S::truncar(S::mul(ax, QUATRO_SOBRE_PI));
+    V impar = S::sub(y, S::mul(dois, S::truncar(S::mul(y, S::repetir(0.5)))));
+    y = S::add(y, impar);
+    V j = S::sub(y, S::mul(oito, S::truncar(S::mul(y, S::repetir(0.125)))));
+
+    // Redução de Cody-Waite em três partes
+    V z = S::sub(S::sub(S::sub(ax, S::mul(y, DP1)), S::mul(y, DP2)), S::mul(y, DP3));
+    V zz = S::mul(z, z);
+
+    V ps = S::repetir(1.58962301576546568060E-10);
+    ps = S::add(S::mul(ps, zz), S::repetir(-2.50507477628578072866E-8));
+    ps = S::add(S::mul(ps, zz), S::repetir(2.75573136213857245213E-6));
+    ps = S::add(S::mul(ps, zz), S::repetir(-1.98412698295895385996E-4));
+    ps = S::add(S::mul(ps, zz), S::repetir(8.33333333332211858878E-3));
+    ps = S::add(S::mul(ps, zz), S::repetir(-1.66666666666666307295E-1));
+    V polySeno = S::add(z, S::mul(S::mul(z, zz), ps));
+
+    V pc = S::repetir(-1.13585365213876817300E-11);
+    pc = S::add(S::mul(pc, zz), S::repetir(2.08757008419747316778E-9));
+    pc = S::add(S::mul(pc, zz), S::repetir(-2.75573141792967388112E-7));
+    pc = S::add(S::mul(pc, zz), S::repetir(2.48015872888517045348E-5));
+    pc = S::add(S::mul(pc, zz), S::repetir(-1.38888888888730564116E-3));
+    pc = S::add(S::mul(pc, zz), S::repetir(4.16666666666665929218E-2));
+    V polyCosseno = S::add(S::sub(um, S::mul(S::repetir(0.5), zz)), S::mul(S::mul(zz, zz), pc));
+
+    // Octantes 2 e 6 trocam os polinômios
+    M troca = S::ou(S::igual(j, dois), S::igual(j, seis));
+    V s = S::selecionar(troca, polyCosseno, polySeno);
+    V co = S::selecionar(troca, polySeno, polyCosseno);
+
+    // Seno: negativo para x < 0 xor j >= 4. Cosseno (par em x): negativo para j = 2 ou 4
+    M jAlto = S::maiorIgual(j, quatro);
+    M xNeg = S::menor(x, zero);
+    M negSeno = S::ouExclusivo(jAlto, xNeg);
+    M negCosseno = S::ou(S::igual(j, dois), S::igual(j, quatro));
+
+    seno = S::selecionar(negSeno, S::sub(zero, s), s);
+    cosseno = S::selecionar(negCosseno, S::sub(zero, co), co);
+}
+
+/// @brief Versão vetorial de sincosRapido (Trig.h), com a mesma sequência de operações.
+template <class S>
+inline void sincosRapidoLote(typename S::V x, typename S::V& seno, typename S::V& cosseno) {
+    typedef typename S::V V;
+    typedef typename S::M M;
+
+    const V zero = S::repetir(0.0), um = S::repetir(1.0), dois = S::repetir(2.0);
+    const V tres = S::repetir(3.0), quatro = S::repetir(4.0);
+
+    V meio = S::selecionar(S::menor(x, zero), S::repetir(-0.5), S::repetir(0.5));
+    V q = S::truncar(S::add(S::mul(x, S::repetir(TRIG_DOIS_SOBRE_PI)), meio));
+    V r = S::sub(S::sub(x, S::mul(q, S::repetir(TRIG_PI_2_A))), S::mul(q, S::repetir(TRIG_PI_2_B)));
+    V n = S::sub(q, S::mul(quatro, S::truncar(S::mul(q, S::repetir(0.25)))));
+    n = S::selecionar(S::menor(n, zero), S::add(n, quatro), n);
+
+    V u = S::mul(r, r);
+    V ps = S::add(S::mul(u, S::repetir(TRIG_S4)), S::repetir(TRIG_S3));
+    ps = S::add(S::mul(u, ps), S::repetir(TRIG_S2));
+    ps = S::add(S::mul(u, ps), S::repetir(TRIG_S1));
+    ps = S::add(r, S::mul(S::mul(r, u), ps));
+    V pc = S::add(S::mul(u, S::repetir(TRIG_C4)), S::repetir(TRIG_C3));
+    pc = S::add(S::mul(u, pc), S::repetir(TRIG_C2));
+    pc = S::add(S::mul(u, pc), S::repetir(TRIG_C1));
+    pc = S::add(S::sub(um, S::mul(S::repetir(0.5), u)), S::mul(S::mul(u, u), pc));
+
+    M troca = S::ou(S::igual(n, um), S::igual(n, tres));
+    V s = S::selecionar(troca, pc, ps);
+    V c = S::selecionar(troca, ps, pc);
+    seno = S::selecionar(S::maiorIgual(n, dois), S::sub(zero, s), s);
+    cosseno = S::selecionar(S::ou(S::igual(n, um), S::igual(n, dois)), S::sub(zero, c), c);
+}
+
+/// @brief Versão vetorial de segmentoColideEsfera (mesma álgebra, sem desvios).
+template <class S>
+inline typename S::M segmentoColideEsferaLote(typename S::V p1x, typename S::V p1y, typename S::V p1z,
+                                               typename S::V p2x, typename S::V p2y, typename S::V p2z,
+                                               const Obstaculo& obs, typename S::V raio) {
+    typedef typename S::V V;
+    typedef typename S::M M;
+
+    V abx = S::sub(p2x, p1x), aby = S::sub(p2y, p1y), abz = S::sub(p2z, p1z);
+    V acx = S::sub(S::repetir(obs.x), p1x);
+    V acy = S::sub(S::repetir(obs.y), p1y);
+    V acz = S::sub(S::repetir(obs.z), p1z);
+
+    V dot = S::add(S::add(S::mul(abx, acx), S::mul(aby, acy)), S::mul(abz, acz));
+    V lenSq = S::add(S::add(S::mul(abx, abx), S::mul(aby, aby)), S::mul(abz, abz));
+
+    // Segmento degenerado: t = 0 (equivale ao t = -1 truncado da versão escalar)
+    M degenerado = S::igual(lenSq, S::repetir(0.0));
+    V t = S::selecionar(degenerado, S::repetir(0.0), S::div(dot, S::selecionar(degenerado, S::repetir(1.0), lenSq)));
+    t = S::max(S::repetir(0.0), S::min(S::repetir(1.0), t));
+
+    V dx = S::sub(S::add(p1x, S::mul(abx, t)), S::repetir(obs.x));
+    V dy = S::sub(S::add(p1y, S::mul(aby, t)), S::repetir(obs.y));
+    V dz = S::sub(S::add(p1z, S::mul(abz, t)), S::repetir(obs.z));
+    V dist = S::add(S::add(S::mul(dx, dx), S::mul(dy, dy)), S::mul(dz, dz));
+
+    return S::menor(dist, S::mul(raio, raio));
+}
+
+/// @brief Colisão pela cena completa (colisaoNoPasso, escalar) das lanes marcadas em 'lanesTestadas'.
+///
+/// Recebe as posições do cotovelo e da ponta já calculadas pelo kernel; as demais lanes
+/// ficam sem colisão.
+template <class S>
+inline typename S::M colisaoNoPassoLote(const typename S::V* poseAnt, const typename S::V* pose,
+                                        const typename S::V* cotovelo, const typename S::V* ponta,
+                                        typename S::M lanesTestadas) {
+    const int W = S::LARGURA;
+    double ant[3][W], atual[3][W], cot[3][W], pon[3][W], resultado[W];
+    for (int k = 0; k < 3; k++) {
+        S::guardar(ant[k], poseAnt[k]);
+        S::guardar(atual[k], pose[k]);
+        S::guardar(cot[k], cotovelo[k]);
+        S::guardar(pon[k], ponta[k]);
+    }
+    int bits = S::bits(lanesTestadas);
+    for (int l = 0; l < W; l++) {
+        resultado[l] = 0.0;
+        if (!(bits & (1 << l))) continue;
+        double a[3] = {ant[0][l], ant[1][l], ant[2][l]};
+        double b[3] = {atual[0][l], atual[1][l], atual[2][l]};
+        // Origens do braço clássico: base e ombro coincidem (ver ModeloBraco::classico3R)
+        Ponto origens[4] = {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0},
+                            {cot[0][l], cot[1][l], cot[2][l]}, {pon[0][l], pon[1][l], pon[2][l]}};
+        if (colisaoNoPasso(a, b, origens)) resultado[l] = 1.0;
+    }
+    return S::menor(S::repetir(0.5), S::carregar(resultado));
+}
+
+/// @brief Simula S::LARGURA indivíduos em passo travado, um por lane.
+///
+/// Reproduz calcularFitness: mesma ordem das somas de penalidade, mesma regra de
+/// vitória e mesmo teste de colisão. Lanes que já venceram continuam no laço com
+/// as contribuições mascaradas em zero; o laço termina quando todas venceram.
+///
+/// Cada lane pode começar em um passo diferente (LaneLote::inicio): o estado do passo
+/// anterior vem do cache de prefixo e a lane fica congelada até o laço chegar ao seu
+/// início. Como a penalidade retomada continua a mesma soma, o resultado é idêntico
+/// ao de simular a trajetória inteira.
+template <class S>
+void avaliarLoteKernel(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    typedef typename S::V V;
+    typedef typename S::M M;
+    const int W = S::LARGURA;
+
+    const V zero = S::repetir(0.0);
+    const V grausParaRad = S::repetir(M_PI / 180.0);
+    const V L1 = S::repetir(prm.comprimentoUmero);
+    const V L2 = S::repetir(prm.comprimentoAntebraco);
+    const V alvoX = S::repetir(prm.alvo.x), alvoY = S::repetir(prm.alvo.y), alvoZ = S::repetir(prm.alvo.z);
+
+    V limMin[3], limMax[3];
+    for (int k = 0; k < 3; k++) {
+        limMin[k] = S::repetir(prm.limiteMin[k]);
+        limMax[k] = S::repetir(prm.limiteMax[k]);
+    }
+
+    // Estado inicial de cada lane: pose inicial ou a linha (inicio - 1) do cache
+    double inicial[CAMPOS_PREFIXO][W];
+    double inicioLane[W];
+    int primeiroPasso = prm.nWaypoints;
+    for (int l = 0; l < W; l++) {
+        const LaneLote& lane = lanes[l];
+        if (lane.inicio <= 1 || !lane.prefixo) {
+            double linha0[CAMPOS_PREFIXO] = {prm.poseInicial[0], prm.poseInicial[1], prm.poseInicial[2], 0.0, 0.0};
+            for (int f = 0; f < CAMPOS_PREFIXO; f++) inicial[f][l] = linha0[f];
+            if (lane.prefixo) for (int f = 0; f < CAMPOS_PREFIXO; f++) lane.prefixo[f] = linha0[f];
+            inicioLane[l] = 1;
+        } else {
+            const double* linha = lane.prefixo + (lane.inicio - 1) * CAMPOS_PREFIXO;
+            for (int f = 0; f < CAMPOS_PREFIXO; f++) inicial[f][l] = linha[f];
+            inicioLane[l] = lane.inicio;
+        }
+        if ((int)inicioLane[l] < primeiroPasso) primeiroPasso = (int)inicioLane[l];
+    }
+
+    V pose[3] = {S::carregar(inicial[0]), S::carregar(inicial[1]), S::carregar(inicial[2])};
+    V penalidade = S::carregar(inicial[3]);
+    V distFinal = S::carregar(inicial[4]);
+    V inicio = S::carregar(inicioLane);
+    M ativo = S::todos();
+    int passoVitoria[W];
+    for (int l = 0; l < W; l++) passoVitoria[l] = 0;
+
+    double vel[W];
+    double linha[CAMPOS_PREFIXO][W];
+    for (int i = primeiroPasso; i < prm.nWaypoints; i++) {
+        // Lanes que ainda não chegaram ao seu passo inicial ficam congeladas
+        M iniciado = S::maiorIgual(S::repetir((double)i), inicio);
+        M efetivo = S::e(ativo, iniciado);
+
+        // Movimento com saturação nos limites das juntas
+        V poseAnt[3] = {pose[0], pose[1], pose[2]};
+        for (int k = 0; k < 3; k++) {
+            if (prm.spline) for (int l = 0; l < W; l++) vel[l] = velocidadeSpline(lanes[l].genoma, i, k, 3);
+            else for (int l = 0; l < W; l++) vel[l] = lanes[l].genoma[i * 3 + k];
+            V np = S::add(poseAnt[k], S::carregar(vel));
+            pose[k] = S::selecionar(iniciado, S::min(S::max(np, limMin[k]), limMax[k]), poseAnt[k]);
+        }
+
+        // Cinemática direta (senos e cossenos compartilhados com a colisão)
+        V angBase = S::mul(pose[0], grausParaRad);
+        V angOmbro = S::mul(pose[1], grausParaRad);
+        V angAbs = S::sub(angOmbro, S::mul(pose[2], grausParaRad));
+        V sb, cb, so, co, sa, ca;
+        if (prm.trigRapida) {
+            sincosRapidoLote<S>(angBase, sb, cb);
+            sincosRapidoLote<S>(angOmbro, so, co);
+            sincosRapidoLote<S>(angAbs, sa, ca);
+        } else {
+            S::sincos(angBase, sb, cb);
+            S::sincos(angOmbro, so, co);
+            S::sincos(angAbs, sa, ca);
+        }
+
+        V rCotovelo = S::mul(L1, co);
+        V zCotovelo = S::mul(L1, so);
+        V rTotal = S::add(rCotovelo, S::mul(L2, ca));
+        V zTotal = S::add(zCotovelo, S::mul(L2, sa));
+        V px = S::mul(rTotal, cb), py = S::mul(rTotal, sb), pz = zTotal;
+
+        V dx = S::sub(px, alvoX), dy = S::sub(py, alvoY), dz = S::sub(pz, alvoZ);
+        V dist = S::raiz(S::add(S::add(S::mul(dx, dx), S::mul(dy, dy)), S::mul(dz, dz)));
+
+        // Vitória: registra o passo e desliga a lane
+        M venceAgora = S::e(efetivo, S::menor(dist, S::repetir(0.2)));
+        int bitsVitoria = S::bits(venceAgora);
+        if (bitsVitoria) {
+            for (int l = 0; l < W; l++) if (bitsVitoria & (1 << l)) passoVitoria[l] = i;
+            ativo = S::eNao(ativo, venceAgora);
+            efetivo = S::eNao(efetivo, venceAgora);
+            if (!S::bits(ativo)) break;
+        }
+
+        // Penalidades (somadas na mesma ordem da versão escalar)
+        penalidade = S::add(penalidade, S::selecionar(efetivo, S::mul(dist, S::repetir(1.5)), zero));
+        distFinal = S::selecionar(efetivo, dist, distFinal);
+
+        V ex = S::mul(rCotovelo, cb), ey = S::mul(rCotovelo, sb), ez = zCotovelo;
+        V cotovelo[3] = {ex, ey, ez};
+        V ponta[3] = {px, py, pz};
+        M colisao;
+        if (prm.colisaoPorCena) {
+            colisao = colisaoNoPassoLote<S>(poseAnt, pose, cotovelo, ponta, efetivo);
+        } else {
+            V raio = S::repetir(prm.obstaculo.raio);
+            colisao = S::ou(segmentoColideEsferaLote<S>(zero, zero, zero, ex, ey, ez, prm.obstaculo, raio),
+                            segmentoColideEsferaLote<S>(ex, ey, ez, px, py, pz, prm.obstaculo, raio));
+            if (prm.varredura) {
+                // Só as lanes que passam perto da esfera durante o passo vão para o teste contínuo
+                // (mesma ordem de operações de deslocamentoMaximo)
+                V deslocamento = zero;
+                for (int k = 0; k < 3; k++)
+                    deslocamento = S::add(deslocamento, S::mul(S::mul(S::repetir(prm.alcance[k]),
+                                                                      S::abs(S::sub(pose[k], poseAnt[k]))), grausParaRad));
+                V raioAmpliado = S::add(raio, deslocamento);
+                M perto = S::ou(segmentoColideEsferaLote<S>(zero, zero, zero, ex, ey, ez, prm.obstaculo, raioAmpliado),
+                                segmentoColideEsferaLote<S>(ex, ey, ez, px, py, pz, prm.obstaculo, raioAmpliado));
+                M duvida = S::eNao(S::e(efetivo, perto), colisao);
+                if (S::bits(duvida)) colisao = S::ou(colisao, colisaoNoPassoLote<S>(poseAnt, pose, cotovelo, ponta, duvida));
+            }
+        }
+        penalidade = S::add(penalidade, S::selecionar(S::e(efetivo, colisao), S::repetir(2000.0), zero));
+
+        V movimento = zero;
+        for (int k = 0; k < 3; k++) movimento = S::add(movimento, S::abs(S::sub(pose[k], poseAnt[k])));
+        penalidade = S::add(penalidade, S::selecionar(efetivo, S::mul(movimento, S::repetir(0.1)), zero));
+
+        // Grava a linha i do cache das lanes que simularam este passo
+        int bitsEfetivo = S::bits(efetivo);
+        if (bitsEfetivo) {
+            S::guardar(linha[0], pose[0]);
+            S::guardar(linha[1], pose[1]);
+            S::guardar(linha[2], pose[2]);
+            S::guardar(linha[3], penalidade);
+            S::guardar(linha[4], dist);
+            for (int l = 0; l < W; l++) {
+                if (!(bitsEfetivo & (1 << l)) || !lanes[l].prefixo) continue;
+                double* destino = lanes[l].prefixo + i * CAMPOS_PREFIXO;
+                for (int f = 0; f < CAMPOS_PREFIXO; f++) destino[f] = linha[f][l];
+            }
+        }
+    }
+
+    double pen[W], dfin[W];
+    S::guardar(pen, penalidade);
+    S::guardar(dfin, distFinal);
+    for (int l = 0; l < W; l++) {
+        Avaliacao& av = saida[l];
+        av.venceu = passoVitoria[l] != 0;
+        av.passoVitoria = passoVitoria[l];
+        if (av.venceu) {
+            double bonusObjetivo = 1000.0 + (prm.nWaypoints - passoVitoria[l]) * 500.0;
+            av.fitness = bonusObjetivo - pen[l];
+        } else {
+            av.fitness = -pen[l] - dfin[l] * 2000;
+        }
+    }
+}
+
+} // namespace
+
+#endif
@@ -0,0 +1,53 @@
+#include "LoteKernel.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+
+namespace {
+
+// Operações sobre 2 doubles (SSE2). Sem SSE4.1, o truncamento passa por inteiros de
+// 32 bits (os ângulos do kernel são pequenos) e a seleção usa and/andnot/or.
+struct OpsSSE2 {
+    typedef __m128d V;
+    typedef __m128d M;
+    static const int LARGURA = 2;
+
+    static V repetir(double a) { return _mm_set1_pd(a); }
+    static V carregar(const double* p) { return _mm_loadu_pd(p); }
+    static void guardar(double* p, V a) { _mm_storeu_pd(p, a); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V raiz(V a) { return _mm_sqrt_pd(a); }
+    static V truncar(V a) { return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a)); }
+    static M menor(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static M maiorIgual(V a, V b) { return _mm_cmpge_pd(a, b); }
+    static M igual(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static M e(M a, M b) { return _mm_and_pd(a, b); }
+    static M eNao(M a, M b) { return _mm_andnot_pd(b, a); }
+    static M ou(M a, M b) { return _mm_or_pd(a, b); }
+    static M ouExclusivo(M a, M b) { return _mm_xor_pd(a, b); }
+    static M todos() { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+    static int bits(M m) { return _mm_movemask_pd(m); }
+    static V selecionar(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static void sincos(V x, V& s, V& c) { sincosPolinomial<OpsSSE2>(x, s, c); }
+};
+
+} // namespace
+
+void avaliarLoteSSE2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    avaliarLoteKernel<OpsSSE2>(prm, lanes, saida);
+}
+
+#else
+
+// Arquitetura sem SSE2: o despachante nunca escolhe este nível
+void avaliarLoteSSE2(const ParametrosLote& prm, const LaneLote* lanes, Avaliacao* saida) {
+    for (int l = 0; l < 2; l++) avaliarLoteEscalar(prm, lanes + l, saida + l);
+}
+
+#endif
@@ -0,0 +1,269 @@
+#include "MapaColisao.h"
+#include "Config.h"
+#include "Robot.h"
+#include "Braco.h"
+#include "CacheSolucoes.h"
+#include "Paralelo.h"
+#include "Arquivo.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+MapaColisao mapaColisao;
+
+// Maior grade aceita (células); acima disso o mapa fica desligado
+static const long long MAXIMO_CELULAS = 1LL << 24;
+
+// Iterações da bissecção da folga (precisão de teto / 2^16)
+static const int ITERACOES_FOLGA = 16;
+
+static const char MAGICA_MAPA[4] = {'B', 'R', 'M', 'C'};
+static const uint32_t VERSAO_MAPA = 1;
+
+MapaColisao::MapaColisao() : resolucao(0.0), inversoResolucao(0.0), raioCelula(0.0), teto(0.0), chave(0) {
+    for (int k = 0; k < 3; k++) {
+        n[k] = 0;
+        minimo[k] = 0.0;
+    }
+}
+
+void MapaColisao::descartar() {
+    folga.clear();
+    campo.clear();
+    chave = 0;
+}
+
+/// @brief Folga da pose: maior margem (até 'teto') com que bracoColide responde "livre",
+/// ou -1 se a pose colide. Devolve o lado livre da bissecção, então nunca superestima.
+static float medirFolga(const double* pose, double teto) {
+    if (!bracoColide(pose, teto)) return (float)teto;
+    if (bracoColide(pose, 0.0)) return -1.0f;
+    double lo = 0.0, hi = teto;
+    for (int it = 0; it < ITERACOES_FOLGA; it++) {
+        double meio = (lo + hi) / 2;
+        if (bracoColide(pose, meio)) hi = meio;
+        else lo = meio;
+    }
+    // O float pode arredondar para cima; o passo seguinte para baixo compensa
+    float f = (float)lo;
+    return (double)f > lo ? nextafterf(f, 0.0f) : f;
+}
+
+/// @brief Mede a folga do centro de todas as células, uma fatia de base por tarefa.
+///
+/// raioCelula é o deslocamento máximo de um ponto do braço entre o centro e o canto da
+/// célula; o teto cobre a maior margem que colisaoNoPasso pede (um passo de 'speed' graus
+/// em todas as juntas), já que folgas maiores não mudam nenhuma resposta.
+bool MapaColisao::construir(double resolucao) {
+    descartar();
+    if (braco.nJuntas != 3 || resolucao <= 0.0) return false;
+
+    long long total = 1;
+    for (int k = 0; k < 3; k++) {
+        minimo[k] = c.baseLmin[k];
+        n[k] = max(1, (int)ceil((c.baseLmax[k] - c.baseLmin[k]) / resolucao - 1e-9));
+        total *= n[k];
+    }
+    if (total > MAXIMO_CELULAS) {
+        cerr << "AVISO mapa de colisao com " << total << " celulas (maximo " << MAXIMO_CELULAS
+             << "); aumente resolucaoMapa" << endl;
+        return false;
+    }
+    this->resolucao = resolucao;
+    inversoResolucao = 1.0 / resolucao;
+
+    double meia[3] = {resolucao / 2, resolucao / 2, resolucao / 2};
+    double zero[3] = {0.0, 0.0, 0.0};
+    double passo[3] = {c.speed, c.speed, c.speed};
+    raioCelula = deslocamentoMaximo(zero, meia);
+    teto = raioCelula + deslocamentoMaximo(zero, passo) + c.toleranciaVarredura;
+
+    vector<float> medidas((size_t)total);
+    int fatia = n[1] * n[2];
+    ::pool->paraCada(n[0], [&](int i0, int) {
+        double pose[3];
+        pose[0] = minimo[0] + (i0 + 0.5) * resolucao;
+        for (int i1 = 0; i1 < n[1]; i1++) {
+            pose[1] = minimo[1] + (i1 + 0.5) * resolucao;
+            for (int i2 = 0; i2 < n[2]; i2++) {
+                pose[2] = minimo[2] + (i2 + 0.5) * resolucao;
+                medidas[(size_t)i0 * fatia + i1 * n[2] + i2] = medirFolga(pose, teto);
+            }
+        }
+    });
+    folga.swap(medidas);
+    calcularCampo();
+    chave = chaveMapaColisao();
+    return true;
+}
+
+// Distância ao quadrado tratada como infinita (finita para não gerar inf - inf)
+static const double INFINITO_CAMPO = 1e20;
+
+/// @brief Transformada de distância euclidiana ao quadrado em uma linha (Felzenszwalb e
+/// Huttenlocher): envelope inferior das parábolas centradas em cada célula.
+static void transformada1D(const double* f, int n, double* d, int* v, double* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INFINITO_CAMPO;
+    z[1] = INFINITO_CAMPO;
+    for (int q = 1; q < n; q++) {
+        // z[0] = -infinito encerra o laço: com f limitado a INFINITO_CAMPO, s é sempre maior
+        double s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INFINITO_CAMPO;
+    }
+    k = 0;
+    for (int q = 0; q < n; q++) {
+        while (z[k + 1] < q) k++;
+        double dq = q - v[k];
+        d[q] = dq * dq + f[v[k]];
+    }
+}
+
+/// @brief Campo de distância: a transformada 1D aplicada em cada eixo, uma linha por tarefa.
+void MapaColisao::calcularCampo() {
+    size_t total = folga.size();
+    vector<double> quadrado(total);
+    for (size_t i = 0; i < total; i++) quadrado[i] = folga[i] < 0.0f ? 0.0 : INFINITO_CAMPO;
+
+    const int passo[3] = {n[1] * n[2], n[2], 1};
+    for (int eixo = 2; eixo >= 0; eixo--) {
+        int a = eixo == 0 ? 1 : 0, b = eixo == 2 ? 1 : 2; // os outros dois eixos
+        int linhas = n[a] * n[b], comprimento = n[eixo];
+        ::pool->paraCada(linhas, [&](int linha, int) {
+            static thread_local vector<double> f, d, z;
+            static thread_local vector<int> v;
+            if ((int)f.size() < comprimento + 1) {
+                f.resize(comprimento + 1);
+                d.resize(comprimento + 1);
+                z.resize(comprimento + 1);
+                v.resize(comprimento + 1);
+            }
+            size_t inicio = (size_t)(linha / n[b]) * passo[a] + (size_t)(linha % n[b]) * passo[b];
+            for (int q = 0; q < comprimento; q++) f[q] = quadrado[inicio + (size_t)q * passo[eixo]];
+            transformada1D(f.data(), comprimento, d.data(), v.data(), z.data());
+            for (int q = 0; q < comprimento; q++) quadrado[inicio + (size_t)q * passo[eixo]] = d[q];
+        });
+    }
+
+    campo.resize(total);
+    for (size_t i = 0; i < total; i++)
+        campo[i] = quadrado[i] >= INFINITO_CAMPO / 2 ? numeric_limits<float>::infinity()
+                                                     : (float)(sqrt(quadrado[i]) * resolucao);
+}
+
+// Cabeçalho do arquivo do mapa
+struct CabecalhoMapa {
+    char magica[4];
+    uint32_t versao;
+    uint64_t chave;
+    int32_t n[3];
+    int32_t reservado;
+    double minimo[3];
+    double resolucao;
+    double raioCelula;
+    double teto;
+};
+
+/// @brief Grava o mapa com gravarArquivoAtomico, para que um processo morto no meio da
+/// escrita não deixe um mapa pela metade.
+bool MapaColisao::salvar(const string& caminho) const {
+    if (!pronto()) return false;
+    CabecalhoMapa cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magica, MAGICA_MAPA, 4);
+    cab.versao = VERSAO_MAPA;
+    cab.chave = chave;
+    for (int k = 0; k < 3; k++) {
+        cab.n[k] = n[k];
+        cab.minimo[k] = minimo[k];
+    }
+    cab.resolucao = resolucao;
+    cab.raioCelula = raioCelula;
+    cab.teto = teto;
+
+    return gravarArquivoAtomico(caminho, {{&cab, sizeof(cab)},
+                                          {folga.data(), folga.size() * sizeof(float)},
+                                          {campo.data(), campo.size() * sizeof(float)}});
+}
+
+bool MapaColisao::carregar(const string& caminho, uint64_t chaveEsperada) {
+    ifstream arquivo(caminho.c_str(), ios::binary);
+    if (!arquivo) return false;
+    CabecalhoMapa cab;
+    if (!arquivo.read(reinterpret_cast<char*>(&cab), sizeof(cab))) return false;
+    if (memcmp(cab.magica, MAGICA_MAPA, 4) != 0 || cab.versao != VERSAO_MAPA || cab.chave != chaveEsperada) return false;
+
+    long long total = 1;
+    for (int k = 0; k < 3; k++) {
+        if (cab.n[k] <= 0) return false;
+        total *= cab.n[k];
+    }
+    if (total > MAXIMO_CELULAS || cab.resolucao <= 0.0) return false;
+
+    vector<float> f((size_t)total), d((size_t)total);
+    if (!arquivo.read(reinterpret_cast<char*>(f.data()), total * sizeof(float))) return false;
+    if (!arquivo.read(reinterpret_cast<char*>(d.data()), total * sizeof(float))) return false;
+
+    for (int k = 0; k < 3; k++) {
+        n[k] = cab.n[k];
+        minimo[k] = cab.minimo[k];
+    }
+    resolucao = cab.resolucao;
+    inversoResolucao = 1.0 / resolucao;
+    raioCelula = cab.raioCelula;
+    teto = cab.teto;
+    chave = cab.chave;
+    folga.swap(f);
+    campo.swap(d);
+    return true;
+}
+
+bool MapaColisao::exportarCampo(const string& caminho) const {
+    if (!pronto()) return false;
+    ofstream arquivo(caminho.c_str(), ios::binary | ios::trunc);
+    if (!arquivo) return false;
+    // Cabeçalho legível: dimensões, mínimo de cada junta e resolução (graus); depois os f32
+    arquivo << "CAMPO_COLISAO " << n[0] << " " << n[1] << " " << n[2] << " "
+            << minimo[0] << " " << minimo[1] << " " << minimo[2] << " " << resolucao << "\n";
+    arquivo.write(reinterpret_cast<const char*>(campo.data()), campo.size() * sizeof(float));
+    return (bool)arquivo;
+}
+
+/// @brief Assinatura do cenário (CacheSolucoes.h) misturada com a resolução e a tolerância
+/// da varredura (que entra no teto).
+uint64_t chaveMapaColisao() {
+    uint64_t h = assinaturaCenario();
+    double extras[2] = {c.resolucaoMapa, c.toleranciaVarredura};
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(extras);
+    for (size_t i = 0; i < sizeof(extras); i++) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void prepararMapaColisao() {
+    if (c._mapa != "_mapa_on" || braco.nJuntas != 3) {
+        mapaColisao.descartar();
+        return;
+    }
+    uint64_t chave = chaveMapaColisao();
+    if (mapaColisao.pronto() && mapaColisao.chaveAtual() == chave) return;
+    if (!c.arquivoMapa.empty() && mapaColisao.carregar(c.arquivoMapa, chave)) return;
+    if (!mapaColisao.construir(c.resolucaoMapa)) return;
+    if (!c.arquivoMapa.empty() && !mapaColisao.salvar(c.arquivoMapa))
+        cerr << "AVISO mapa de colisao nao gravado em " << c.arquivoMapa << endl;
+}
@@ -0,0 +1,94 @@
+#ifndef MAPA_COLISAO_H
+#define MAPA_COLISAO_H
+
+#include "Types.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/// @brief Mapa de colisão no espaço de configurações (base, ombro, cotovelo) do braço de 3 juntas.
+///
+/// A grade cobre Config::baseLmin..baseLmax com células de 'resolucao' graus. Cada célula
+/// guarda a folga da pose do seu centro: a maior margem com que bracoColide ainda responde
+/// "livre" (achada por bissecção, limitada por um teto), ou -1 se o centro colide. Dentro de
+/// uma célula nenhum ponto do braço fica a mais de raioCelula (ver deslocamentoMaximo) da
+/// posição que ele tem no centro, então uma pose da célula está livre com folga 'margem'
+/// sempre que folga - raioCelula > margem. livre() responde só esse caso; perto das
+/// fronteiras (e dentro dos obstáculos) quem chama faz o teste exato. Por isso o mapa nunca
+/// muda uma resposta de colisão, só evita a geometria.
+///
+/// O mapa também guarda um campo de distância no espaço das juntas: para cada célula, a
+/// distância euclidiana (em graus) até o centro da célula colidente mais próxima (transformada
+/// de distância exata, separável por eixo), exportável para uso como penalidade suave.
+///
+/// Arquivo (little-endian): "BRMC", versão u32, chave u64, n[3] i32, mínimo[3] f64,
+/// resolução f64, raioCelula f64, teto f64, seguido de folga e campo (n0*n1*n2 f32 cada,
+/// com o cotovelo variando mais rápido). A chave resume a cena, o braço, os limites e a
+/// resolução; um arquivo com outra chave é reconstruído.
+class MapaColisao {
+public:
+    MapaColisao();
+
+    // Constrói (em paralelo, no pool global) para a cena e o braço atuais. false se o braço
+    // não tiver 3 juntas ou a grade passar do tamanho máximo.
+    bool construir(double resolucao);
+    bool carregar(const std::string& caminho, uint64_t chaveEsperada);
+    bool salvar(const std::string& caminho) const;
+    void descartar();
+
+    bool pronto() const { return !folga.empty(); }
+    uint64_t chaveAtual() const { return chave; }
+    int celulas() const { return (int)folga.size(); }
+
+    // true = a pose está certamente a mais de 'margem' de todos os obstáculos (false fora da grade)
+    bool livre(const double* pose, double margem) const {
+        int i = indice(pose, true);
+        return i >= 0 && folga[i] - raioCelula > margem + FOLGA_NUMERICA;
+    }
+
+    // Distância (graus, no espaço das juntas) até a configuração colidente mais próxima; infinito sem nenhuma
+    double distancia(const double* pose) const { return campo[indice(pose, false)]; }
+
+    // Grava o campo de distância (cabeçalho em texto seguido de n0*n1*n2 f32)
+    bool exportarCampo(const std::string& caminho) const;
+
+private:
+    // Cobre arredondamentos de float e a diferença entre std::sin e o polinômio do lote
+    static constexpr double FOLGA_NUMERICA = 1e-5;
+
+    // Célula da pose; fora da grade, -1 (estrito) ou a célula da borda mais próxima. A pose
+    // exatamente no limite superior cai na última célula, a meia célula do centro
+    int indice(const double* pose, bool estrito) const {
+        int id = 0;
+        for (int k = 0; k < 3; k++) {
+            double t = (pose[k] - minimo[k]) * inversoResolucao;
+            if (estrito && !(t >= 0.0 && t <= n[k])) return -1;
+            int i = t <= 0.0 ? 0 : (t >= n[k] ? n[k] - 1 : (int)t);
+            id = id * n[k] + i;
+        }
+        return id;
+    }
+
+    void calcularCampo();
+
+    int n[3];
+    double minimo[3];
+    double resolucao, inversoResolucao;
+    double raioCelula;
+    double teto; // folga máxima medida (maior margem pedida por um passo + raioCelula)
+    uint64_t chave;
+    std::vector<float> folga;
+    std::vector<float> campo;
+};
+
+// Mapa usado por colisaoNoPasso e verificarColisao (vazio com _mapa_off)
+extern MapaColisao mapaColisao;
+
+// Chave do mapa para a cena, o braço e a resolução atuais
+uint64_t chaveMapaColisao();
+
+// Garante o mapa da configuração atual (Config::_mapa): reusa o da memória, lê Config::arquivoMapa
+// ou constrói e grava. Com _mapa_off, ou braço sem 3 juntas, deixa o mapa vazio.
+void prepararMapaColisao();
+
+#endif
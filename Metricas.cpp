@@ -0,0 +1,205 @@
+#include "Metricas.h"
+#include <sstream>
+#include <iomanip>
+
+#if METRICAS
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TEM_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TEM_RDTSC 1
+#endif
+
+using namespace std;
+
+// Contadores de uma thread. Só a dona escreve (load + store relaxados, sem instrução
+// atômica de leitura-modificação-escrita); o retrato lê todos os blocos sem parar ninguém.
+struct BlocoMetricas {
+    atomic<unsigned long long> ticks[N_FASES];
+    atomic<unsigned long long> chamadas[N_FASES];
+    atomic<unsigned long long> latencia[BALDES_LATENCIA];
+    atomic<unsigned long long> alocacoes, bytesAlocados; // operator new desde zerarMetricas()
+    BlocoMetricas* proximo;
+    char enchimento[64]; // blocos vizinhos em linhas de cache diferentes
+};
+
+// Lista dos blocos, um por thread que já mediu ou alocou algo (nunca liberados). Os blocos
+// vêm do malloc e entram na lista por compare-exchange, sem trava nem operator new: o próprio
+// operator new registra o bloco da thread, e pode rodar antes dos construtores estáticos.
+static atomic<BlocoMetricas*> blocos(nullptr);
+
+static unsigned long long nanosDesdeInicio() {
+    return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief Relógio barato: contador de ciclos (rdtsc) em x86, steady_clock nos demais.
+static inline unsigned long long ticksAgora() {
+#ifdef TEM_RDTSC
+    return __rdtsc();
+#else
+    return nanosDesdeInicio();
+#endif
+}
+
+// Referência para converter ticks em nanossegundos (calibrada contra steady_clock)
+static unsigned long long ticksReferencia = ticksAgora();
+static unsigned long long nanosReferencia = nanosDesdeInicio();
+static unsigned long long nanosZerado = nanosReferencia;
+
+static double nanosPorTick() {
+#ifdef TEM_RDTSC
+    unsigned long long ticks = ticksAgora() - ticksReferencia;
+    unsigned long long nanos = nanosDesdeInicio() - nanosReferencia;
+    return ticks > 0 && nanos > 1000000 ? (double)nanos / (double)ticks : 1.0 / 3.0;
+#else
+    return 1.0;
+#endif
+}
+
+static BlocoMetricas& meuBloco() {
+    static thread_local BlocoMetricas* bloco = nullptr;
+    if (!bloco) {
+        void* memoria = calloc(1, sizeof(BlocoMetricas));
+        if (!memoria) abort();
+        BlocoMetricas* novo = new (memoria) BlocoMetricas();
+        novo->proximo = blocos.load(memory_order_relaxed);
+        while (!blocos.compare_exchange_weak(novo->proximo, novo, memory_order_release, memory_order_relaxed)) {}
+        bloco = novo;
+    }
+    return *bloco;
+}
+
+static inline void somar(atomic<unsigned long long>& contador, unsigned long long valor) {
+    contador.store(contador.load(memory_order_relaxed) + valor, memory_order_relaxed);
+}
+
+unsigned long long instanteMetrica() {
+    return ticksAgora();
+}
+
+void registrarFase(FaseMetrica fase, unsigned long long inicio) {
+    BlocoMetricas& b = meuBloco();
+    somar(b.ticks[fase], ticksAgora() - inicio);
+    somar(b.chamadas[fase], 1);
+}
+
+void registrarAvaliacao(unsigned long long inicio) {
+    unsigned long long decorrido = ticksAgora() - inicio;
+    BlocoMetricas& b = meuBloco();
+    somar(b.ticks[FASE_AVALIACAO], decorrido);
+    somar(b.chamadas[FASE_AVALIACAO], 1);
+
+    // Balde pela posição do bit mais alto dos nanossegundos (fator fixo por execução)
+    static thread_local double fator = 0.0;
+    if (fator == 0.0) fator = nanosPorTick();
+    unsigned long long ns = (unsigned long long)(decorrido * fator);
+    int balde = 0;
+    while (ns > 1 && balde < BALDES_LATENCIA - 1) { ns >>= 1; balde++; }
+    somar(b.latencia[balde], 1);
+}
+
+void zerarMetricas() {
+    for (BlocoMetricas* b = blocos.load(memory_order_acquire); b; b = b->proximo) {
+        for (int f = 0; f < N_FASES; f++) { b->ticks[f] = 0; b->chamadas[f] = 0; }
+        for (int k = 0; k < BALDES_LATENCIA; k++) b->latencia[k] = 0;
+        b->alocacoes = 0;
+        b->bytesAlocados = 0;
+    }
+    nanosZerado = nanosDesdeInicio();
+}
+
+/// @brief Limite superior (ns) do balde em que cai a fração 'p' das medições.
+static unsigned long long percentil(const unsigned long long* baldes, unsigned long long total, double p) {
+    if (total == 0) return 0;
+    unsigned long long acumulado = 0;
+    for (int k = 0; k < BALDES_LATENCIA; k++) {
+        acumulado += baldes[k];
+        if (acumulado >= p * total) return 2ULL << k;
+    }
+    return 2ULL << (BALDES_LATENCIA - 1);
+}
+
+string metricasJson() {
+    static const char* nomes[N_FASES] = {
+        "avaliacao", "selecao", "cruzamento", "mutacao", "catastrofe", "aquecimento", "migracao", "busca_local", "checkpoint", "streaming"
+    };
+
+    unsigned long long ticks[N_FASES] = {}, chamadas[N_FASES] = {}, latencia[BALDES_LATENCIA] = {};
+    unsigned long long alocacoes = 0, bytesAlocados = 0;
+    for (BlocoMetricas* b = blocos.load(memory_order_acquire); b; b = b->proximo) {
+        for (int f = 0; f < N_FASES; f++) {
+            ticks[f] += b->ticks[f].load(memory_order_relaxed);
+            chamadas[f] += b->chamadas[f].load(memory_order_relaxed);
+        }
+        for (int k = 0; k < BALDES_LATENCIA; k++) latencia[k] += b->latencia[k].load(memory_order_relaxed);
+        alocacoes += b->alocacoes.load(memory_order_relaxed);
+        bytesAlocados += b->bytesAlocados.load(memory_order_relaxed);
+    }
+    double fator = nanosPorTick();
+
+    ostringstream json;
+    json << fixed << setprecision(3);
+    json << "{\"segundos\":" << (nanosDesdeInicio() - nanosZerado) * 1e-9 << ",\"fases\":{";
+    for (int f = 0; f < N_FASES; f++) {
+        json << (f ? "," : "") << "\"" << nomes[f] << "\":{\"ms\":" << ticks[f] * fator * 1e-6
+             << ",\"chamadas\":" << chamadas[f] << "}";
+    }
+
+    // Baldes até o último não vazio
+    int ultimo = 0;
+    for (int k = 0; k < BALDES_LATENCIA; k++) if (latencia[k]) ultimo = k;
+    json << "},\"latencia_avaliacao_ns\":{\"baldes\":[";
+    for (int k = 0; k <= ultimo; k++) json << (k ? "," : "") << latencia[k];
+    json << "],\"p50\":" << percentil(latencia, chamadas[FASE_AVALIACAO], 0.50)
+         << ",\"p99\":" << percentil(latencia, chamadas[FASE_AVALIACAO], 0.99)
+         << "},\"alocacoes\":" << alocacoes << ",\"bytes_alocados\":" << bytesAlocados << "}";
+    return json.str();
+}
+
+unsigned long long alocacoesDesdeZerar() {
+    unsigned long long total = 0;
+    for (BlocoMetricas* b = blocos.load(memory_order_acquire); b; b = b->proximo)
+        total += b->alocacoes.load(memory_order_relaxed);
+    return total;
+}
+
+#ifndef METRICAS_SEM_NEW
+
+// Contagem de alocações: substitui o operator new global (as versões de array e sem exceção
+// da biblioteca padrão chamam esta). Fora da biblioteca compartilhada (METRICAS_SEM_NEW nos
+// objetos .pic.o), que não pode trocar o alocador do programa que a carrega.
+void* operator new(size_t tamanho) {
+    BlocoMetricas& b = meuBloco();
+    somar(b.alocacoes, 1);
+    somar(b.bytesAlocados, tamanho);
+    if (void* p = malloc(tamanho ? tamanho : 1)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+#endif
+
+#else
+
+void zerarMetricas() {}
+
+unsigned long long alocacoesDesdeZerar() {
+    return 0;
+}
+
+std::string metricasJson() {
+    return "{\"metricas\":false}";
+}
+
+#endif
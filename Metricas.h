@@ -0,0 +1,66 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <string>
+
+// Instrumentação dos pontos quentes. Ligada por padrão; `make METRICAS=0` compila todas as
+// chamadas abaixo como funções vazias (custo zero) e não substitui o operator new.
+// METRICAS_SEM_NEW (objetos da biblioteca) mede tudo menos as alocações.
+#ifndef METRICAS
+#define METRICAS 1
+#endif
+
+// Fases medidas. As marcadas com * são medidas dentro das tarefas paralelas, então o tempo é
+// a soma das threads; as demais são medidas na thread que chama a fase (tempo de parede).
+enum FaseMetrica {
+    FASE_AVALIACAO = 0, // * uma medição por tarefa (um indivíduo ou um lote SIMD)
+    FASE_SELECAO,       // * escolha dos pais (e a preparação da estratégia, uma vez por geração)
+    FASE_CRUZAMENTO,    // *
+    FASE_MUTACAO,       // *
+    FASE_CATASTROFE,
+    FASE_AQUECIMENTO,
+    FASE_MIGRACAO,
+    FASE_BUSCA_LOCAL,   // refinamento memético (a fase inteira; as avaliações dela não entram no histograma)
+    FASE_CHECKPOINT,    // gravação do checkpoint (Checkpoint.h)
+    FASE_STREAMING,     // mensagens ao simulador (Saida.cpp)
+    N_FASES
+};
+
+// Histograma da latência de avaliação por tarefa: o balde k conta as medições em [2^k, 2^(k+1)) ns
+const int BALDES_LATENCIA = 32;
+
+#if METRICAS
+
+unsigned long long instanteMetrica();
+void registrarFase(FaseMetrica fase, unsigned long long inicio);
+void registrarAvaliacao(unsigned long long inicio); // FASE_AVALIACAO + histograma
+
+#else
+
+inline unsigned long long instanteMetrica() { return 0; }
+inline void registrarFase(FaseMetrica, unsigned long long) {}
+inline void registrarAvaliacao(unsigned long long) {}
+
+#endif
+
+/// @brief Mede o escopo em que foi declarado como uma chamada da fase.
+struct MedidorFase {
+    FaseMetrica fase;
+    unsigned long long inicio;
+    explicit MedidorFase(FaseMetrica fase) : fase(fase), inicio(instanteMetrica()) {}
+    ~MedidorFase() { registrarFase(fase, inicio); }
+};
+
+// Zera contadores, histograma e alocações (no começo de cada execução)
+void zerarMetricas();
+
+// Chamadas do operator new (todas as threads) desde zerarMetricas(); 0 com METRICAS=0 e na
+// biblioteca compartilhada, que não substitui o operator new (METRICAS_SEM_NEW)
+unsigned long long alocacoesDesdeZerar();
+
+// Retrato atual em JSON, em uma linha: tempo e chamadas por fase, histograma e percentis da
+// latência de avaliação e alocações de memória desde zerarMetricas(). Com METRICAS=0 só
+// traz {"metricas":false}.
+std::string metricasJson();
+
+#endif
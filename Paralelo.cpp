@@ -0,0 +1,222 @@
+#include "Paralelo.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+PoolDeThreads* pool = nullptr;
+
+// Quantidade de índices que cada trabalhador pega de uma vez (reduz disputa no contador)
+static const int TAMANHO_BLOCO = 4;
+
+PoolDeThreads::PoolDeThreads(int nThreads)
+    : nTrabalhadores(nThreads < 1 ? 1 : nThreads), tarefaAtual(nullptr), totalAtual(0),
+      umPorTrabalhador(false), proximoIndice(0), ativos(0), loteAtual(0), encerrar(false) {
+    for (int id = 1; id < nTrabalhadores; id++)
+        threads.push_back(std::thread(&PoolDeThreads::loopTrabalhador, this, id));
+}
+
+PoolDeThreads::~PoolDeThreads() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        encerrar = true;
+    }
+    cvInicio.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+/// @brief Pega blocos de índices do contador compartilhado até esgotar o lote atual.
+/// @param id Identificador do trabalhador (repassado à tarefa para indexar estado por thread).
+void PoolDeThreads::consumirIndices(int id) {
+    while (true) {
+        int inicio = proximoIndice.fetch_add(TAMANHO_BLOCO);
+        if (inicio >= totalAtual) break;
+        int fim = std::min(inicio + TAMANHO_BLOCO, totalAtual);
+        for (int i = inicio; i < fim; i++) (*tarefaAtual)(i, id);
+    }
+}
+
+void PoolDeThreads::loopTrabalhador(int id) {
+    unsigned long long ultimoLote = 0;
+    while (true) {
+        bool umPorId;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cvInicio.wait(lock, [&] { return encerrar || loteAtual != ultimoLote; });
+            if (encerrar) return;
+            ultimoLote = loteAtual;
+            umPorId = umPorTrabalhador;
+        }
+
+        if (umPorId) (*tarefaAtual)(id, id);
+        else consumirIndices(id);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--ativos == 0) cvFim.notify_one();
+    }
+}
+
+void PoolDeThreads::paraCada(int n, const std::function<void(int, int)>& tarefa) {
+    if (n <= 0) return;
+
+    // Sem threads extras (ou trabalho pequeno demais): executa direto na thread atual
+    if (nTrabalhadores == 1 || n <= TAMANHO_BLOCO) {
+        for (int i = 0; i < n; i++) tarefa(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tarefaAtual = &tarefa;
+        totalAtual = n;
+        proximoIndice.store(0);
+        ativos = nTrabalhadores - 1;
+        loteAtual++;
+    }
+    cvInicio.notify_all();
+
+    consumirIndices(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cvFim.wait(lock, [&] { return ativos == 0; });
+    tarefaAtual = nullptr;
+}
+
+void PoolDeThreads::emCadaTrabalhador(const std::function<void(int)>& tarefa) {
+    if (nTrabalhadores == 1) {
+        tarefa(0);
+        return;
+    }
+
+    std::function<void(int, int)> porId = [&](int, int id) { tarefa(id); };
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        tarefaAtual = &porId;
+        totalAtual = nTrabalhadores;
+        umPorTrabalhador = true;
+        ativos = nTrabalhadores - 1;
+        loteAtual++;
+    }
+    cvInicio.notify_all();
+
+    tarefa(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    cvFim.wait(lock, [&] { return ativos == 0; });
+    tarefaAtual = nullptr;
+    umPorTrabalhador = false;
+}
+
+/// @brief Tira a próxima tarefa da própria fila.
+bool EscalonadorRoubo::pegar(int id, int& tarefa) {
+    Fila& f = filas[id];
+    std::lock_guard<std::mutex> lock(f.trava);
+    if (f.inicio >= f.fim) return false;
+    tarefa = f.inicio++;
+    return true;
+}
+
+/// @brief Passa para a fila (vazia) de 'id' a metade final da fila com mais tarefas.
+/// @return false se não sobrou tarefa em nenhuma fila.
+bool EscalonadorRoubo::roubar(int id) {
+    while (true) {
+        int vitima = -1, maior = 0;
+        for (int k = 1; k < nFilas; k++) {
+            int v = (id + k) % nFilas;
+            std::lock_guard<std::mutex> lock(filas[v].trava);
+            int restantes = filas[v].fim - filas[v].inicio;
+            if (restantes > maior) {
+                maior = restantes;
+                vitima = v;
+            }
+        }
+        if (vitima < 0) return false;
+
+        int inicio, fim;
+        {
+            Fila& f = filas[vitima];
+            std::lock_guard<std::mutex> lock(f.trava);
+            int restantes = f.fim - f.inicio;
+            if (restantes <= 0) continue; // esvaziou entre a escolha e o roubo
+            fim = f.fim;
+            inicio = fim - (restantes + 1) / 2;
+            f.fim = inicio;
+        }
+        // Enquanto o intervalo está só com o ladrão ninguém o vê; ele mesmo o executa
+        Fila& minha = filas[id];
+        std::lock_guard<std::mutex> lock(minha.trava);
+        minha.inicio = inicio;
+        minha.fim = fim;
+        totalRoubos++;
+        return true;
+    }
+}
+
+void EscalonadorRoubo::executar(PoolDeThreads& pool, int n, const std::function<void(int, int)>& tarefa) {
+    if (n <= 0) return;
+    if (nFilas != pool.tamanho()) {
+        nFilas = pool.tamanho();
+        filas.reset(new Fila[nFilas]);
+    }
+    for (int id = 0; id < nFilas; id++) {
+        filas[id].inicio = (int)((long long)n * id / nFilas);
+        filas[id].fim = (int)((long long)n * (id + 1) / nFilas);
+    }
+    totalRoubos.store(0);
+
+    pool.emCadaTrabalhador([&](int id) {
+        int t;
+        do {
+            while (pegar(id, t)) tarefa(t, id);
+        } while (roubar(id));
+    });
+}
+
+/// @brief Núcleos em que o processo pode rodar (taskset, cgroups, máscara do Windows), lidos
+/// uma vez, antes de qualquer fixação: a primeira chamada vem de uma thread do pool ainda solta.
+static const std::vector<int>& nucleosPermitidos() {
+    static const std::vector<int> nucleos = [] {
+        std::vector<int> lista;
+#if defined(_WIN32)
+        DWORD_PTR processo = 0, sistema = 0;
+        if (GetProcessAffinityMask(GetCurrentProcess(), &processo, &sistema))
+            for (int k = 0; k < (int)(8 * sizeof(DWORD_PTR)); k++)
+                if (processo & ((DWORD_PTR)1 << k)) lista.push_back(k);
+#elif defined(__linux__)
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        if (sched_getaffinity(0, sizeof(conjunto), &conjunto) == 0)
+            for (int k = 0; k < CPU_SETSIZE; k++)
+                if (CPU_ISSET(k, &conjunto)) lista.push_back(k);
+#endif
+        return lista;
+    }();
+    return nucleos;
+}
+
+bool fixarThreadNoNucleo(int nucleo) {
+    const std::vector<int>& nucleos = nucleosPermitidos();
+    if (nucleos.empty()) return false;
+    int escolhido = nucleos[nucleo % nucleos.size()];
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << escolhido) != 0;
+#elif defined(__linux__)
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(escolhido, &conjunto);
+    return pthread_setaffinity_np(pthread_self(), sizeof(conjunto), &conjunto) == 0;
+#else
+    (void)escolhido;
+    return false;
+#endif
+}
+
+void inicializarParalelismo(int nThreads) {
+    if (nThreads <= 0) nThreads = (int)std::thread::hardware_concurrency();
+    delete pool;
+    pool = new PoolDeThreads(nThreads);
+}
@@ -0,0 +1,98 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+
+/// @brief Pool de threads persistente que distribui trabalho indexado entre os núcleos.
+///
+/// As threads são criadas uma única vez e reaproveitadas a cada geração. A thread que
+/// chama paraCada() também trabalha (é sempre o trabalhador 0), então um pool de
+/// tamanho 1 executa tudo sequencialmente sem criar nenhuma thread extra.
+class PoolDeThreads {
+public:
+    explicit PoolDeThreads(int nThreads);
+    ~PoolDeThreads();
+
+    int tamanho() const { return nTrabalhadores; }
+
+    /// Executa tarefa(i, idTrabalhador) para todo i em [0, n) e só retorna quando todos terminarem.
+    void paraCada(int n, const std::function<void(int, int)>& tarefa);
+
+    /// Executa tarefa(idTrabalhador) exatamente uma vez em cada trabalhador, cada um na sua
+    /// própria thread (divisão fixa, ao contrário de paraCada), e espera todos terminarem.
+    void emCadaTrabalhador(const std::function<void(int)>& tarefa);
+
+private:
+    void loopTrabalhador(int id);
+    void consumirIndices(int id);
+
+    int nTrabalhadores;
+    std::vector<std::thread> threads;
+
+    std::mutex mtx;
+    std::condition_variable cvInicio;
+    std::condition_variable cvFim;
+
+    const std::function<void(int, int)>* tarefaAtual;
+    int totalAtual;
+    bool umPorTrabalhador; // lote de emCadaTrabalhador: cada trabalhador chama a tarefa com o próprio id
+    std::atomic<int> proximoIndice;
+    int ativos;
+    unsigned long long loteAtual;
+    bool encerrar;
+};
+
+/// @brief Distribui tarefas independentes e de duração irregular (os alvos do modo lote)
+/// entre os trabalhadores de um pool, com roubo de trabalho.
+///
+/// Cada trabalhador começa com um intervalo contíguo de tarefas e consome do início dele.
+/// Quando o seu acaba, rouba a metade final da fila com mais tarefas restantes, que vira o
+/// seu novo intervalo. Como as tarefas não criam tarefas, quem não acha nada para roubar
+/// terminou. Cada fila tem a sua trava, disputada só nos roubos: as tarefas duram
+/// milissegundos ou mais, ao contrário dos índices de paraCada.
+class EscalonadorRoubo {
+public:
+    EscalonadorRoubo() : nFilas(0), totalRoubos(0) {}
+
+    /// Executa tarefa(t, idTrabalhador) para todo t em [0, n) nos trabalhadores do pool e
+    /// espera todas terminarem.
+    void executar(PoolDeThreads& pool, int n, const std::function<void(int, int)>& tarefa);
+
+    /// Roubos feitos na última chamada de executar.
+    long long roubos() const { return totalRoubos.load(); }
+
+private:
+    struct Fila {
+        std::mutex trava;
+        int inicio, fim;          // tarefas [inicio, fim) ainda não começadas
+        char enchimento[64];      // filas vizinhas em linhas de cache diferentes
+    };
+
+    bool pegar(int id, int& tarefa);
+    bool roubar(int id);
+
+    std::unique_ptr<Fila[]> filas;
+    int nFilas;
+    std::atomic<long long> totalRoubos;
+};
+
+// Pool global usado pelo laço evolutivo (criado em inicializarParalelismo)
+extern PoolDeThreads* pool;
+
+/// Cria o pool global. nThreads <= 0 usa todos os núcleos disponíveis.
+void inicializarParalelismo(int nThreads);
+
+/// Prende a thread atual ao núcleo de índice 'nucleo' (módulo a quantidade) entre os que o
+/// processo pode usar. Só para as threads do pool (trabalhador > 0): a afinidade não é
+/// desfeita, e a thread que chama paraCada é do servidor ou do programa que carregou a
+/// biblioteca. Sem efeito onde a afinidade não é suportada; retorna false nesse caso ou se
+/// o sistema recusar.
+bool fixarThreadNoNucleo(int nucleo);
+
+#endif
@@ -0,0 +1,195 @@
+#include "Planejador.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Robot.h"
+#include "Evolution.h"
+#include "Populacao.h"
+#include "Lote.h"
+#include "Paralelo.h"
+#include "Metricas.h"
+#include "MapaColisao.h"
+#include "Cena.h"
+#include "Braco.h"
+#include "Genoma.h"
+#include "Arquivo.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+using namespace std;
+
+static const char MAGICA_LOTE[4] = {'B', 'R', 'L', 'T'};
+static const uint32_t VERSAO_LOTE = 1;
+
+/// @brief Buffers de um trabalhador do lote, reaproveitados de um alvo para o outro.
+/// Como na ilha, o contexto tem um pool de tamanho 1: a evolução inteira roda na thread
+/// do trabalhador.
+struct TrabalhadorLote {
+    Populacao pop, proxima;
+    PoolDeThreads poolLocal;
+    ContextoEvolutivo ctx;
+    vector<vector<double>> solucoesIK;
+
+    TrabalhadorLote() : poolLocal(1) {
+        ctx.pool = &poolLocal;
+        ctx.solucoesIK = &solucoesIK;
+    }
+};
+
+static double segundosDesde(chrono::steady_clock::time_point inicio) {
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+bool lerTarefasLote(const string& caminho, vector<TarefaLote>& tarefas) {
+    ifstream arquivo(caminho.c_str());
+    if (!arquivo) return false;
+
+    tarefas.clear();
+    vector<string> cenasValidas;
+    string linha;
+    int numero = 0;
+    while (getline(arquivo, linha)) {
+        numero++;
+        size_t comentario = linha.find('#');
+        if (comentario != string::npos) linha.erase(comentario);
+
+        istringstream entrada(linha);
+        TarefaLote t;
+        if (!(entrada >> t.alvo.x)) continue;
+        if (!(entrada >> t.alvo.y >> t.alvo.z)) {
+            cerr << "Erro: " << caminho << ":" << numero << " alvo invalido" << endl;
+            return false;
+        }
+        entrada >> t.cena;
+        // Uma cena que não carrega resolveria o alvo sem obstáculos: o lote inteiro é recusado
+        if (!t.cena.empty() && find(cenasValidas.begin(), cenasValidas.end(), t.cena) == cenasValidas.end()) {
+            Cena teste;
+            if (!teste.carregar(t.cena)) {
+                cerr << "Erro: " << caminho << ":" << numero << " cena " << t.cena << " nao carregada" << endl;
+                return false;
+            }
+            cenasValidas.push_back(t.cena);
+        }
+        tarefas.push_back(t);
+    }
+    return true;
+}
+
+/// @brief Uma evolução de população única até um dos limites: as gerações de executarEvolucao
+/// (avaliarGeracao e fecharGeracao) sem streaming, cache e checkpoint, no contexto do trabalhador.
+static void resolverTarefa(TrabalhadorLote& t, Ponto alvo, const LimitesExecucao& lim, SolucaoLote& solucao) {
+    ResultadoExecucao& res = solucao.res;
+    Individuo& melhor = solucao.melhor;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+    t.solucoesIK.clear();
+    if (c._ik == "_ik_on") cinematicaInversa(alvo, t.solucoesIK);
+
+    EstadoEvolutivo est;
+    ControleParada parada;
+    t.pop.redimensionar(c.nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+    t.proxima.redimensionar(c.nIndv, c.nGenes, c.nJuntas, c.nWaypoints, camposPrefixo());
+    gerarPopulacaoInicial(t.pop, t.ctx);
+    res.avaliacoes += avaliarPopulacao(t.pop, alvo, t.ctx);
+    extrairIndividuo(t.pop, 0, melhor);
+    reavaliarIndividuo(melhor, alvo);
+
+    while (true) {
+        avaliarGeracao(t.pop, alvo, est, parada, res, melhor, lim.toleranciaPlato, inicio, t.ctx);
+        if (parada.deveParar(lim, res, est.geracao, segundosDesde(inicio), melhor.venceu, res.desfecho)) break;
+        fecharGeracao(t.pop, t.proxima, alvo, est, res, c.nIndv, t.ctx);
+    }
+
+    res.segundos = segundosDesde(inicio);
+    registrarTrajetoria(melhor, alvo);
+}
+
+ResumoLote resolverLote(const vector<TarefaLote>& tarefas, const LimitesExecucao& lim,
+                        vector<SolucaoLote>& solucoes) {
+    ResumoLote resumo;
+    resumo.alvos = (int)tarefas.size();
+    resumo.nucleos = pool->tamanho();
+    solucoes.assign(tarefas.size(), SolucaoLote());
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+
+    // Buffers de cada trabalhador, guardados entre lotes: nenhum alvo disputa buffers com outro
+    static vector<unique_ptr<TrabalhadorLote>> trabalhadores;
+    while ((int)trabalhadores.size() < pool->tamanho())
+        trabalhadores.push_back(unique_ptr<TrabalhadorLote>(new TrabalhadorLote()));
+
+    // Grupos por cena, na ordem da primeira aparição
+    vector<pair<string, vector<int>>> grupos;
+    for (int i = 0; i < (int)tarefas.size(); i++) {
+        size_t g = 0;
+        while (g < grupos.size() && grupos[g].first != tarefas[i].cena) g++;
+        if (g == grupos.size()) grupos.push_back(make_pair(tarefas[i].cena, vector<int>()));
+        grupos[g].second.push_back(i);
+    }
+
+    string cenaPadrao = c.arquivoCena;
+    montarBraco();
+    montarGenoma();
+    zerarMetricas();
+    EscalonadorRoubo escalonador;
+    for (const auto& grupo : grupos) {
+        c.arquivoCena = grupo.first.empty() ? cenaPadrao : grupo.first;
+        montarCena();
+        prepararMapaColisao();
+
+        const vector<int>& indices = grupo.second;
+        escalonador.executar(*pool, (int)indices.size(), [&](int k, int id) {
+            if (c.fixarNucleos && id > 0) fixarThreadNoNucleo(id);
+            int i = indices[k];
+            resolverTarefa(*trabalhadores[id], tarefas[i].alvo, lim, solucoes[i]);
+        });
+        resumo.roubos += escalonador.roubos();
+    }
+    c.arquivoCena = cenaPadrao;
+
+    for (const SolucaoLote& s : solucoes) {
+        if (s.melhor.venceu) resumo.resolvidos++;
+        resumo.avaliacoes += s.res.avaliacoes;
+    }
+    resumo.segundos = segundosDesde(inicio);
+    return resumo;
+}
+
+bool gravarSolucoesLote(const string& caminho, const vector<TarefaLote>& tarefas,
+                        const vector<SolucaoLote>& solucoes) {
+    EscritorBinario e;
+    e.bytes(MAGICA_LOTE, 4);
+    e.valor(VERSAO_LOTE);
+    e.valor((int32_t)tarefas.size());
+    e.valor((int32_t)c.nGenes);
+    e.valor((int32_t)c.nJuntas);
+    e.valor((uint32_t)sementeBase);
+
+    for (size_t i = 0; i < tarefas.size(); i++) {
+        const Individuo& m = solucoes[i].melhor;
+        const ResultadoExecucao& r = solucoes[i].res;
+        e.valor(tarefas[i].alvo.x);
+        e.valor(tarefas[i].alvo.y);
+        e.valor(tarefas[i].alvo.z);
+        e.valor(m.fitness);
+        e.valor((int32_t)m.passoVitoria);
+        e.valor((uint8_t)(m.venceu ? 1 : 0));
+        e.valor((int32_t)r.geracoes);
+        e.valor((int64_t)r.avaliacoes);
+        e.valor((int32_t)r.geracaoPrimeiraVitoria);
+        e.valor((int64_t)r.avaliacoesPrimeiraVitoria);
+        for (int k = 0; k < c.nGenes * c.nJuntas; k++) e.valor(k < (int)m.genoma.size() ? m.genoma[k] : 0.0);
+        e.valor((uint32_t)m.trajetoria.size());
+        for (const Ponto& p : m.trajetoria) {
+            e.valor((float)p.x);
+            e.valor((float)p.y);
+            e.valor((float)p.z);
+        }
+    }
+
+    return gravarArquivoAtomico(caminho, {{e.dados.data(), e.dados.size()}});
+}
@@ -0,0 +1,65 @@
+#ifndef PLANEJADOR_H
+#define PLANEJADOR_H
+
+#include "Types.h"
+#include "Execucao.h"
+#include <string>
+#include <vector>
+
+/// @brief Modo lote (--headless --lote arquivo): muitos alvos resolvidos de uma vez, um por
+/// trabalhador, para o planejamento offline.
+///
+/// Arquivo de alvos (texto, uma linha por alvo, '#' começa um comentário):
+///   x y z [cena]
+/// A cena opcional é um arquivo de obstáculos (ver Cena.h) que substitui o de --cena para
+/// aquele alvo. Os alvos são agrupados por cena: a cena global (e o mapa de colisão) é
+/// montada uma vez por grupo e os alvos do grupo são divididos entre os trabalhadores do
+/// pool por um EscalonadorRoubo.
+///
+/// Cada alvo é uma evolução de população única inteira em um só trabalhador (contexto com
+/// pool de tamanho 1 e sementes de cinemática inversa próprias), com os mesmos fluxos
+/// aleatórios e o mesmo laço de executarEvolucao, então o resultado de um alvo é o do modo
+/// headless com a mesma semente e os mesmos limites, qualquer que seja o trabalhador ou a
+/// ordem. O cache de soluções, o checkpoint e o modelo de ilhas não se aplicam.
+struct TarefaLote {
+    Ponto alvo;
+    std::string cena; // vazio = a cena de Config::arquivoCena
+};
+
+struct SolucaoLote {
+    Individuo melhor;      // com a trajetória cartesiana registrada
+    ResultadoExecucao res;
+};
+
+// Medidas do lote inteiro
+struct ResumoLote {
+    int alvos;
+    int resolvidos;
+    long long avaliacoes;
+    double segundos;
+    int nucleos;
+    long long roubos;
+
+    ResumoLote() : alvos(0), resolvidos(0), avaliacoes(0), segundos(0.0), nucleos(0), roubos(0) {}
+};
+
+/// Lê o arquivo de alvos. false se não abrir, se alguma linha não tiver as três coordenadas
+/// ou se algum arquivo de cena não carregar por completo.
+bool lerTarefasLote(const std::string& caminho, std::vector<TarefaLote>& tarefas);
+
+/// Resolve todas as tarefas no pool global, cada uma até um dos limites de 'lim' (streaming,
+/// interrupção e estado são ignorados). solucoes[i] é a da tarefa i.
+ResumoLote resolverLote(const std::vector<TarefaLote>& tarefas, const LimitesExecucao& lim,
+                        std::vector<SolucaoLote>& solucoes);
+
+/// @brief Grava as soluções em um arquivo binário compacto (temporário renomeado por cima).
+///
+/// Layout (little-endian): "BRLT", versão u32 (1), nTarefas i32, nGenes i32, nJuntas i32,
+/// semente u32; depois, por tarefa na ordem do arquivo de alvos: alvo 3 f64, fitness f64,
+/// passoVitoria i32, venceu u8, geracoes i32, avaliacoes i64, geração e avaliações da
+/// primeira vitória (i32, i64; -1 sem vitória), genoma nGenes*nJuntas f64, nPontos u32 e a
+/// trajetória da ponta (nPontos x 3 f32).
+bool gravarSolucoesLote(const std::string& caminho, const std::vector<TarefaLote>& tarefas,
+                        const std::vector<SolucaoLote>& solucoes);
+
+#endif
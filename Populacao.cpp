@@ -0,0 +1,96 @@
+#include "Populacao.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace std;
+
+// Alinhamento dos genomas (uma linha de cache; também cobre registradores AVX)
+static const size_t ALINHAMENTO_BYTES = 64;
+static const int DOUBLES_POR_LINHA = (int)(ALINHAMENTO_BYTES / sizeof(double));
+
+/// @brief Aloca os buffers para nIndv indivíduos. Só realoca se as dimensões mudarem.
+/// @param nIndv Quantidade de indivíduos.
+/// @param nGenes Quantidade de genes por genoma (waypoints, ou pontos de controle com _gen_spline).
+/// @param nJuntas Quantidade de juntas por waypoint.
+/// @param nWaypoints Linhas do cache de prefixo (uma por passo da trajetória).
+/// @param camposPorWaypoint Doubles do cache de prefixo por waypoint (0 desliga o cache).
+void Populacao::redimensionar(int nIndv, int nGenes, int nJuntas, int nWaypoints, int camposPorWaypoint) {
+    this->nIndv = nIndv;
+    this->capacidade = nIndv;
+    this->nGenes = nGenes;
+    this->nJuntas = nJuntas;
+    this->nWaypoints = nWaypoints;
+    this->camposPorWaypoint = camposPorWaypoint;
+
+    // Arredonda o genoma para um número inteiro de linhas de cache
+    int doubles = nGenes * nJuntas;
+    passo = ((doubles + DOUBLES_POR_LINHA - 1) / DOUBLES_POR_LINHA) * DOUBLES_POR_LINHA;
+
+    buffer.assign((size_t)nIndv * passo + DOUBLES_POR_LINHA, 0.0);
+    uintptr_t endereco = (uintptr_t)buffer.data();
+    size_t resto = endereco % ALINHAMENTO_BYTES;
+    deslocamento = resto == 0 ? 0 : (ALINHAMENTO_BYTES - resto) / sizeof(double);
+
+    fitness.assign(nIndv, -1e9);
+    passoVitoria.assign(nIndv, 0);
+    venceu.assign(nIndv, 0);
+
+    prefixos.assign((size_t)nIndv * nWaypoints * camposPorWaypoint, 0.0);
+    passoReavaliacao.assign(nIndv, 1);
+    linhasPrefixo.assign(nIndv, 0);
+}
+
+size_t Populacao::bytesTotais() const {
+    return bytesGenomas() + prefixos.capacity() * sizeof(double) + fitness.capacity() * sizeof(double) +
+           (passoVitoria.capacity() + passoReavaliacao.capacity() + linhasPrefixo.capacity()) * sizeof(int) +
+           venceu.capacity();
+}
+
+void Populacao::marcarTodosParaReavaliar() {
+    fill(passoReavaliacao.begin(), passoReavaliacao.end(), 1);
+    fill(linhasPrefixo.begin(), linhasPrefixo.end(), 0);
+}
+
+void Populacao::copiarDe(const Populacao& outra, int origem, int destino) {
+    const double* src = outra.genoma(origem);
+    copy(src, src + doublesPorGenoma(), genoma(destino));
+    fitness[destino] = outra.fitness[origem];
+    passoVitoria[destino] = outra.passoVitoria[origem];
+    venceu[destino] = outra.venceu[origem];
+
+    const double* prefixoOrigem = outra.prefixo(origem);
+    copy(prefixoOrigem, prefixoOrigem + (size_t)outra.linhasPrefixo[origem] * camposPorWaypoint, prefixo(destino));
+    passoReavaliacao[destino] = outra.passoReavaliacao[origem];
+    linhasPrefixo[destino] = outra.linhasPrefixo[origem];
+}
+
+/// @brief Copia o indivíduo i da população para um 'Individuo' independente.
+Individuo extrairIndividuo(const Populacao& pop, int i) {
+    const double* g = pop.genoma(i);
+    Individuo ind(vector<double>(g, g + pop.doublesPorGenoma()));
+    ind.fitness = pop.fitness[i];
+    ind.passoVitoria = pop.passoVitoria[i];
+    ind.venceu = pop.venceu[i] != 0;
+    return ind;
+}
+
+/// @brief Copia o indivíduo i para 'destino' reaproveitando os vetores dele (sem alocar depois
+/// da primeira vez). A trajetória fica vazia: ela não corresponde mais ao genoma.
+void extrairIndividuo(const Populacao& pop, int i, Individuo& destino) {
+    const double* g = pop.genoma(i);
+    destino.genoma.assign(g, g + pop.doublesPorGenoma());
+    destino.fitness = pop.fitness[i];
+    destino.passoVitoria = pop.passoVitoria[i];
+    destino.venceu = pop.venceu[i] != 0;
+    destino.trajetoria.clear();
+}
+
+/// @brief Escreve um 'Individuo' na posição i da população.
+void inserirIndividuo(Populacao& pop, int i, const Individuo& ind) {
+    copy(ind.genoma.begin(), ind.genoma.end(), pop.genoma(i));
+    pop.fitness[i] = ind.fitness;
+    pop.passoVitoria[i] = ind.passoVitoria;
+    pop.venceu[i] = ind.venceu ? 1 : 0;
+    pop.passoReavaliacao[i] = 1;
+    pop.linhasPrefixo[i] = 0;
+}
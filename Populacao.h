@@ -0,0 +1,75 @@
+#ifndef POPULACAO_H
+#define POPULACAO_H
+
+#include "Types.h"
+#include <vector>
+#include <cstddef>
+
+/// @brief População armazenada como estrutura de arrays (SoA).
+///
+/// Todos os genomas ficam em um único buffer contíguo de nIndv x nGenes x nJuntas
+/// doubles, com cada indivíduo começando em um endereço alinhado a 64 bytes. Fitness
+/// e metadados ficam em arrays separados. O gene g da junta j do indivíduo i está em
+/// genoma(i)[g * nJuntas + j].
+///
+/// A memória só é alocada em redimensionar(); depois disso o laço evolutivo apenas
+/// reescreve os buffers, trocando a geração atual e a próxima com std::swap.
+/// ajustarTamanho() muda a quantidade de indivíduos em uso sem realocar (tamanho
+/// adaptativo da população, ver Config::_pop).
+struct Populacao {
+    int nIndv;
+    int capacidade; // indivíduos alocados (nIndv <= capacidade)
+    int nGenes;
+    int nJuntas;
+    int passo; // doubles entre o início de dois genomas consecutivos (múltiplo de 8)
+
+    std::vector<double> fitness;
+    std::vector<int> passoVitoria;
+    std::vector<unsigned char> venceu;
+
+    // Reavaliação incremental: cada indivíduo guarda o estado da simulação a cada waypoint
+    // (ver CAMPOS_PREFIXO em Lote.h). passoReavaliacao[i] é o primeiro passo que precisa ser
+    // simulado de novo (0 = avaliação em dia) e linhasPrefixo[i] quantas linhas do cache valem.
+    int nWaypoints;
+    int camposPorWaypoint;
+    std::vector<double> prefixos;
+    std::vector<int> passoReavaliacao;
+    std::vector<int> linhasPrefixo;
+
+    Populacao() : nIndv(0), capacidade(0), nGenes(0), nJuntas(0), passo(0), nWaypoints(0), camposPorWaypoint(0), deslocamento(0) {}
+
+    void redimensionar(int nIndv, int nGenes, int nJuntas, int nWaypoints, int camposPorWaypoint);
+
+    int tamanho() const { return nIndv; }
+    int doublesPorGenoma() const { return nGenes * nJuntas; }
+
+    // Bytes alocados: genomas (com o alinhamento), cache de prefixo e metadados
+    size_t bytesGenomas() const { return buffer.capacity() * sizeof(double); }
+    size_t bytesTotais() const;
+
+    // Passa a usar os n primeiros indivíduos (1 <= n <= capacidade); os demais ficam guardados
+    void ajustarTamanho(int n) { nIndv = n < 1 ? 1 : (n > capacidade ? capacidade : n); }
+
+    double* genoma(int i) { return buffer.data() + deslocamento + (size_t)i * passo; }
+    const double* genoma(int i) const { return buffer.data() + deslocamento + (size_t)i * passo; }
+
+    double* prefixo(int i) { return prefixos.data() + (size_t)i * nWaypoints * camposPorWaypoint; }
+    const double* prefixo(int i) const { return prefixos.data() + (size_t)i * nWaypoints * camposPorWaypoint; }
+
+    // Descarta todas as avaliações e caches (ex.: população nova ou alvo diferente)
+    void marcarTodosParaReavaliar();
+
+    // Copia genoma, metadados e cache de prefixo do indivíduo 'origem' de 'outra' para a posição 'destino'
+    void copiarDe(const Populacao& outra, int origem, int destino);
+
+private:
+    std::vector<double> buffer;
+    size_t deslocamento; // doubles até o primeiro endereço alinhado dentro de 'buffer'
+};
+
+// Conversões entre a população e o indivíduo isolado (usado para o melhor global)
+Individuo extrairIndividuo(const Populacao& pop, int i);
+void extrairIndividuo(const Populacao& pop, int i, Individuo& destino);
+void inserirIndividuo(Populacao& pop, int i, const Individuo& ind);
+
+#endif
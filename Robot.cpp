@@ -2,14 +2,20 @@
 
 #include "Robot.h"
 #include "Config.h"
+#include "Cena.h"
+#include "Braco.h"
+#include "MapaColisao.h"
+#include "Genoma.h"
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
 /// @brief Calcula o quadrado da distância entre dois pontos.
 double distSq(Ponto p1, Ponto p2) {
-    return pow(p1.x - p2.x, 2) + pow(p1.y - p2.y, 2) + pow(p1.z - p2.z, 2);
+    double dx = p1.x - p2.x, dy = p1.y - p2.y, dz = p1.z - p2.z;
+    return dx * dx + dy * dy + dz * dz;
 }
 
 /// @brief Verifica colisão entre um segmento de reta (braço) e uma esfera (obstáculo).
@@ -60,60 +66,175 @@ bool segmentoColideEsfera(Ponto p1, Ponto p2, Obstaculo obs) {
 /// @brief Calcula a Cinemática Direta do braço robótico.
 /// 
 /// Transforma o estado do robô do "Espaço das Juntas" (ângulos em graus) para o 
-/// Espaço Cartesiano (coordenada X, Y, Z).
+/// Espaço Cartesiano (coordenada X, Y, Z), pela tabela DH do braço (ver Braco.h).
 ///
-/// @param angulos Vetor contendo os ângulos atuais das juntas (Base, Ombro, Cotovelo).
+/// @param angulos Vetor contendo os ângulos atuais das juntas (Base, Ombro, Cotovelo, ...).
 /// @return Ponto Coordenada {x, y, z} da ponta do braço.
 Ponto cinematicaDireta(const vector<double>& angulos) {
-    // Comprimentos dos segmentos do braço e conversão de graus para radianos
-    double L_umero = 10.0;
-    double L_antebraco = 10.0;
+    Ponto origens[MAX_JUNTAS + 1];
+    origensDasJuntas(angulos.data(), origens);
+    return origens[braco.nJuntas];
+}
 
-    double angulo_base     = angulos[0] * (M_PI / 180.0);
-    double angulo_ombro    = angulos[1] * (M_PI / 180.0);
-    double angulo_cotovelo = angulos[2] * (M_PI / 180.0);
-    
-    // Cálculo da posição da ponta do braço
-    double angulo_abs = angulo_ombro - angulo_cotovelo;
+/// @brief Leva um ângulo (graus) para dentro de [minimo, maximo] somando voltas inteiras.
+/// @return false se nenhuma volta cabe no intervalo.
+static bool ajustarVolta(double& angulo, double minimo, double maximo) {
+    const double folga = 1e-9; // arredondamento perto dos limites
+    angulo = minimo + fmod(fmod(angulo - minimo, 360.0) + 360.0, 360.0);
+    if (angulo > maximo + folga && angulo - 360.0 >= minimo - folga) angulo -= 360.0;
+    if (angulo > maximo + folga) return false;
+    angulo = max(minimo, min(maximo, angulo));
+    return true;
+}
 
-    double r_total = L_umero * cos(angulo_ombro) + L_antebraco * cos(angulo_abs);
-    double z_total = L_umero * sin(angulo_ombro) + L_antebraco * sin(angulo_abs);
+/// @brief Cinemática inversa analítica do braço clássico (base + ombro + cotovelo).
+///
+/// A base aponta o plano do braço para o alvo (raio horizontal r > 0) ou para o lado oposto,
+/// com o braço inclinado para trás (r < 0). Em cada plano sobra um 2R (úmero e antebraço)
+/// com os dois ramos do cotovelo, cos(fi) = (r² + z² - L1² - L2²) / (2 L1 L2): até quatro
+/// soluções. Entram só as que cabem em baseLmin/baseLmax (cada ângulo na volta certa);
+/// no braço original, com o cotovelo em [0, 180], sobra o ramo do cotovelo para baixo.
+///
+/// @param alvo Ponto a alcançar.
+/// @param solucoes Recebe as soluções distintas (ângulos em graus, nJuntas por solução).
+/// @return Quantidade de soluções; 0 se o alvo está fora do alcance ou o braço não é o clássico.
+int cinematicaInversa(Ponto alvo, vector<vector<double>>& solucoes) {
+    solucoes.clear();
+    if (!braco.cadeia) montarBraco();
+    if (!braco.classico3R) return 0;
+
+    double grausPorRad = 180.0 / M_PI;
+    double l1 = braco.comprimentoUmero, l2 = braco.comprimentoAntebraco;
+    double raioHorizontal = sqrt(alvo.x * alvo.x + alvo.y * alvo.y);
+    double base = atan2(alvo.y, alvo.x) * grausPorRad;
+
+    for (int ramoBase = 0; ramoBase < 2; ramoBase++) {
+        double r = ramoBase == 0 ? raioHorizontal : -raioHorizontal;
+        double cosFi = (r * r + alvo.z * alvo.z - l1 * l1 - l2 * l2) / (2 * l1 * l2);
+        if (fabs(cosFi) > 1.0 + 1e-12) continue;
+        double fi = acos(max(-1.0, min(1.0, cosFi)));
+
+        for (int ramoCotovelo = 0; ramoCotovelo < 2; ramoCotovelo++) {
+            double f = ramoCotovelo == 0 ? -fi : fi;
+            double ombro = atan2(alvo.z, r) - atan2(l2 * sin(f), l1 + l2 * cos(f));
+
+            // FK: absoluto do antebraço = ombro - cotovelo = ombro + f
+            vector<double> angulos = {base + (ramoBase == 0 ? 0.0 : 180.0), ombro * grausPorRad, -f * grausPorRad};
+            bool cabe = true;
+            for (int k = 0; k < 3 && cabe; k++) cabe = ajustarVolta(angulos[k], c.baseLmin[k], c.baseLmax[k]);
+            if (!cabe) continue;
+
+            bool repetida = false;
+            for (const vector<double>& s : solucoes) {
+                double diferenca = 0.0;
+                for (int k = 0; k < 3; k++) diferenca = max(diferenca, fabs(s[k] - angulos[k]));
+                repetida = repetida || diferenca < 1e-9;
+            }
+            if (!repetida) solucoes.push_back(angulos);
+        }
+    }
+    return (int)solucoes.size();
+}
 
-    double x = r_total * cos(angulo_base);
-    double y = r_total * sin(angulo_base);
-    double z = z_total;
+/// @brief Verifica se um segmento do braço, já posicionado, passa a menos de 'margem' de um obstáculo.
+/// @param origens Origens das juntas (ver origensDasJuntas).
+/// @param margem Folga exigida (0 = teste exato).
+static bool segmentosColidem(const Ponto* origens, double margem) {
+    for (int s = 0; s < braco.nSegmentos; s++) {
+        int i = braco.segmentos[s];
+        if (cena.segmentoColide(origens[i], origens[i + 1], margem)) return true;
+    }
+    return false;
+}
 
-    return {x, y, z};
+/// @brief Verifica se algum segmento do braço passa a menos de 'margem' de um obstáculo da cena.
+/// @param angulos Ângulos das juntas em graus.
+/// @param margem Folga exigida (0 = teste exato).
+bool bracoColide(const double* angulos, double margem) {
+    Ponto origens[MAX_JUNTAS + 1];
+    origensDasJuntas(angulos, origens);
+    return segmentosColidem(origens, margem);
 }
 
 /// @brief Verifica se o robô colide com o obstaculo dado uma configuração de ângulos.
 /// @param angulos Vetor contendo os ângulos atuais das juntas (Base, Ombro, Cotovelo).
 /// @return 'true' se houver colisão, 'false' caso contrário.
 bool verificarColisao(const vector<double>& angulos) {
-    double L_umero = 10.0;
-
-    double angulo_base = angulos[0] * (M_PI / 180.0);
-    double angulo_ombro = angulos[1] * (M_PI / 180.0);
+    if (mapaColisao.pronto() && mapaColisao.livre(angulos.data(), 0.0)) return false;
+    return bracoColide(angulos.data(), 0.0);
+}
 
-    // Posição da base do robô
-    Ponto p0 = {0.0, 0.0, 0.0}; 
+/// @brief Teste contínuo do trecho [t0, t1] do movimento linear (no espaço das juntas) de 'a' para 'b'.
+///
+/// Nenhum ponto do braço se desloca mais que 'deslocamento' (por unidade de t) ao longo do
+/// movimento, então no trecho todo o braço fica a menos de deslocamento * (t1 - t0) / 2 da
+/// pose do meio. Se a pose do meio, com essa folga, não encosta em nada, o trecho está
+/// livre; senão o trecho é dividido ao meio até a folga ficar menor que a tolerância.
+static bool trechoColide(const double* a, const double* b, double t0, double t1, double deslocamento) {
+    double t = (t0 + t1) / 2;
+    double meio[MAX_JUNTAS];
+    for (int k = 0; k < braco.nJuntas; k++) meio[k] = a[k] + (b[k] - a[k]) * t;
+
+    double folga = deslocamento * (t1 - t0) / 2;
+    if (!bracoColide(meio, folga)) return false;
+    if (folga <= c.toleranciaVarredura) return true;
+    return trechoColide(a, b, t0, t, deslocamento) || trechoColide(a, b, t, t1, deslocamento);
+}
 
-    double r_cotovelo = L_umero * cos(angulo_ombro);
-    double z_cotovelo = L_umero * sin(angulo_ombro);
+/// @brief Limite do deslocamento de qualquer ponto do braço no movimento linear de 'a' para 'b'.
+///
+/// A junta i gira pontos a no máximo ModeloBraco::alcance[i] do seu eixo (a soma dos
+/// segmentos dela em diante); no braço original, 20 para a base e o ombro e 10 para o cotovelo.
+double deslocamentoMaximo(const double* a, const double* b) {
+    double grausParaRad = M_PI / 180.0;
+    double deslocamento = 0.0;
+    for (int k = 0; k < braco.nJuntas; k++) deslocamento += braco.alcance[k] * fabs(b[k] - a[k]) * grausParaRad;
+    return deslocamento;
+}
 
-    // Posição do cotovelo
-    Ponto p1;
-    p1.x = r_cotovelo * cos(angulo_base);
-    p1.y = r_cotovelo * sin(angulo_base);
-    p1.z = z_cotovelo;
+/// @brief Colisão em um passo da trajetória: a pose final e, com Config::varreduraContinua,
+/// todo o movimento desde a pose anterior (um obstáculo fino não é atravessado entre waypoints).
+///
+/// Todo ponto do braço fica, durante o passo, a menos de deslocamentoMaximo da sua posição
+/// final. Por isso uma única consulta com essa folga resolve o caso comum (longe de tudo),
+/// e com o mapa de colisão (Config::_mapa) esse caso nem chega à geometria; só os passos
+/// perto de obstáculos fazem o teste exato e a subdivisão. O teste contínuo é
+/// conservador: pode acusar colisão a até toleranciaVarredura de um obstáculo, mas nunca
+/// deixa passar um contato real.
+///
+/// @param poseAnt Ângulos no waypoint anterior.
+/// @param pose Ângulos no waypoint atual.
+/// @param origens Origens das juntas em 'pose' (ver origensDasJuntas).
+bool colisaoNoPasso(const double* poseAnt, const double* pose, const Ponto* origens) {
+    double deslocamento = c.varreduraContinua ? deslocamentoMaximo(poseAnt, pose) : 0.0;
+
+    // Pose longe de tudo pelo mapa de configurações: nem a consulta com folga é necessária
+    if (mapaColisao.pronto() && mapaColisao.livre(pose, deslocamento)) return false;
+    if (!segmentosColidem(origens, deslocamento)) return false;
+    if (deslocamento == 0.0) return true;
+
+    if (segmentosColidem(origens, 0.0)) return true;
+    return trechoColide(poseAnt, pose, 0.0, 1.0, deslocamento);
+}
 
-    // Posição da ponta do braço
-    Ponto p2 = cinematicaDireta(angulos);
+bool colisaoNoPasso(const double* poseAnt, const double* pose) {
+    Ponto origens[MAX_JUNTAS + 1];
+    origensDasJuntas(pose, origens);
+    return colisaoNoPasso(poseAnt, pose, origens);
+}
 
-    // Verifica colisão dos dois segmentos do braço com a esfera
-    if (segmentoColideEsfera(p0, p1, c.bolaDeDemolicao)) return true;
-    if (segmentoColideEsfera(p1, p2, c.bolaDeDemolicao)) return true;
-    return false;
+/// @brief Aplica as velocidades de um waypoint à pose, respeitando os limites das juntas.
+/// @param pose Posições atuais das juntas (nJuntas).
+/// @param velocidade Velocidades do waypoint (nJuntas).
+/// @param destino Recebe a nova pose (pode ser o mesmo buffer de 'pose').
+void moverPose(const double* pose, const double* velocidade, double* destino) {
+    for (int i = 0; i < c.nJuntas; i++) {
+        double np = pose[i] + velocidade[i];
+
+        if (np < c.baseLmin[i]) np = c.baseLmin[i];
+        if (np > c.baseLmax[i]) np = c.baseLmax[i];
+        destino[i] = np;
+    }
 }
 
 /// @brief Move o robô aplicando um vetor de velocidades às posições atuais.
@@ -122,49 +243,84 @@ bool verificarColisao(const vector<double>& angulos) {
 /// @return Posições atualizadas após o movimento, respeitando os limites definidos.
 vector<double> move(vector<double> p1, vector<double> v) {
     vector<double> np(p1.size());
-    for (int i = 0; i < v.size(); i++) {
-        np[i] = p1[i] + v[i];
-
-        if (np[i] < c.baseLmin[i]) np[i] = c.baseLmin[i];
-        if (np[i] > c.baseLmax[i]) np[i] = c.baseLmax[i];
-    }
+    moverPose(p1.data(), v.data(), np.data());
     return np;
 }
 
-/// @brief Avalia a qualidade (Fitness) de um indivíduo simulando sua trajetória completa.
+/// @brief Avalia a qualidade (Fitness) de um genoma simulando sua trajetória completa.
 /// 
-/// Esta função executa o "fenótipo" do robô: transforma o genoma (lista de velocidades)
-/// em uma trajetória física passo a passo.
+/// Esta função executa o "fenótipo" do robô: transforma o genoma (lista de velocidades, ou
+/// pontos de controle expandidos passo a passo com _gen_spline, ver Genoma.h) em uma
+/// trajetória física passo a passo.
+///
+/// Só usa memória de pilha (duas poses e as origens das juntas), então avaliar não aloca
+/// nada. A trajetória cartesiana só é registrada quando pedida, para o indivíduo que vai
+/// ser enviado ao simulador (ver registrarTrajetoria).
+///
+/// Com um cache de prefixo (camposPrefixo() doubles por waypoint: pose, penalidade
+/// acumulada e distância ao alvo, como CAMPOS_PREFIXO do lote para 3 juntas), a simulação
+/// retoma do estado da linha inicio - 1 e grava as linhas seguintes. A penalidade retomada
+/// continua a mesma soma, então o fitness é idêntico ao da trajetória inteira.
 /// 
-/// @param ind Referência para o indivíduo (será modificado com a nota e trajetória).
+/// @param genoma Genes lineares [nGenes x nJuntas] (ver Populacao).
 /// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+/// @param av Recebe fitness, vitória e passo da vitória.
+/// @param trajetoriaPontiforme Se não for nulo, recebe a posição da ponta a cada waypoint
+///        (a trajetória é sempre simulada desde o começo).
+/// @param prefixo Cache de prefixo do indivíduo [nWaypoints x camposPrefixo()], ou nulo.
+/// @param inicio Primeiro passo a simular (1 = trajetória inteira); as linhas anteriores
+///        do prefixo precisam estar em dia.
 /// @return O valor numérico do fitness calculado.
-double calcularFitness(Individuo& ind, Ponto alvo) {
+double calcularFitness(const double* genoma, Ponto alvo, Avaliacao& av, vector<Ponto>* trajetoriaPontiforme,
+                       double* prefixo, int inicio) {
     double penalidadeTotal = 0.0;
     double bonusObjetivo = 0.0;
-    
-    vector<vector<double>> trajetoria;
-    vector<Ponto> trajetoriaPontiforme;
-    trajetoria.push_back(c.poseInicial);
-    trajetoriaPontiforme.push_back(cinematicaDireta(c.poseInicial));
-
     double distFinal = 0;
-    ind.venceu = false;
+    const int campos = camposPrefixo();
+
+    double poses[2][MAX_JUNTAS];
+    double velocidade[MAX_JUNTAS];
+    if (trajetoriaPontiforme || !prefixo || inicio < 1) inicio = 1;
+    if (inicio > 1) {
+        const double* linha = prefixo + (size_t)(inicio - 1) * campos;
+        copy(linha, linha + c.nJuntas, poses[(inicio - 1) & 1]);
+        penalidadeTotal = linha[c.nJuntas];
+        distFinal = linha[c.nJuntas + 1];
+    } else {
+        copy(c.poseInicial.begin(), c.poseInicial.begin() + c.nJuntas, poses[0]);
+        if (prefixo) {
+            copy(poses[0], poses[0] + c.nJuntas, prefixo);
+            prefixo[c.nJuntas] = 0.0;
+            prefixo[c.nJuntas + 1] = 0.0;
+        }
+    }
+    Ponto origens[MAX_JUNTAS + 1];
+    if (trajetoriaPontiforme) {
+        trajetoriaPontiforme->clear();
+        trajetoriaPontiforme->reserve(c.nWaypoints);
+        origensDasJuntas(poses[0], origens);
+        trajetoriaPontiforme->push_back(origens[braco.nJuntas]);
+    }
+
+    av.venceu = false;
+    av.passoVitoria = 0;
 
-    for (int i = 1; i < c.nWaypoints; i++) {
-        // Calcula trajetória passo a passo
-        vector<double> poseAnt = trajetoria[i-1];
-        vector<double> poseAtual = move(poseAnt, ind.genoma[i]);
-        trajetoria.push_back(poseAtual);
+    for (int i = inicio; i < c.nWaypoints; i++) {
+        // Calcula trajetória passo a passo (as duas poses se alternam no buffer)
+        const double* poseAnt = poses[(i - 1) & 1];
+        double* poseAtual = poses[i & 1];
+        moverPose(poseAnt, velocidadeDoPasso(genoma, i, c.nJuntas, velocidade), poseAtual);
 
-        Ponto p = cinematicaDireta(poseAtual);
-        trajetoriaPontiforme.push_back(p);
-        double dist = sqrt(pow(p.x - alvo.x, 2) + pow(p.y - alvo.y, 2) + pow(p.z - alvo.z, 2));
+        // Uma só passada pela cadeia serve para a distância e para a colisão
+        origensDasJuntas(poseAtual, origens);
+        Ponto p = origens[braco.nJuntas];
+        if (trajetoriaPontiforme) trajetoriaPontiforme->push_back(p);
+        double dist = sqrt(distSq(p, alvo));
 
         // Verifica se o alvo foi alcançado
         if (dist < 0.2) {
-            ind.venceu = true;
-            ind.passoVitoria = (int)i;
+            av.venceu = true;
+            av.passoVitoria = (int)i;
             bonusObjetivo = 1000.0 + (c.nWaypoints - i) * 500.0;
             break;
         }
@@ -173,22 +329,66 @@ double calcularFitness(Individuo& ind, Ponto alvo) {
         penalidadeTotal += dist * 1.5;
         distFinal = dist;
 
-        if (verificarColisao(poseAtual)) {
+        if (colisaoNoPasso(poseAnt, poseAtual, origens)) {
             penalidadeTotal += 2000.0; 
         }
 
         double movimento = 0;
         for(int k=0; k<c.nJuntas; k++) movimento += abs(poseAtual[k] - poseAnt[k]);
         penalidadeTotal += movimento * 0.1;
-    }
 
-    ind.trajetoria = trajetoriaPontiforme;
+        if (prefixo) {
+            double* linha = prefixo + (size_t)i * campos;
+            copy(poseAtual, poseAtual + c.nJuntas, linha);
+            linha[c.nJuntas] = penalidadeTotal;
+            linha[c.nJuntas + 1] = distFinal;
+        }
+    }
 
     // Cálculo final do fitness
-    if (ind.venceu) {
-        ind.fitness = bonusObjetivo - penalidadeTotal;
+    if (av.venceu) {
+        av.fitness = bonusObjetivo - penalidadeTotal;
     } else {
-        ind.fitness = -penalidadeTotal - distFinal * 2000;
+        av.fitness = -penalidadeTotal - distFinal * 2000;
     }
+    return av.fitness;
+}
+
+/// @brief Doubles por linha do cache de prefixo do braço atual: a pose das juntas, a
+/// penalidade acumulada e a distância ao alvo (5 no braço de 3 juntas, igual a CAMPOS_PREFIXO).
+int camposPrefixo() {
+    return c.nJuntas + 2;
+}
+
+/// @brief Avalia um indivíduo isolado e guarda também a sua trajetória cartesiana.
+/// @param ind Referência para o indivíduo (será modificado com a nota e trajetória).
+/// @param alvo Coordenada (x,y,z) que o robô deve alcançar.
+/// @return O valor numérico do fitness calculado.
+double calcularFitness(Individuo& ind, Ponto alvo) {
+    Avaliacao av;
+    calcularFitness(ind.genoma.data(), alvo, av, &ind.trajetoria);
+    ind.fitness = av.fitness;
+    ind.passoVitoria = av.passoVitoria;
+    ind.venceu = av.venceu;
+    return ind.fitness;
+}
+
+/// @brief Reavalia um indivíduo isolado sem registrar a trajetória (sem alocar). A trajetória
+/// anterior deixa de valer e fica vazia até registrarTrajetoria.
+double reavaliarIndividuo(Individuo& ind, Ponto alvo) {
+    Avaliacao av;
+    calcularFitness(ind.genoma.data(), alvo, av);
+    ind.fitness = av.fitness;
+    ind.passoVitoria = av.passoVitoria;
+    ind.venceu = av.venceu;
+    ind.trajetoria.clear();
     return ind.fitness;
 }
+
+/// @brief Registra a trajetória cartesiana do indivíduo, se ainda não estiver registrada.
+/// Chamada só antes de enviar o indivíduo ao simulador; a capacidade do vetor é reaproveitada.
+void registrarTrajetoria(Individuo& ind, Ponto alvo) {
+    if (!ind.trajetoria.empty()) return;
+    Avaliacao av;
+    calcularFitness(ind.genoma.data(), alvo, av, &ind.trajetoria);
+}
@@ -9,9 +9,21 @@
 extern Obstaculo bolaDeDemolicao;
 extern std::vector<double> poseInicial;
 
+double distSq(Ponto p1, Ponto p2);
 Ponto cinematicaDireta(const std::vector<double>& angulos);
+int cinematicaInversa(Ponto alvo, std::vector<std::vector<double>>& solucoes);
 bool verificarColisao(const std::vector<double>& angulos);
+bool bracoColide(const double* angulos, double margem);
+double deslocamentoMaximo(const double* a, const double* b);
+bool colisaoNoPasso(const double* poseAnt, const double* pose, const Ponto* origens);
+bool colisaoNoPasso(const double* poseAnt, const double* pose);
+double calcularFitness(const double* genoma, Ponto alvo, Avaliacao& av, std::vector<Ponto>* trajetoriaPontiforme = nullptr,
+                       double* prefixo = nullptr, int inicio = 1);
+int camposPrefixo();
 double calcularFitness(Individuo& ind, Ponto alvo);
+double reavaliarIndividuo(Individuo& ind, Ponto alvo);
+void registrarTrajetoria(Individuo& ind, Ponto alvo);
+void moverPose(const double* pose, const double* velocidade, double* destino);
 vector<double> move(vector<double> p1, vector<double> v);
 
 #endif
@@ -0,0 +1,294 @@
+#include "Saida.h"
+#include "Config.h"
+#include "CacheSolucoes.h"
+#include "AnelCompartilhado.h"
+#include "Metricas.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static ProtocoloSaida protocoloAtual = PROTOCOLO_TEXTO;
+static AnelCompartilhado anel;
+
+// Buffer do quadro em montagem (reaproveitado: não aloca depois do primeiro quadro)
+static vector<char> quadro;
+
+// Quantidade de quadros guardados no anel de memória compartilhada
+static const int SLOTS_ANEL = 64;
+
+/// @brief Bytes do quadro de trajetória com nWaypoints pontos (cabeçalho + n + 3 floats
+/// por waypoint).
+static int tamanhoQuadroTrajetoria(int nWaypoints) {
+    return 8 + 4 + nWaypoints * 3 * (int)sizeof(float);
+}
+
+/// @brief Converte o nome usado na linha de comando ("texto", "binario", "shm").
+ProtocoloSaida protocoloDeNome(const string& nome) {
+    if (nome == "binario") return PROTOCOLO_BINARIO;
+    if (nome == "shm") return PROTOCOLO_SHM;
+    return PROTOCOLO_TEXTO;
+}
+
+/// @brief Prepara o canal de saída do protocolo escolhido.
+///
+/// No modo binário o stdout passa a ser binário (importante no Windows). No modo shm
+/// o anel é criado e anunciado com uma única linha de texto "SHM <nome> <bytes>"; se a
+/// memória compartilhada não estiver disponível, cai para o protocolo binário.
+///
+/// @param protocolo Protocolo desejado.
+/// @return false se foi preciso usar outro protocolo.
+bool configurarSaida(ProtocoloSaida protocolo) {
+    protocoloAtual = protocolo;
+    if (protocolo == PROTOCOLO_TEXTO) return true;
+
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    if (protocolo == PROTOCOLO_SHM) {
+        // Maior quadro: trajetória completa ou as métricas (um JSON de algumas centenas de bytes)
+        int maiorQuadro = max(tamanhoQuadroTrajetoria(c.nWaypoints), 4096);
+#ifdef _WIN32
+        string nome = "brasil_" + to_string(getpid());
+#else
+        string nome = "/brasil_" + to_string(getpid());
+#endif
+        if (anel.criar(nome, SLOTS_ANEL, maiorQuadro)) {
+            cout << "SHM " << anel.nome() << " " << anel.tamanhoTotal() << endl;
+            return true;
+        }
+        cerr << "Memoria compartilhada indisponivel, usando protocolo binario" << endl;
+        protocoloAtual = PROTOCOLO_BINARIO;
+        return false;
+    }
+    return true;
+}
+
+/// @brief Diz se a trajetória com nWaypoints pontos cabe no canal de saída.
+///
+/// Só o protocolo shm tem limite: o slot do anel é dimensionado uma vez, em
+/// configurarSaida, e um quadro maior não teria onde ser publicado.
+bool trajetoriaCabeNaSaida(int nWaypoints) {
+    if (protocoloAtual != PROTOCOLO_SHM) return true;
+    return tamanhoQuadroTrajetoria(nWaypoints) <= anel.maiorQuadro();
+}
+
+// ---------------------------------------------------------------- Quadros binários
+
+template <class T>
+static void anexar(T valor) {
+    size_t pos = quadro.size();
+    quadro.resize(pos + sizeof(T));
+    memcpy(&quadro[pos], &valor, sizeof(T));
+}
+
+static void iniciarQuadro(TipoQuadro tipo) {
+    quadro.clear();
+    quadro.push_back('B');
+    quadro.push_back('R');
+    quadro.push_back((char)tipo);
+    quadro.push_back(1); // versão
+    anexar<uint32_t>(0); // tamanho, preenchido em enviarQuadro
+}
+
+/// @brief Fecha o quadro e o envia com uma única escrita (stdout ou anel).
+static void enviarQuadro() {
+    uint32_t tamanho = (uint32_t)(quadro.size() - 8);
+    memcpy(&quadro[4], &tamanho, sizeof(tamanho));
+
+    if (protocoloAtual == PROTOCOLO_SHM) {
+        if (!anel.publicar(quadro.data(), quadro.size())) {
+            cerr << "Quadro de " << quadro.size() << " bytes descartado: maior que o slot da memoria compartilhada" << endl;
+        }
+    } else {
+        fwrite(quadro.data(), 1, quadro.size(), stdout);
+        fflush(stdout);
+    }
+}
+
+// ---------------------------------------------------------------- Mensagens
+
+/// @brief Envia a trajetória do melhor indivíduo.
+/// @param melhor Indivíduo cuja trajetória cartesiana será enviada.
+void imprimirTrajetoria(const Individuo& melhor) {
+    MedidorFase medidor(FASE_STREAMING);
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_TRAJETORIA);
+        anexar<uint32_t>((uint32_t)melhor.trajetoria.size());
+        for (const Ponto& p : melhor.trajetoria) {
+            anexar<float>((float)p.x);
+            anexar<float>((float)p.y);
+            anexar<float>((float)p.z);
+        }
+        enviarQuadro();
+        return;
+    }
+
+    // Texto: o quadro inteiro é montado antes e escrito de uma vez
+    ostringstream texto;
+    texto << "START_PATH\n";
+    for(size_t i = 0; i < melhor.trajetoria.size(); i++) {
+        Ponto p = melhor.trajetoria[i];
+        texto << p.x << " " << p.y << " " << p.z << "\n";
+    }
+    texto << "END_PATH\n";
+    cout << texto.str();
+    cout.flush();
+}
+
+/// @brief Manda estatísticas da geração atual para o script Python.
+/// @param geracao Número da geração atual
+/// @param melhor Melhor indivíduo encontrado até agora
+/// @param mediaFit Média de fitness da população na geração atual
+void imprimirEstatisticas(int geracao, const Individuo& melhor, double mediaFit) {
+    MedidorFase medidor(FASE_STREAMING);
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_STATS);
+        anexar<int32_t>(geracao);
+        anexar<double>(melhor.fitness);
+        anexar<double>(mediaFit);
+        anexar<uint32_t>((uint32_t)melhor.trajetoria.size());
+        enviarQuadro();
+        return;
+    }
+
+    // Formato: STATS <geracao> <melhor_fit> <media_fit> <tamanho_trajetoria>
+    cout << "STATS " 
+         << geracao << " " 
+         << melhor.fitness << " " 
+         << mediaFit << " " 
+         << melhor.trajetoria.size() << endl;
+}
+
+/// @brief Envia as informações do obstáculo.
+void imprimirObstaculo() {
+    MedidorFase medidor(FASE_STREAMING);
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_OBSTACULO);
+        anexar<double>(c.bolaDeDemolicao.x);
+        anexar<double>(c.bolaDeDemolicao.y);
+        anexar<double>(c.bolaDeDemolicao.z);
+        anexar<double>(c.bolaDeDemolicao.raio);
+        enviarQuadro();
+        return;
+    }
+
+    cout << "OBSTACLE "
+         << c.bolaDeDemolicao.x << " "
+         << c.bolaDeDemolicao.y << " "
+         << c.bolaDeDemolicao.z << " "
+         << c.bolaDeDemolicao.raio << endl;
+}
+
+/// @brief Avisa o simulador que a busca por um novo alvo começou (o gráfico é reiniciado).
+/// @param alvo Alvo da nova busca.
+void imprimirAlvo(Ponto alvo) {
+    MedidorFase medidor(FASE_STREAMING);
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_ALVO);
+        anexar<double>(alvo.x);
+        anexar<double>(alvo.y);
+        anexar<double>(alvo.z);
+        enviarQuadro();
+        return;
+    }
+
+    cout << "TARGET " << alvo.x << " " << alvo.y << " " << alvo.z << endl;
+}
+
+/// @brief Envia o retrato atual das métricas de desempenho (ver Metricas.h).
+///
+/// Texto: "METRICS <json>" em uma linha. Binário/shm: QUADRO_METRICAS com o JSON.
+void imprimirMetricas() {
+    string json = metricasJson();
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_METRICAS);
+        quadro.insert(quadro.end(), json.begin(), json.end());
+        enviarQuadro();
+        return;
+    }
+
+    cout << "METRICS " << json << endl;
+}
+
+/// @brief Avisa que a busca terminou por um critério de parada (ver LimitesExecucao).
+///
+/// Texto: "SOLVED <geracoes> <avaliacoes> <segundos> <melhor_fit>" (ou GAVE_UP).
+/// @param res Medidas da execução, com o desfecho.
+/// @param melhor Melhor indivíduo encontrado.
+void imprimirDesfecho(const ResultadoExecucao& res, const Individuo& melhor) {
+    MedidorFase medidor(FASE_STREAMING);
+    bool resolvido = res.desfecho == DESFECHO_RESOLVIDO;
+    if (protocoloAtual != PROTOCOLO_TEXTO) {
+        iniciarQuadro(QUADRO_DESFECHO);
+        anexar<uint8_t>(resolvido ? 1 : 0);
+        anexar<int32_t>(res.geracoes);
+        anexar<int64_t>(res.avaliacoes);
+        anexar<double>(res.segundos);
+        anexar<double>(melhor.fitness);
+        enviarQuadro();
+        return;
+    }
+
+    cout << (resolvido ? "SOLVED " : "GAVE_UP ")
+         << res.geracoes << " "
+         << res.avaliacoes << " "
+         << res.segundos << " "
+         << melhor.fitness << endl;
+}
+
+/// @brief Imprime as medidas de desempenho de uma execução sem visualização.
+/// @param rotulo Prefixo da linha (ex.: "RESULT" ou "BENCH").
+/// @param alvo Alvo da execução.
+/// @param res Medidas retornadas por executarEvolucao.
+void imprimirResultado(const char* rotulo, Ponto alvo, const ResultadoExecucao& res) {
+    double segundos = res.segundos > 0 ? res.segundos : 1e-9;
+    cout << rotulo
+         << " alvo=" << alvo.x << "," << alvo.y << "," << alvo.z
+         << " obstaculo=" << c.bolaDeDemolicao.x << "," << c.bolaDeDemolicao.y << ","
+         << c.bolaDeDemolicao.z << "," << c.bolaDeDemolicao.raio
+         << " geracoes=" << res.geracoes
+         << " avaliacoes=" << res.avaliacoes
+         << " segundos=" << res.segundos
+         << " geracoes_por_s=" << res.geracoes / segundos
+         << " avaliacoes_por_s=" << res.avaliacoes / segundos
+         << " primeira_vitoria_geracao=" << res.geracaoPrimeiraVitoria
+         << " primeira_vitoria_avaliacoes=" << res.avaliacoesPrimeiraVitoria
+         << " primeira_vitoria_s=" << res.segundosPrimeiraVitoria
+         << " semeados_cache=" << res.semeadosCache
+         << " catastrofes=" << res.catastrofes
+         << " replanejamentos=" << res.replanejamentos
+         << " prazos_estourados=" << res.prazosEstourados
+         << " desfecho=" << (res.desfecho == DESFECHO_RESOLVIDO ? "SOLVED" : "GAVE_UP")
+         << endl;
+}
+
+/// @brief Imprime os contadores acumulados do cache de soluções (taxa de acerto e
+/// tempo médio até a vitória com e sem sementes do cache).
+void imprimirEstatisticasCache() {
+    EstatisticasCache est = cacheSolucoes.estatisticas();
+    cout << "CACHE entradas=" << est.entradas
+         << " consultas=" << est.consultas
+         << " acertos=" << est.acertos
+         << " taxa_acerto=" << (est.consultas ? (double)est.acertos / est.consultas : 0.0)
+         << " vitoria_media_s_com_semente="
+         << (est.vitoriasComSemente ? est.segundosComSemente / est.vitoriasComSemente : -1.0)
+         << " vitoria_media_s_sem_semente="
+         << (est.vitoriasSemSemente ? est.segundosSemSemente / est.vitoriasSemSemente : -1.0)
+         << endl;
+}
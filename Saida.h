@@ -0,0 +1,49 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+
+#include "Types.h"
+#include "Execucao.h"
+#include <string>
+
+// Formas de enviar os quadros ao simulador
+enum ProtocoloSaida {
+    PROTOCOLO_TEXTO = 0,   // linhas de texto (START_PATH/STATS/OBSTACLE), compatível com versões antigas
+    PROTOCOLO_BINARIO = 1, // quadros binários no stdout, uma escrita por quadro
+    PROTOCOLO_SHM = 2      // quadros binários em um anel de memória compartilhada (ver AnelCompartilhado.h)
+};
+
+// Formato do quadro binário (little-endian):
+//   cabeçalho de 8 bytes: 'B' 'R', tipo u8, versão u8, tamanho do conteúdo u32
+//   QUADRO_OBSTACULO:  x, y, z, raio (f64)
+//   QUADRO_TRAJETORIA: n u32, seguido de n pontos x, y, z (f32)
+//   QUADRO_STATS:      geracao i32, melhor f64, media f64, tamanho da trajetória u32
+//   QUADRO_ALVO:       x, y, z (f64), enviado quando começa a busca por um alvo
+//   QUADRO_METRICAS:   texto JSON de metricasJson() (UTF-8, sem terminador)
+//   QUADRO_DESFECHO:   resolvido u8, geracoes i32, avaliacoes i64, segundos f64, melhor f64
+//                      (fim da busca por um critério de parada: SOLVED se resolvido, senão GAVE_UP)
+enum TipoQuadro {
+    QUADRO_OBSTACULO = 1,
+    QUADRO_TRAJETORIA = 2,
+    QUADRO_STATS = 3,
+    QUADRO_ALVO = 4,
+    QUADRO_METRICAS = 5,
+    QUADRO_DESFECHO = 6
+};
+
+ProtocoloSaida protocoloDeNome(const std::string& nome);
+bool configurarSaida(ProtocoloSaida protocolo);
+bool trajetoriaCabeNaSaida(int nWaypoints);
+
+// Mensagens enviadas ao script Python (no protocolo configurado)
+void imprimirTrajetoria(const Individuo& melhor);
+void imprimirEstatisticas(int geracao, const Individuo& melhor, double mediaFit);
+void imprimirObstaculo();
+void imprimirAlvo(Ponto alvo);
+void imprimirMetricas();
+void imprimirDesfecho(const ResultadoExecucao& res, const Individuo& melhor);
+
+// Relatório de uma execução headless/benchmark (uma linha, chave=valor)
+void imprimirResultado(const char* rotulo, Ponto alvo, const ResultadoExecucao& res);
+void imprimirEstatisticasCache();
+
+#endif
@@ -0,0 +1,110 @@
+#include "Selecao.h"
+#include "Config.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+using namespace std;
+
+/// @brief Converte o fitness em pesos positivos para a roleta.
+///
+/// Desloca todos os valores pelo pior fitness (quando negativo) e soma 0.1 para que
+/// nenhum indivíduo tenha chance zero.
+///
+/// @param pop População avaliada.
+/// @param pesos Recebe um peso por indivíduo (buffer reaproveitado).
+void calcularPesosRoleta(const Populacao& pop, vector<double>& pesos) {
+    double fitnessPior = pop.fitness[0];
+    for (int i = 1; i < pop.tamanho(); i++) fitnessPior = min(fitnessPior, pop.fitness[i]);
+
+    // Normalização para garantir probabilidades positivas
+    double normalizacao = (fitnessPior < 0) ? (-fitnessPior + 1.0) : 0.0;
+
+    pesos.resize(pop.tamanho());
+    for (int i = 0; i < pop.tamanho(); i++) {
+        pesos[i] = pop.fitness[i] + normalizacao + 0.1; // +0.1 para evitar zero absoluto
+    }
+}
+
+// ---------------------------------------------------------------- Roleta
+
+void SelecaoRoleta::preparar(const Populacao& pop, const EstadoEvolutivo&) {
+    calcularPesosRoleta(pop, pesos);
+    tabela.construir(pesos);
+}
+
+void SelecaoRoleta::escolherPais(int, Gerador& rng, int& pai1, int& pai2) const {
+    pai1 = tabela.sortear(rng);
+    pai2 = tabela.sortear(rng);
+}
+
+// ---------------------------------------------------------------- Torneio
+
+void SelecaoTorneio::preparar(const Populacao& pop, const EstadoEvolutivo&) {
+    this->pop = &pop;
+}
+
+/// @brief Sorteia c.tamTorneio competidores (com reposição) e devolve o de maior fitness.
+int SelecaoTorneio::escolherUm(Gerador& rng) const {
+    int vencedor = escolherIndiceDeLista(rng, pop->tamanho());
+    for (int k = 1; k < c.tamTorneio; k++) {
+        int desafiante = escolherIndiceDeLista(rng, pop->tamanho());
+        if (pop->fitness[desafiante] > pop->fitness[vencedor]) vencedor = desafiante;
+    }
+    return vencedor;
+}
+
+void SelecaoTorneio::escolherPais(int, Gerador& rng, int& pai1, int& pai2) const {
+    pai1 = escolherUm(rng);
+    pai2 = escolherUm(rng);
+}
+
+// ---------------------------------------------------------------- SUS
+
+/// @brief Escolhe de uma vez os 2 * (n - 1) pais da geração.
+///
+/// Um único sorteio posiciona o primeiro ponteiro; os demais ficam a distâncias iguais
+/// ao longo da soma dos pesos. A lista resultante é embaralhada (senão os filhos
+/// vizinhos teriam sempre pais vizinhos) com o fluxo de seleção da geração.
+void SelecaoSUS::preparar(const Populacao& pop, const EstadoEvolutivo& est) {
+    calcularPesosRoleta(pop, pesos);
+
+    double soma = 0.0;
+    for (double p : pesos) soma += p;
+
+    int nPonteiros = 2 * max(pop.tamanho() - 1, 0);
+    escolhidos.resize(nPonteiros);
+    if (nPonteiros == 0) return;
+
+    reposicionarGerador(rngGeracao, est.geracao, est.ilha, FLUXO_SELECAO);
+    double espacamento = soma / nPonteiros;
+    double ponteiro = escolherNumReal(rngGeracao, 0.0, espacamento);
+
+    double acumulado = pesos[0];
+    int i = 0;
+    for (int k = 0; k < nPonteiros; k++) {
+        while (ponteiro >= acumulado && i < pop.tamanho() - 1) acumulado += pesos[++i];
+        escolhidos[k] = i;
+        ponteiro += espacamento;
+    }
+    // Fisher–Yates explícito: std::shuffle muda de algoritmo entre bibliotecas padrão
+    for (int k = nPonteiros - 1; k > 0; k--) {
+        swap(escolhidos[k], escolhidos[escolherIndiceDeLista(rngGeracao, k + 1)]);
+    }
+}
+
+void SelecaoSUS::escolherPais(int filho, Gerador&, int& pai1, int& pai2) const {
+    // O filho 0 é o elitista; os demais consomem os pares em ordem
+    int k = 2 * (filho - 1);
+    pai1 = escolhidos[k];
+    pai2 = escolhidos[k + 1];
+}
+
+// ---------------------------------------------------------------- Fábrica
+
+EstrategiaSelecao* criarSelecao(const string& nome) {
+    if (nome == "_sel_tor") return new SelecaoTorneio();
+    if (nome == "_sel_sus") return new SelecaoSUS();
+    if (nome != "_sel_rol") cerr << "Selecao desconhecida '" << nome << "', usando roleta" << endl;
+    return new SelecaoRoleta();
+}
@@ -0,0 +1,61 @@
+#ifndef SELECAO_H
+#define SELECAO_H
+
+#include "Types.h"
+#include "Utils.h"
+#include "Populacao.h"
+#include <string>
+#include <vector>
+
+/// @brief Interface das estratégias de seleção de pais (escolhida por Config::_sel).
+///
+/// preparar() roda uma vez por geração, na thread principal, e monta o que for
+/// necessário (roleta, sorteio da geração...). escolherPais() é chamada em paralelo,
+/// uma vez por filho, e não pode alterar o estado da estratégia.
+class EstrategiaSelecao {
+public:
+    virtual ~EstrategiaSelecao() {}
+    virtual void preparar(const Populacao& pop, const EstadoEvolutivo& est) = 0;
+    virtual void escolherPais(int filho, Gerador& rng, int& pai1, int& pai2) const = 0;
+};
+
+// Pesos positivos a partir do fitness (mesma normalização da roleta original)
+void calcularPesosRoleta(const Populacao& pop, std::vector<double>& pesos);
+
+/// Roleta com tabela de alias: O(n) por geração para montar, O(1) por sorteio.
+class SelecaoRoleta : public EstrategiaSelecao {
+public:
+    void preparar(const Populacao& pop, const EstadoEvolutivo& est);
+    void escolherPais(int filho, Gerador& rng, int& pai1, int& pai2) const;
+private:
+    std::vector<double> pesos;
+    TabelaAlias tabela;
+};
+
+/// Torneio: o melhor entre c.tamTorneio indivíduos sorteados. O(k) por sorteio, sem preparo.
+class SelecaoTorneio : public EstrategiaSelecao {
+public:
+    void preparar(const Populacao& pop, const EstadoEvolutivo& est);
+    void escolherPais(int filho, Gerador& rng, int& pai1, int& pai2) const;
+private:
+    int escolherUm(Gerador& rng) const;
+    const Populacao* pop;
+};
+
+/// Amostragem Universal Estocástica: um único giro com ponteiros igualmente espaçados
+/// escolhe todos os pais da geração (variância mínima em relação à roleta).
+class SelecaoSUS : public EstrategiaSelecao {
+public:
+    void preparar(const Populacao& pop, const EstadoEvolutivo& est);
+    void escolherPais(int filho, Gerador& rng, int& pai1, int& pai2) const;
+private:
+    std::vector<double> pesos;
+    std::vector<int> escolhidos;
+    Gerador rngGeracao;
+};
+
+/// Cria a estratégia correspondente ao nome (_sel_rol, _sel_tor, _sel_sus).
+/// Cada ContextoEvolutivo guarda a sua e só a recria quando o nome muda.
+EstrategiaSelecao* criarSelecao(const std::string& nome);
+
+#endif
@@ -0,0 +1,161 @@
+#include "Servidor.h"
+#include "Config.h"
+#include "Utils.h"
+#include "Paralelo.h"
+#include "Execucao.h"
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+// Fila de comandos preenchida pela thread leitora do stdin
+static deque<string> filaComandos;
+static mutex mutexComandos;
+static condition_variable comandoChegou;
+
+// Sinaliza à evolução em andamento que há comando esperando
+static atomic<bool> comandoPendente(false);
+
+// MOVER e MOVER_OBSTACULO vão direto para a evolução em andamento, sem interrompê-la
+static CanalReplanejamento canal;
+
+/// @brief Deposita no canal um MOVER/MOVER_OBSTACULO (chamada pela thread leitora).
+/// @return false se não for um desses comandos.
+static bool moverAoVivo(const string& linha) {
+    istringstream entrada(linha);
+    string comando;
+    entrada >> comando;
+    if (comando == "MOVER") {
+        Ponto alvo;
+        if (entrada >> alvo.x >> alvo.y >> alvo.z) canal.moverAlvo(alvo);
+        else cerr << "ERRO MOVER espera x y z" << endl;
+        return true;
+    }
+    if (comando == "MOVER_OBSTACULO") {
+        Obstaculo obs;
+        if (entrada >> obs.x >> obs.y >> obs.z >> obs.raio) canal.moverObstaculo(obs);
+        else cerr << "ERRO MOVER_OBSTACULO espera x y z r" << endl;
+        return true;
+    }
+    return false;
+}
+
+/// @brief Lê o stdin linha a linha e enfileira os comandos. O fim da entrada vira SAIR.
+/// As mudanças ao vivo entram no canal e na fila só como aviso (para acordar um servidor
+/// parado), sem interromper a evolução.
+static void lerComandos() {
+    string linha;
+    while (getline(cin, linha)) {
+        if (linha.empty()) continue;
+        bool aoVivo = moverAoVivo(linha);
+        lock_guard<mutex> trava(mutexComandos);
+        filaComandos.push_back(aoVivo ? "MOVIDO" : linha);
+        if (!aoVivo) comandoPendente = true;
+        comandoChegou.notify_one();
+    }
+    lock_guard<mutex> trava(mutexComandos);
+    filaComandos.push_back("SAIR");
+    comandoPendente = true;
+    comandoChegou.notify_one();
+}
+
+/// @brief Retira todos os comandos da fila.
+/// @param esperar Se true, bloqueia até chegar pelo menos um comando.
+static deque<string> retirarComandos(bool esperar) {
+    unique_lock<mutex> trava(mutexComandos);
+    if (esperar) comandoChegou.wait(trava, [] { return !filaComandos.empty(); });
+    deque<string> comandos;
+    comandos.swap(filaComandos);
+    comandoPendente = false;
+    return comandos;
+}
+
+/// @brief Laço do modo servidor (ver Servidor.h).
+///
+/// A evolução do alvo atual roda na thread principal até chegar um comando; então
+/// todos os comandos pendentes são aplicados de uma vez e a evolução recomeça,
+/// aquecida pela população anterior.
+///
+/// @param protocolo Protocolo dos quadros enviados ao simulador.
+/// @return Código de saída do programa.
+int executarServidor(ProtocoloSaida protocolo) {
+    definirSemente(c.semente);
+    inicializarParalelismo(c.nThreads);
+    configurarSaida(protocolo);
+
+    thread leitor(lerComandos);
+    leitor.detach();
+
+    Ponto alvo = {0.0, 0.0, 0.0};
+    bool temAlvo = false;
+    bool concluido = false; // o alvo atual já terminou por um critério de parada (SOLVED/GAVE_UP)
+
+    while (true) {
+        for (const string& linha : retirarComandos(!temAlvo || concluido)) {
+            istringstream entrada(linha);
+            string comando;
+            entrada >> comando;
+
+            // Mudança ao vivo que a evolução em andamento não chegou a aplicar (ela tinha
+            // terminado ou não havia alvo): vale para a próxima, aquecida
+            if (comando == "MOVIDO") {
+                if (!canal.pendente()) continue;
+                if (canal.aplicar(alvo) & REPLANEJAR_ALVO) temAlvo = true;
+                concluido = false;
+                continue;
+            }
+
+            // Qualquer comando válido pode mudar o problema: o alvo atual volta a ser buscado
+            concluido = false;
+            if (comando == "ALVO") {
+                Ponto novo;
+                if (entrada >> novo.x >> novo.y >> novo.z) {
+                    alvo = novo;
+                    temAlvo = true;
+                } else {
+                    cerr << "ERRO ALVO espera x y z" << endl;
+                }
+            } else if (comando == "OBSTACULO") {
+                Obstaculo obs;
+                if (entrada >> obs.x >> obs.y >> obs.z >> obs.raio) c.bolaDeDemolicao = obs;
+                else cerr << "ERRO OBSTACULO espera x y z r" << endl;
+            } else if (comando == "CONFIG") {
+                string chave, valor;
+                entrada >> chave >> valor;
+                int threadsAntes = c.nThreads;
+                if (chave == "nWaypoints" && !trajetoriaCabeNaSaida(atoi(valor.c_str()))) {
+                    // O anel de memória compartilhada não cresce: a trajetória deixaria de chegar
+                    cerr << "ERRO CONFIG nWaypoints " << valor << " excede o slot da memoria compartilhada" << endl;
+                } else if (!definirConfig(chave, valor)) {
+                    cerr << "ERRO CONFIG " << chave << " " << valor << endl;
+                } else if (chave == "semente") {
+                    definirSemente(c.semente);
+                } else if (c.nThreads != threadsAntes) {
+                    inicializarParalelismo(c.nThreads);
+                }
+            } else if (comando == "PARAR") {
+                temAlvo = false;
+            } else if (comando == "SAIR") {
+                return 0;
+            } else {
+                cerr << "ERRO comando desconhecido: " << linha << endl;
+            }
+        }
+
+        // Roda até o próximo comando ou um critério de parada (a população continua viva
+        // para o próximo alvo); os limites são relidos porque CONFIG pode tê-los mudado
+        if (temAlvo) {
+            LimitesExecucao lim = limitesDaConfig();
+            lim.interromper = &comandoPendente;
+            lim.replanejamento = &canal;
+            concluido = executarEvolucao(alvo, lim, true).desfecho != DESFECHO_INTERROMPIDO;
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "Saida.h"
+
+// Modo servidor: um único processo atende vários alvos seguidos, lendo comandos do stdin
+// (uma linha por comando) e mantendo a população viva entre eles:
+//   ALVO x y z            começa (ou troca) o alvo; a população anterior aquece o novo
+//   OBSTACULO x y z r     troca o obstáculo (r = 0 remove) e reavalia o alvo atual
+//   MOVER x y z           move o alvo sem interromper a busca: a população inteira continua,
+//                         reavaliada contra o alvo novo (replanejamento ao vivo, ver CanalReplanejamento)
+//   MOVER_OBSTACULO x y z r  move o obstáculo do mesmo jeito
+//   CONFIG chave valor    altera um campo de Config (ver definirConfig)
+//   PARAR                 suspende a evolução até o próximo ALVO
+//   SAIR                  encerra o processo (o fim do stdin tem o mesmo efeito)
+// Quando um critério de parada de Config encerra a busca (SOLVED/GAVE_UP), o processo fica
+// parado até o próximo comando (um MOVER então recomeça a busca, aquecida). Com
+// CONFIG prazoGeracaoMs N cada geração cabe em N ms, e a trajetória melhor sai na geração
+// em que aparece. Os quadros de saída seguem o protocolo escolhido; erros vão
+// para o stderr.
+int executarServidor(ProtocoloSaida protocolo);
+
+#endif
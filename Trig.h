@@ -0,0 +1,54 @@
+#ifndef TRIG_H
+#define TRIG_H
+
+#include <cmath>
+
+// Seno e cosseno do modo de cinemática rápida (Config::_trig = "_trig_rapida").
+//
+// Redução ao quadrante mais próximo (resto em [-pi/4, pi/4]) e polinômios minimax de grau
+// 9 (seno) e 10 (cosseno) ajustados nesse intervalo. Metade dos termos dos polinômios do
+// kernel em lote (Cephes) e nenhum desvio além da escolha do quadrante. A mesma sequência
+// de operações está em sincosRapidoLote (LoteKernel.h), então o lote SIMD e o caminho
+// escalar dão resultados idênticos nesse modo.
+//
+// Válido para |x| até ~1e6 radianos (a cinemática usa no máximo alguns múltiplos de 2pi).
+
+// Erro absoluto máximo de sincosRapido em relação a std::sin/std::cos (o benchmark mede e
+// compara com este valor). Com ângulos exatos, o erro de posição de uma junta fica abaixo
+// de ERRO_TRIG_RAPIDA vezes a soma dos comprimentos dos segmentos anteriores.
+const double ERRO_TRIG_RAPIDA = 3e-12;
+
+// Coeficientes (ver sincosRapido)
+const double TRIG_DOIS_SOBRE_PI = 6.36619772367581382433e-01;
+const double TRIG_PI_2_A = 1.57079632673412561417e+00; // 33 bits: q * TRIG_PI_2_A é exato
+const double TRIG_PI_2_B = 6.07710050650619224932e-11;
+const double TRIG_S1 = -1.66666666281144321e-01;
+const double TRIG_S2 = 8.33332824772304442e-03;
+const double TRIG_S3 = -1.98390459339243402e-04;
+const double TRIG_S4 = 2.71603039411183572e-06;
+const double TRIG_C1 = 4.16666666240298050e-02;
+const double TRIG_C2 = -1.38888838437130542e-03;
+const double TRIG_C3 = 2.47995411716403042e-05;
+const double TRIG_C4 = -2.72118127433066094e-07;
+
+/// @brief Seno e cosseno de x (radianos) com erro absoluto até ERRO_TRIG_RAPIDA.
+inline void sincosRapido(double x, double& seno, double& cosseno) {
+    // Quadrante q (arredondado, meio para longe de zero) e resto r = x - q * pi/2. O
+    // truncamento passa por inteiro (std::trunc sem SSE4.1 vira chamada de biblioteca)
+    long long qi = (long long)(x * TRIG_DOIS_SOBRE_PI + (x < 0.0 ? -0.5 : 0.5));
+    double q = (double)qi;
+    double r = (x - q * TRIG_PI_2_A) - q * TRIG_PI_2_B;
+    int n = (int)(qi & 3);
+
+    double u = r * r;
+    double ps = r + r * u * (TRIG_S1 + u * (TRIG_S2 + u * (TRIG_S3 + u * TRIG_S4)));
+    double pc = (1.0 - 0.5 * u) + u * u * (TRIG_C1 + u * (TRIG_C2 + u * (TRIG_C3 + u * TRIG_C4)));
+
+    // Quadrantes ímpares trocam os polinômios; o seno é negativo em 2 e 3, o cosseno em 1 e 2.
+    // Tabela em vez de desvios: com ângulos aleatórios o quadrante não é previsível
+    double quadrantes[4] = {ps, pc, 0.0 - ps, 0.0 - pc};
+    seno = quadrantes[n];
+    cosseno = quadrantes[(n + 1) & 3];
+}
+
+#endif
@@ -14,16 +14,49 @@ struct Obstaculo {
     double x, y, z, raio;
 };
 
-// Estrutura do Indivíduo
+// Linha da tabela de Denavit–Hartenberg de uma junta rotativa (ângulos em graus).
+// Ângulo da junta = sinal * comando + offset; depois translada d em z, a em x e gira alfa em x.
+struct LinhaDH {
+    double a, alfa, d, offset, sinal;
+};
+
+// Obstáculo em forma de caixa alinhada aos eixos
+struct Caixa {
+    double min[3];
+    double max[3];
+};
+
+// Resultado da avaliação de um genoma
+struct Avaliacao {
+    double fitness;
+    int passoVitoria;
+    bool venceu;
+
+    Avaliacao() : fitness(-1e9), passoVitoria(0), venceu(false) {}
+};
+
+// Estrutura do Indivíduo isolado (usada para o melhor global; a população usa Populacao)
+// O genoma é linear: a velocidade da junta j no waypoint g está em genoma[g * nJuntas + j]
+// (com Config::_gen = "_gen_spline", o ponto de controle g dessas velocidades; ver Genoma.h)
 struct Individuo {
-    vector<vector<double>> genoma;
+    vector<double> genoma;
     double fitness;
     int passoVitoria;
     bool venceu;
     vector<Ponto> trajetoria;
     
     Individuo() : fitness(-1e9), passoVitoria(0), venceu(false) {}
-    Individuo(vector<vector<double>> g) : genoma(g), fitness(-1e9), passoVitoria(0), venceu(false) {}
+    Individuo(vector<double> g) : genoma(g), fitness(-1e9), passoVitoria(0), venceu(false) {}
+};
+
+// Estado adaptativo da evolução (contador de gerações, estagnação e agressividade da mutação)
+struct EstadoEvolutivo {
+    int geracao;
+    int estagAtual;
+    double incAtual;
+    int ilha; // dona do estado no modo de ilhas (0 com população única); separa o fluxo da seleção
+
+    EstadoEvolutivo() : geracao(0), estagAtual(0), incAtual(0.0), ilha(0) {}
 };
 
 #endif
\ No newline at end of file
@@ -1,39 +1,184 @@
 #include "Utils.h"
+#include <cmath>
 
 // Definição das variáveis globais
-std::mt19937 rng(std::random_device{}());
-int estagAtual = 0;
-double incAtual = 0.0;
+unsigned int sementeBase = 0;
+
+// Mistura de 64 bits (SplitMix64) usada para derivar sementes independentes
+static unsigned long long misturar(unsigned long long x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Define a semente da execução (0 = sorteia uma a partir do dispositivo aleatório)
+void definirSemente(unsigned int semente) {
+    if (semente == 0) semente = std::random_device{}();
+    sementeBase = semente;
+}
+
+// Posiciona o gerador no fluxo identificado por (geracao, indice, fluxo): só o contador muda
+void reposicionarGerador(Gerador& rng, int geracao, int indice, FluxoAleatorio fluxo) {
+    rng.posicionar(misturar(sementeBase), (uint32_t)indice, (uint32_t)geracao, (uint32_t)fluxo);
+}
 
 // Altera o incremento da mutação baseado na estagnação
-void alterarIncrementoDaMutacaoAtual(bool resetar) {
+void alterarIncrementoDaMutacaoAtual(EstadoEvolutivo& est, bool resetar) {
     if (resetar){ 
-        incAtual = 0;
-        estagAtual = 0;
+        est.incAtual = 0;
+        est.estagAtual = 0;
     }
-    else incAtual++;
+    else est.incAtual++;
+}
+
+// Real uniforme em [0, 1) com 53 bits a partir de duas palavras de 32
+static inline double uniforme53(uint32_t a, uint32_t b) {
+    return ((a >> 5) * 67108864.0 + (b >> 6)) * (1.0 / 9007199254740992.0);
+}
+
+// Inteiro uniforme em [0, n) pela multiplicação de Lemire: sem divisão, salvo na rara rejeição
+static inline uint32_t limitar(Gerador& rng, uint32_t x, uint32_t n) {
+    uint64_t m = (uint64_t)x * n;
+    uint32_t baixo = (uint32_t)m;
+    if (baixo < n) {
+        uint32_t limiar = (0u - n) % n;
+        while (baixo < limiar) {
+            m = (uint64_t)rng() * n;
+            baixo = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
 }
 
 // Escolhe um número real aleatório entre min e max
-double escolherNumReal(double min, double max) {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(rng);
+double escolherNumReal(Gerador& rng, double min, double max) {
+    uint32_t a = rng();
+    return min + uniforme53(a, rng()) * (max - min);
 }
 
-// Escolhe 'true' com probabilidade 'prob', 'false' caso contrário
-bool escolherZeroUm(double prob) {
-    std::bernoulli_distribution d(prob);
-    return d(rng);
+// Escolhe 'true' com probabilidade 'prob', 'false' caso contrário (resolução de 2^-32, uma palavra)
+bool escolherZeroUm(Gerador& rng, double prob) {
+    return rng() < prob * 4294967296.0;
 }
 
-// Escolhe um índice baseado em uma lista de probabilidades
-int escolherIndiceDeProbabilidades(const std::vector<double>& probs) {
-    std::discrete_distribution<int> d(probs.begin(), probs.end());
-    return d(rng);
+// Escolhe um índice baseado em uma lista de pesos (não precisam somar 1), sem alocar memória
+int escolherIndiceDeProbabilidades(Gerador& rng, const std::vector<double>& probs) {
+    double soma = 0.0;
+    for (double p : probs) soma += p;
+
+    double sorteio = escolherNumReal(rng, 0.0, soma);
+    int n = (int)probs.size();
+    for (int i = 0; i < n; i++) {
+        sorteio -= probs[i];
+        if (sorteio < 0.0) return i;
+    }
+    return n - 1;
 }
 
 // Escolhe um índice aleatório entre 0 e size-1
-int escolherIndiceDeLista(int size) {
-    std::uniform_int_distribution<int> d(0, size - 1);
-    return d(rng);
+int escolherIndiceDeLista(Gerador& rng, int size) {
+    return (int)limitar(rng, rng(), (uint32_t)size);
+}
+
+// Preenche 'n' reais uniformes em [min, max). Os blocos inteiros do gerador vão direto para
+// o destino; as palavras que sobraram de um sorteio anterior são usadas antes
+void preencherUniformes(Gerador& rng, double* destino, int n, double min, double max) {
+    double largura = max - min;
+    int i = 0;
+    while (i < n && rng.pendentes() >= 2) {
+        uint32_t a = rng();
+        destino[i++] = min + uniforme53(a, rng()) * largura;
+    }
+    uint32_t bloco[4];
+    for (; i + 2 <= n; i += 2) {
+        rng.gerarBloco(bloco);
+        destino[i] = min + uniforme53(bloco[0], bloco[1]) * largura;
+        destino[i + 1] = min + uniforme53(bloco[2], bloco[3]) * largura;
+    }
+    if (i < n) destino[i] = escolherNumReal(rng, min, max);
+}
+
+// Preenche 'n' índices uniformes em [0, size)
+void preencherIndices(Gerador& rng, int* destino, int n, int size) {
+    int i = 0;
+    while (i < n && rng.pendentes() > 0) destino[i++] = escolherIndiceDeLista(rng, size);
+    uint32_t bloco[4];
+    for (; i + 4 <= n; i += 4) {
+        rng.gerarBloco(bloco);
+        for (int j = 0; j < 4; j++) destino[i + j] = (int)limitar(rng, bloco[j], (uint32_t)size);
+    }
+    for (; i < n; i++) destino[i] = escolherIndiceDeLista(rng, size);
+}
+
+// Box–Muller: cada par de uniformes (u1, u2) vira o par r cos(2 pi u2), r sin(2 pi u2), com
+// r = sqrt(-2 ln u1) e u1 em (0, 1]. Com 'n' ímpar o último par sorteado perde o seno
+void preencherNormais(Gerador& rng, double* destino, int n) {
+    const double doisPi = 6.283185307179586;
+    preencherUniformes(rng, destino, n, 0.0, 1.0);
+    for (int i = 0; i < n; i += 2) {
+        double u1 = 1.0 - destino[i];
+        double u2 = i + 1 < n ? destino[i + 1] : escolherNumReal(rng, 0.0, 1.0);
+        double r = std::sqrt(-2.0 * std::log(u1));
+        destino[i] = r * std::cos(doisPi * u2);
+        if (i + 1 < n) destino[i + 1] = r * std::sin(doisPi * u2);
+    }
+}
+
+// Algoritmo de Floyd: para j de n-k a n-1, sorteia t em [0, j]; se t já saiu, fica j (que
+// ainda não pode ter saído). Cada subconjunto de tamanho k tem a mesma probabilidade
+void sortearSemRepeticao(Gerador& rng, int n, int k, int* destino, unsigned char* marcas) {
+    if (k > n) k = n;
+    int m = 0;
+    for (int j = n - k; j < n; j++) {
+        int t = escolherIndiceDeLista(rng, j + 1);
+        if (marcas[t]) t = j;
+        marcas[t] = 1;
+        destino[m++] = t;
+    }
+    for (int i = 0; i < m; i++) marcas[destino[i]] = 0;
+}
+
+
+// Monta a tabela de alias a partir de pesos não negativos (não precisam somar 1)
+void TabelaAlias::construir(const std::vector<double>& pesos) {
+    int n = (int)pesos.size();
+    prob.resize(n);
+    alias.resize(n);
+    escalado.resize(n);
+    pequenos.clear();
+    grandes.clear();
+
+    double soma = 0.0;
+    for (double p : pesos) soma += p;
+
+    for (int i = 0; i < n; i++) {
+        escalado[i] = soma > 0.0 ? pesos[i] * n / soma : 1.0;
+        alias[i] = i;
+        if (escalado[i] < 1.0) pequenos.push_back(i);
+        else grandes.push_back(i);
+    }
+
+    // Cada coluna pequena é completada com a sobra de uma coluna grande
+    while (!pequenos.empty() && !grandes.empty()) {
+        int p = pequenos.back(); pequenos.pop_back();
+        int g = grandes.back();
+        prob[p] = escalado[p];
+        alias[p] = g;
+        escalado[g] = (escalado[g] + escalado[p]) - 1.0;
+        if (escalado[g] < 1.0) {
+            grandes.pop_back();
+            pequenos.push_back(g);
+        }
+    }
+
+    // O que sobrou (por arredondamento) fica com probabilidade 1
+    for (int g : grandes) prob[g] = 1.0;
+    for (int p : pequenos) prob[p] = 1.0;
+}
+
+// Sorteia um índice: escolhe uma coluna e decide entre ela e o seu alias
+int TabelaAlias::sortear(Gerador& rng) const {
+    int coluna = escolherIndiceDeLista(rng, (int)prob.size());
+    return escolherNumReal(rng, 0.0, 1.0) < prob[coluna] ? coluna : alias[coluna];
 }
\ No newline at end of file
@@ -1,21 +1,128 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "Types.h"
 #include <vector>
 #include <random>
+#include <cstdint>
 
-// Variáveis Globais de Estado
-extern std::mt19937 rng;
-extern int estagAtual;
-extern double incAtual;
+/// @brief Gerador pseudoaleatório baseado em contador (Philox4x32-10, Salmon et al. 2011).
+///
+/// A saída é uma função pura de (chave, contador): cada bloco de 4 palavras de 32 bits é
+/// o contador cifrado com a chave em 10 rodadas. A chave vem da semente e o contador é
+/// (bloco, indivíduo, geração, fluxo), então posicionar o gerador em qualquer fluxo custa
+/// só a escrita do contador, sem estado a inicializar, e cada trabalhador pode gerar o
+/// fluxo de qualquer indivíduo de forma independente. Satisfaz UniformRandomBitGenerator.
+class Gerador {
+public:
+    typedef uint32_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
 
-// Funções Auxiliares
-double escolherNumReal(double min, double max);
-bool escolherZeroUm(double prob);
-int escolherIndiceDeProbabilidades(const std::vector<double>& probs);
-int escolherIndiceDeLista(int size);
+    Gerador() { posicionar(0, 0, 0, 0); }
+
+    // Bloco 'bloco' (0 = início) do fluxo (indice, geracao, fluxo) da semente 'chave'
+    void posicionar(uint64_t chave, uint32_t indice, uint32_t geracao, uint32_t fluxo, uint32_t bloco = 0) {
+        k[0] = (uint32_t)chave;
+        k[1] = (uint32_t)(chave >> 32);
+        contador[0] = bloco;
+        contador[1] = indice;
+        contador[2] = geracao;
+        contador[3] = fluxo;
+        usadas = 4;
+    }
+
+    result_type operator()() {
+        if (usadas == 4) gerarBloco(saida);
+        return saida[usadas++];
+    }
+
+    // Próximo bloco inteiro (4 palavras), sem passar pelo buffer de saída
+    void gerarBloco(uint32_t* destino) {
+        uint32_t x[4] = {contador[0], contador[1], contador[2], contador[3]};
+        uint32_t chave[2] = {k[0], k[1]};
+        for (int r = 0; r < 10; r++) {
+            if (r > 0) {
+                chave[0] += 0x9E3779B9u;
+                chave[1] += 0xBB67AE85u;
+            }
+            uint64_t p0 = (uint64_t)0xD2511F53u * x[0];
+            uint64_t p1 = (uint64_t)0xCD9E8D57u * x[2];
+            uint32_t y0 = (uint32_t)(p1 >> 32) ^ x[1] ^ chave[0];
+            uint32_t y2 = (uint32_t)(p0 >> 32) ^ x[3] ^ chave[1];
+            x[0] = y0;
+            x[1] = (uint32_t)p1;
+            x[2] = y2;
+            x[3] = (uint32_t)p0;
+        }
+        for (int i = 0; i < 4; i++) destino[i] = x[i];
+        contador[0]++;
+        if (destino == saida) usadas = 0;
+    }
+
+    // Palavras ainda não consumidas do último bloco
+    int pendentes() const { return 4 - usadas; }
+
+private:
+    uint32_t k[2];
+    uint32_t contador[4];
+    uint32_t saida[4];
+    int usadas;
+};
+
+// Fluxos independentes usados em cada etapa da evolução
+enum FluxoAleatorio {
+    FLUXO_INICIAL = 0,
+    FLUXO_FILHO = 1,
+    FLUXO_CATASTROFE = 2,
+    FLUXO_SELECAO = 3,
+    FLUXO_AQUECIMENTO = 4,
+    FLUXO_MIGRACAO = 5,
+    FLUXO_BUSCA_LOCAL = 6
+};
+
+// Semente base da execução (definida em definirSemente)
+extern unsigned int sementeBase;
+
+void definirSemente(unsigned int semente);
+void reposicionarGerador(Gerador& rng, int geracao, int indice, FluxoAleatorio fluxo);
+
+// Funções Auxiliares. Não usam as distribuições da biblioteca padrão, cujos algoritmos
+// variam entre implementações: com a mesma semente o resultado é o mesmo em qualquer compilador.
+double escolherNumReal(Gerador& rng, double min, double max);
+bool escolherZeroUm(Gerador& rng, double prob);
+int escolherIndiceDeProbabilidades(Gerador& rng, const std::vector<double>& probs);
+int escolherIndiceDeLista(Gerador& rng, int size);
+
+// Geração em bloco: preenche 'n' valores de uma vez, dois doubles ou quatro inteiros por bloco do gerador
+void preencherUniformes(Gerador& rng, double* destino, int n, double min, double max);
+void preencherIndices(Gerador& rng, int* destino, int n, int size);
+
+// Preenche 'n' valores da normal padrão N(0, 1) por Box–Muller sobre preencherUniformes (um par por dois uniformes)
+void preencherNormais(Gerador& rng, double* destino, int n);
+
+/// Sorteia k índices distintos de [0, n) sem embaralhar os n (algoritmo de Floyd: k sorteios).
+/// 'marcas' tem n posições zeradas na entrada e volta zerado; a ordem de 'destino' não é aleatória.
+void sortearSemRepeticao(Gerador& rng, int n, int k, int* destino, unsigned char* marcas);
+
+/// @brief Tabela de alias (Walker/Vose) para sortear índices com pesos arbitrários.
+///
+/// Construída em O(n) e sorteada em O(1). Os buffers são reaproveitados entre
+/// construções, então reconstruir a cada geração não aloca memória.
+struct TabelaAlias {
+    std::vector<double> prob;
+    std::vector<int> alias;
+
+    void construir(const std::vector<double>& pesos);
+    int sortear(Gerador& rng) const;
+    int tamanho() const { return (int)prob.size(); }
+
+private:
+    std::vector<double> escalado;
+    std::vector<int> pequenos, grandes;
+};
 
 // Função que controla a agressividade da mutação
-void alterarIncrementoDaMutacaoAtual(bool resetar);
+void alterarIncrementoDaMutacaoAtual(EstadoEvolutivo& est, bool resetar);
 
-#endif
\ No newline at end of file
+#endif
@@ -1,30 +1,39 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 
 #include "Types.h"
 #include "Config.h"
 #include "Utils.h"
 #include "Robot.h"
-#include "Evolution.h"
+#include "Paralelo.h"
+#include "Execucao.h"
+#include "Saida.h"
+#include "Servidor.h"
+#include "CacheSolucoes.h"
+#include "MapaColisao.h"
+#include "Cena.h"
+#include "Braco.h"
+#include "Planejador.h"
 
 using namespace std;
 
-// Variável para armazenar o melhor global
-Individuo melhorGeral;
-
 /// @brief Gera um ponto alvo aleatório que seja fisicamente alcançável pelo robô.
 /// 
 /// Sorteia ângulos aleatórios para cada junta (respeitando os limites min/max definidos no Config.h)
 /// e converte esses ângulos para uma coordenada cartesiana (X, Y, Z) usando a Cinemática Direta.
 ///
+/// @param rng Gerador usado no sorteio dos ângulos.
 /// @return Um objeto do tipo 'Ponto' contendo as coordenadas do alvo gerado.
-Ponto gerarAlvoAleatorio() {
+Ponto gerarAlvoAleatorio(Gerador& rng) {
     vector<double> angulosValidos;
     
     // Gera um ângulo aleatório para cada junta respeitando os limites do Config.h
     for (int i = 0; i < c.nJuntas; i++) {
-        double angulo = escolherNumReal(c.baseLmin[i], c.baseLmax[i]);
+        double angulo = escolherNumReal(rng, c.baseLmin[i], c.baseLmax[i]);
         angulosValidos.push_back(angulo);
     }
 
@@ -33,101 +42,319 @@ Ponto gerarAlvoAleatorio() {
     return alvoGerado;
 }
 
-/// @brief Imprime a trajetória do melhor indivíduo no formato esperado pelo script Python.
-void imprimirTrajetoria() {
-    cout << "START_PATH" << endl;
-    for(int i = 0; i < melhorGeral.trajetoria.size(); i++) {
-        Ponto p = melhorGeral.trajetoria[i];
-        cout << p.x << " " << p.y << " " << p.z << endl;
-    }
-    cout << "END_PATH" << endl;
-    cout.flush();
+/// @brief Mostra as opções de linha de comando.
+void imprimirUso(const char* programa) {
+    cerr << "Uso:\n"
+         << "  " << programa << " x y z [semente] [--protocolo texto|binario|shm]\n"
+         << "                            modo visual\n"
+         << "  " << programa << " --servidor [--protocolo texto|binario|shm]\n"
+         << "                            processo persistente; comandos no stdin (ver Servidor.h)\n"
+         << "  " << programa << " --headless [opcoes]  mede desempenho sem visualizacao\n"
+         << "Opcoes do modo headless:\n"
+         << "  --alvo x y z          alvo a resolver (pode repetir; padrao 20 0 0)\n"
+         << "  --semente N           semente fixa (padrao: Config::semente)\n"
+         << "  --geracoes N          limite de geracoes por alvo\n"
+         << "  --tempo S             limite de tempo (segundos) por alvo\n"
+         << "  --parar-na-vitoria    encerra o alvo na primeira vitoria\n"
+         << "  --apos-vitoria K      encerra K geracoes sem avanco depois da primeira vitoria\n"
+         << "  --plato N             encerra se o melhor nao subir toleranciaPlato em N geracoes\n"
+         << "  --max-avaliacoes N    limite de avaliacoes por alvo\n"
+         << "  --pop-adaptativa      populacao encolhe a cada avanco do melhor e volta na estagnacao\n"
+         << "  --ik                  semeia a populacao com trajetorias de cinematica inversa\n"
+         << "  --local nome          busca local nos melhores: _loc_coord, _loc_es ou _loc_off\n"
+         << "  --aquecer             cada alvo parte da populacao do alvo anterior\n"
+         << "  --obstaculo x y z r   substitui o obstaculo (r = 0 remove)\n"
+         << "  --cena arquivo        acrescenta os obstaculos do arquivo (ver Cena.h)\n"
+         << "  --sem-varredura       desliga o teste continuo de colisao entre waypoints\n"
+         << "  --mapa                usa o mapa de colisao no espaco das juntas (ver MapaColisao.h)\n"
+         << "  --exportar-campo arq  grava o campo de distancia a colisao da cena (liga o mapa)\n"
+         << "  --braco nome          _braco_3r (padrao), _braco_4r, _braco_6r ou _braco_7r\n"
+         << "  --genoma nome         _gen_vel (padrao, uma velocidade por waypoint) ou _gen_spline\n"
+         << "                        (pontos de controle de uma B-spline das velocidades)\n"
+         << "  --controles N         pontos de controle por junta com _gen_spline (padrao 8)\n"
+         << "  --threads N           quantidade de threads (0 = todos os nucleos)\n"
+         << "  --trig nome           _trig_exata (padrao) ou _trig_rapida (seno/cosseno polinomial)\n"
+         << "  --ilhas K             divide a populacao em K ilhas (modelo de ilhas)\n"
+         << "  --migracao nome       _mig_anel (padrao), _mig_total ou _mig_aleatoria\n"
+         << "  --cache arquivo       usa (e alimenta) o cache de solucoes\n"
+         << "  --checkpoint arq      grava o estado a cada Config::intervaloCheckpoint geracoes\n"
+         << "  --intervalo-checkpoint N\n"
+         << "                        geracoes entre dois checkpoints (padrao 100)\n"
+         << "  --retomar             continua do checkpoint (mesmo alvo, cenario e opcoes)\n"
+         << "  --metricas            imprime METRICS <json> (tempo por fase, latencias, alocacoes)\n"
+         << "                        depois de cada RESULT\n"
+         << "  --prazo-geracao ms    prazo de cada geracao: a populacao encolhe para caber nele\n"
+         << "  --mover G x y z       move o alvo na geracao G (ou quando o segmento anterior parar),\n"
+         << "                        mantendo a populacao (replanejamento; pode repetir)\n"
+         << "  --mover-obstaculo G x y z r\n"
+         << "                        move o obstaculo na geracao G, do mesmo jeito\n"
+         << "  --lote arquivo        resolve em paralelo os alvos do arquivo (x y z [cena] por linha,\n"
+         << "                        ver Planejador.h) com os limites acima e imprime LOTE\n"
+         << "  --saida-lote arquivo  grava genoma, trajetoria e medidas de cada alvo do lote (binario)\n"
+         << "Nos modos visual e servidor o cache Config::arquivoCache e usado por padrao;\n"
+         << "  --cache arquivo troca o arquivo e --sem-cache o desativa; --cena arquivo\n"
+         << "  acrescenta obstaculos, --braco nome troca o braco e --metricas N envia as\n"
+         << "  metricas a cada N geracoes, junto do STATS. --checkpoint arq, --retomar e\n"
+         << "  --genoma nome valem tambem no modo visual.\n";
 }
 
-/// @brief Manda estatísticas da geração atual para o script Python.
-/// @param geracao Número da geração atual
-/// @param mediaFit Média de fitness da população na geração atual
-void imprimirEstatisticas(int geracao, double mediaFit) {
-    // Formato: STATS <geracao> <melhor_fit> <media_fit> <tamanho_trajetoria>
-    cout << "STATS " 
-         << geracao << " " 
-         << melhorGeral.fitness << " " 
-         << mediaFit << " " 
-         << melhorGeral.trajetoria.size() << endl;
+// Mudança agendada do modo headless (--mover, --mover-obstaculo)
+struct Movimento {
+    int geracao;
+    bool obstaculo;
+    Ponto alvo;
+    Obstaculo bola;
+};
+
+/// @brief Execução headless com mudanças agendadas: roda até a geração de cada mudança,
+/// deposita-a no canal de replanejamento e continua do estado guardado em memória, como um
+/// replanejamento ao vivo vindo de outra thread. Um segmento que para antes (vitória, platô)
+/// recebe a mudança ali mesmo. 'alvo' sai com o alvo final.
+static ResultadoExecucao executarComMovimentos(Ponto& alvo, const LimitesExecucao& lim, vector<Movimento> movimentos) {
+    stable_sort(movimentos.begin(), movimentos.end(),
+                [](const Movimento& a, const Movimento& b) { return a.geracao < b.geracao; });
+    EstadoLaco estado;
+    CanalReplanejamento canal;
+    LimitesExecucao parte = lim;
+    parte.estado = &estado;
+    parte.replanejamento = &canal;
+
+    size_t k = 0;
+    while (k < movimentos.size() && (lim.maxGeracoes <= 0 || movimentos[k].geracao < lim.maxGeracoes)) {
+        int geracao = movimentos[k].geracao;
+        if (geracao > (estado.valido ? estado.quadro.est.geracao : 0)) {
+            parte.maxGeracoes = geracao;
+            executarEvolucao(estado.valido ? estado.alvo : alvo, parte);
+        }
+        for (; k < movimentos.size() && movimentos[k].geracao == geracao; k++) {
+            if (movimentos[k].obstaculo) canal.moverObstaculo(movimentos[k].bola);
+            else canal.moverAlvo(movimentos[k].alvo);
+        }
+    }
+    parte.maxGeracoes = lim.maxGeracoes;
+    ResultadoExecucao res = executarEvolucao(estado.valido ? estado.alvo : alvo, parte);
+    if (estado.valido) alvo = estado.alvo;
+    return res;
 }
 
-/// @brief Imprime as informações do obstáculo no formato esperado pelo script Python.
-void imprimirObstaculo() {
-    cout << "OBSTACLE "
-         << c.bolaDeDemolicao.x << " "
-         << c.bolaDeDemolicao.y << " "
-         << c.bolaDeDemolicao.z << " "
-         << c.bolaDeDemolicao.raio << endl;
+/// @brief Modo lote do headless: resolve todos os alvos do arquivo e reporta a vazão.
+/// @return Código de saída do programa.
+int executarLote(const string& arquivoLote, const string& saidaLote, const LimitesExecucao& lim, bool metricas) {
+    vector<TarefaLote> tarefas;
+    if (!lerTarefasLote(arquivoLote, tarefas)) {
+        cerr << "Erro: arquivo de alvos " << arquivoLote << " nao lido ou invalido" << endl;
+        return 1;
+    }
+    if (c.nIlhas > 1) cerr << "AVISO modelo de ilhas nao se aplica ao lote; cada alvo usa uma populacao" << endl;
+
+    definirSemente(c.semente);
+    vector<SolucaoLote> solucoes;
+    ResumoLote resumo = resolverLote(tarefas, lim, solucoes);
+    if (!saidaLote.empty() && !gravarSolucoesLote(saidaLote, tarefas, solucoes)) {
+        cerr << "Erro: solucoes do lote nao gravadas em " << saidaLote << endl;
+        return 1;
+    }
+
+    double segundos = resumo.segundos > 0 ? resumo.segundos : 1e-9;
+    cout << "LOTE alvos=" << resumo.alvos
+         << " resolvidos=" << resumo.resolvidos
+         << " avaliacoes=" << resumo.avaliacoes
+         << " segundos=" << resumo.segundos
+         << " nucleos=" << resumo.nucleos
+         << " roubos=" << resumo.roubos
+         << " alvos_por_s=" << resumo.alvos / segundos
+         << " resolvidos_por_s_por_nucleo=" << resumo.resolvidos / segundos / resumo.nucleos
+         << endl;
+    if (metricas) imprimirMetricas();
+    return 0;
 }
 
-int main(int argc, char* argv[]) {
-    double tx = 20.0, ty = 0.0, tz = 0.0;
-    if (argc >= 4) {
-        tx = atof(argv[1]);
-        ty = atof(argv[2]);
-        tz = atof(argv[3]);
+/// @brief Modo headless: resolve uma lista de alvos sem streaming e reporta o desempenho.
+/// @return Código de saída do programa.
+int executarHeadless(int argc, char* argv[]) {
+    vector<Ponto> alvos;
+    LimitesExecucao lim;
+    lim.streaming = false;
+    bool aquecer = false;
+    bool metricas = false;
+    string arquivoCache;
+    string arquivoCampo;
+    string arquivoLote, saidaLote;
+    vector<Movimento> movimentos;
+
+    for (int i = 2; i < argc; i++) {
+        string opcao = argv[i];
+        bool temValor = i + 1 < argc;
+        if (opcao == "--alvo" && i + 3 < argc) {
+            Ponto alvo = {atof(argv[i+1]), atof(argv[i+2]), atof(argv[i+3])};
+            alvos.push_back(alvo);
+            i += 3;
+        } else if (opcao == "--obstaculo" && i + 4 < argc) {
+            c.bolaDeDemolicao = {atof(argv[i+1]), atof(argv[i+2]), atof(argv[i+3]), atof(argv[i+4])};
+            i += 4;
+        } else if (opcao == "--semente" && temValor) {
+            c.semente = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        } else if (opcao == "--geracoes" && temValor) {
+            lim.maxGeracoes = atoi(argv[++i]);
+        } else if (opcao == "--tempo" && temValor) {
+            lim.maxSegundos = atof(argv[++i]);
+        } else if (opcao == "--threads" && temValor) {
+            c.nThreads = atoi(argv[++i]);
+        } else if (opcao == "--trig" && temValor) {
+            c._trig = argv[++i];
+        } else if (opcao == "--ilhas" && temValor && atoi(argv[i+1]) > 0) {
+            c.nIlhas = atoi(argv[++i]);
+        } else if (opcao == "--migracao" && temValor) {
+            c._mig = argv[++i];
+        } else if (opcao == "--parar-na-vitoria") {
+            lim.pararNaVitoria = true;
+        } else if (opcao == "--apos-vitoria" && temValor) {
+            lim.geracoesAposVitoria = atoi(argv[++i]);
+        } else if (opcao == "--plato" && temValor) {
+            lim.geracoesPlato = atoi(argv[++i]);
+            lim.toleranciaPlato = c.toleranciaPlato;
+        } else if (opcao == "--max-avaliacoes" && temValor) {
+            lim.maxAvaliacoes = atoll(argv[++i]);
+        } else if (opcao == "--pop-adaptativa") {
+            c._pop = "_pop_adaptativa";
+        } else if (opcao == "--ik") {
+            c._ik = "_ik_on";
+        } else if (opcao == "--local" && temValor) {
+            c._loc = argv[++i];
+        } else if (opcao == "--cena" && temValor) {
+            c.arquivoCena = argv[++i];
+        } else if (opcao == "--sem-varredura") {
+            c.varreduraContinua = false;
+        } else if (opcao == "--mapa") {
+            c._mapa = "_mapa_on";
+        } else if (opcao == "--exportar-campo" && temValor) {
+            c._mapa = "_mapa_on";
+            arquivoCampo = argv[++i];
+        } else if (opcao == "--braco" && temValor && selecionarBraco(argv[i+1])) {
+            i++;
+        } else if (opcao == "--genoma" && temValor && definirConfig("_gen", argv[i+1])) {
+            i++;
+        } else if (opcao == "--controles" && temValor && definirConfig("nControles", argv[i+1])) {
+            i++;
+        } else if (opcao == "--aquecer") {
+            aquecer = true;
+        } else if (opcao == "--cache" && temValor) {
+            arquivoCache = argv[++i];
+        } else if (opcao == "--checkpoint" && temValor) {
+            c.arquivoCheckpoint = argv[++i];
+        } else if (opcao == "--intervalo-checkpoint" && temValor && atoi(argv[i+1]) > 0) {
+            c.intervaloCheckpoint = atoi(argv[++i]);
+        } else if (opcao == "--retomar") {
+            c.retomarCheckpoint = true;
+        } else if (opcao == "--metricas") {
+            metricas = true;
+        } else if (opcao == "--prazo-geracao" && temValor) {
+            lim.prazoGeracao = atof(argv[++i]) / 1000.0;
+        } else if (opcao == "--mover" && i + 4 < argc) {
+            Movimento m = {atoi(argv[i+1]), false, {atof(argv[i+2]), atof(argv[i+3]), atof(argv[i+4])}, {0, 0, 0, 0}};
+            movimentos.push_back(m);
+            i += 4;
+        } else if (opcao == "--mover-obstaculo" && i + 5 < argc) {
+            Movimento m = {atoi(argv[i+1]), true, {0, 0, 0},
+                           {atof(argv[i+2]), atof(argv[i+3]), atof(argv[i+4]), atof(argv[i+5])}};
+            movimentos.push_back(m);
+            i += 5;
+        } else if (opcao == "--lote" && temValor) {
+            arquivoLote = argv[++i];
+        } else if (opcao == "--saida-lote" && temValor) {
+            saidaLote = argv[++i];
+        } else {
+            imprimirUso(argv[0]);
+            return 1;
+        }
     }
 
-    // Gera o ponto alvo
-    Ponto alvo = {tx, ty, tz};
+    if (alvos.empty()) alvos.push_back({20.0, 0.0, 0.0});
+    bool temParada = lim.maxGeracoes > 0 || lim.maxSegundos > 0 || lim.maxAvaliacoes > 0 || lim.pararNaVitoria ||
+                     lim.geracoesAposVitoria > 0 || lim.geracoesPlato > 0;
+    if (!temParada) lim.maxGeracoes = 500;
+
+    inicializarParalelismo(c.nThreads);
+    if (!arquivoCache.empty() && !cacheSolucoes.abrir(arquivoCache))
+        cerr << "AVISO nao foi possivel abrir o cache " << arquivoCache << endl;
+    if (!arquivoCampo.empty()) {
+        montarBraco();
+        montarCena();
+        prepararMapaColisao();
+        if (!mapaColisao.exportarCampo(arquivoCampo)) {
+            cerr << "Erro: campo de distancia nao exportado para " << arquivoCampo << endl;
+            return 1;
+        }
+    }
+
+    if (!arquivoLote.empty()) return executarLote(arquivoLote, saidaLote, lim, metricas);
+
+    for (Ponto alvo : alvos) {
+        // Cada alvo recomeça da mesma semente, para que a ordem da lista não importe
+        definirSemente(c.semente);
+        Obstaculo obstaculoOriginal = c.bolaDeDemolicao;
+        ResultadoExecucao res = movimentos.empty() ? executarEvolucao(alvo, lim, aquecer)
+                                                   : executarComMovimentos(alvo, lim, movimentos);
+        imprimirResultado("RESULT", alvo, res);
+        if (metricas) imprimirMetricas();
+        c.bolaDeDemolicao = obstaculoOriginal;
+    }
+    if (cacheSolucoes.aberto()) imprimirEstatisticasCache();
+    return 0;
+}
 
+int main(int argc, char* argv[]) {
     // Configurações e inicializações
     c.listaPNumGene.assign(c.nGenes, 1.0/c.nGenes);
     c.listaPCadaGene.assign(c.nGenes, 1.0/c.nGenes);
-    vector<Individuo> pop;
-    for(int i=0; i<c.nIndv; i++) pop.push_back(gerarIndividuo());
 
-    for(auto& ind : pop) calcularFitness(ind, alvo);
-    melhorGeral = pop[0];
-    int geracoes = 0;
-    imprimirObstaculo();
-    
-    // Loop Infinito: O programa roda até o Python matar o processo
-    while (true) {
-        int idxMelhorLocal = 0;
-        double somaFitness = 0.0;
-
-        // Avaliação da população
-        for(size_t i=0; i<pop.size(); i++) {
-            calcularFitness(pop[i], alvo);
-            somaFitness += pop[i].fitness;
-            if(pop[i].fitness > pop[idxMelhorLocal].fitness) idxMelhorLocal = i;
-        }
+    if (argc >= 2 && strcmp(argv[1], "--headless") == 0) return executarHeadless(argc, argv);
+    if (argc >= 2 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        imprimirUso(argv[0]);
+        return 0;
+    }
 
-        // Atualiza melhor local e global
-        Individuo& melhorLocal = pop[idxMelhorLocal];
-        double mediaFitness = somaFitness/c.nIndv;
+    // Argumentos posicionais (x y z [semente]) seguidos de opções
+    vector<string> posicionais;
+    ProtocoloSaida protocolo = PROTOCOLO_TEXTO;
+    bool servidor = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--protocolo") == 0 && i + 1 < argc) protocolo = protocoloDeNome(argv[++i]);
+        else if (strcmp(argv[i], "--servidor") == 0) servidor = true;
+        else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) c.arquivoCache = argv[++i];
+        else if (strcmp(argv[i], "--sem-cache") == 0) c.arquivoCache.clear();
+        else if (strcmp(argv[i], "--cena") == 0 && i + 1 < argc) c.arquivoCena = argv[++i];
+        else if (strcmp(argv[i], "--mapa") == 0) c._mapa = "_mapa_on";
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) c.arquivoCheckpoint = argv[++i];
+        else if (strcmp(argv[i], "--retomar") == 0) c.retomarCheckpoint = true;
+        else if (strcmp(argv[i], "--braco") == 0 && i + 1 < argc && selecionarBraco(argv[i+1])) i++;
+        else if (strcmp(argv[i], "--genoma") == 0 && i + 1 < argc && definirConfig("_gen", argv[i+1])) i++;
+        else if (strcmp(argv[i], "--metricas") == 0 && i + 1 < argc) c.intervaloMetricas = max(0, atoi(argv[++i]));
+        else posicionais.push_back(argv[i]);
+    }
 
-        if (melhorLocal.fitness > melhorGeral.fitness) {
-            melhorGeral = melhorLocal;
-            alterarIncrementoDaMutacaoAtual(true);
-        } else if(abs(melhorLocal.fitness - melhorGeral.fitness) < 0.5){
-            estagAtual++;
-            if (estagAtual > c.minEstag) alterarIncrementoDaMutacaoAtual(false);
-        }
+    // Soluções de execuções anteriores semeiam a população inicial
+    if (!c.arquivoCache.empty() && !cacheSolucoes.abrir(c.arquivoCache))
+        cerr << "AVISO nao foi possivel abrir o cache " << c.arquivoCache << endl;
+    if (servidor) return executarServidor(protocolo);
 
-        // Streaming de dados
-        if (geracoes % c.printGeracoes == 0) {
-            imprimirTrajetoria();
-            imprimirEstatisticas(geracoes, mediaFitness);
-        }
+    double tx = 20.0, ty = 0.0, tz = 0.0;
+    if (posicionais.size() >= 3) {
+        tx = atof(posicionais[0].c_str());
+        ty = atof(posicionais[1].c_str());
+        tz = atof(posicionais[2].c_str());
+    }
+    if (posicionais.size() >= 4) c.semente = (unsigned int)strtoul(posicionais[3].c_str(), nullptr, 10);
 
-        // Catastrófe
-        if (estagAtual > c.minEstagCat) {
-            alterarIncrementoDaMutacaoAtual(true);
-            pop = realizarCatastrofe(pop);
-            for(auto& ind : pop) calcularFitness(ind, alvo);
-        }
+    // Gera o ponto alvo
+    Ponto alvo = {tx, ty, tz};
 
-        // Seleção e Mutação
-        pop = selecaoPorRoleta(pop);
-        geracoes++;
-    }
+    definirSemente(c.semente);
+    inicializarParalelismo(c.nThreads);
+    configurarSaida(protocolo);
+
+    // Roda até um critério de parada de Config (SOLVED/GAVE_UP) ou até o Python matar o processo
+    executarEvolucao(alvo, limitesDaConfig());
 
     return 0;
 }
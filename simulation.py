@@ -9,16 +9,40 @@ import threading
 import queue
 import random
 import multiprocessing
+import struct
+import mmap
+import os
+import time
+import json
 
 # --- Configurações Físicas ---
 LINK_1 = 10.0
 LINK_2 = 10.0
 
+# --- Protocolo com o motor C++ ---
+# "binario": quadros binários pelo stdout (padrão)
+# "shm": quadros em memória compartilhada, lidos sem passar pelo pipe
+# "texto": protocolo de texto antigo (START_PATH / STATS / OBSTACLE)
+PROTOCOL = "binario"
+
+# Tipos de quadro binário (ver Saida.h)
+FRAME_OBSTACLE = 1
+FRAME_PATH = 2
+FRAME_STATS = 3
+FRAME_TARGET = 4
+FRAME_METRICS = 5
+FRAME_OUTCOME = 6
+FRAME_HEADER = struct.Struct('<2sBBI')
+
 # --- Obstáculo ---
 current_obstacle = None
 
 # --- Variáveis Globais de Estado da UI ---
 current_steps_count = 0
+# Fim da busca pelo alvo atual: "" enquanto busca, senão "SOLVED"/"GAVE_UP" com as avaliações gastas
+solver_status = ""
+# Último retrato das métricas do motor (dict do JSON de Metricas.h; None até o primeiro)
+latest_metrics = None
 
 # --- Filas de Comunicação ---
 trajectory_queue = queue.Queue()
@@ -70,59 +94,172 @@ def graph_process_func(data_q):
     plt.show()
 
 # --- Classe Thread Solver (C++) ---
+def handle_frame(ftype, payload):
+    """ Trata um quadro binário (vindo do stdout ou da memória compartilhada) """
+    global current_steps_count, current_obstacle, latest_metrics, solver_status
+    if ftype == FRAME_TARGET:
+        graph_data_queue.put("RESET")
+        solver_status = ""
+    elif ftype == FRAME_OBSTACLE:
+        current_obstacle = struct.unpack_from('<4d', payload, 0)
+    elif ftype == FRAME_PATH:
+        n = struct.unpack_from('<I', payload, 0)[0]
+        points = np.frombuffer(payload, dtype='<f4', count=3 * n, offset=4).reshape(n, 3)
+        if n: trajectory_queue.put(points.tolist())
+    elif ftype == FRAME_STATS:
+        gen, best, avg, steps = struct.unpack_from('<iddI', payload, 0)
+        current_steps_count = steps
+        graph_data_queue.put((gen, best, avg))
+    elif ftype == FRAME_METRICS:
+        latest_metrics = json.loads(payload.decode('utf-8'))
+    elif ftype == FRAME_OUTCOME:
+        solved, gens, evals, secs, best = struct.unpack_from('<Biqdd', payload, 0)
+        solver_status = f"{'SOLVED' if solved else 'GAVE_UP'} ({evals} avaliações)"
+
+def read_exact(stream, size):
+    data = b''
+    while len(data) < size:
+        chunk = stream.read(size - len(data))
+        if not chunk: return None
+        data += chunk
+    return data
+
 class SolverThread(threading.Thread):
+    """ Mantém um único motor C++ em modo servidor e envia os alvos pelo stdin """
     def __init__(self):
         super().__init__()
         self.daemon = True
         self.process = None
         self.running = True
+        self.shm_path = None
+
+    def start_process(self):
+        process_name = "./main" if sys.platform != "win32" else "main.exe"
+        args = [process_name, "--servidor", "--protocolo", PROTOCOL]
+        self.process = subprocess.Popen(args, stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                                        stderr=subprocess.DEVNULL, bufsize=0)
+        threading.Thread(target=self.read_output, daemon=True).start()
+
+    def stop_process(self):
+        if self.process and self.process.poll() is None:
+            try: self.process.stdin.write(b"SAIR\n"); self.process.stdin.flush()
+            except OSError: pass
+            try: self.process.wait(timeout=1.0)
+            except subprocess.TimeoutExpired: self.process.kill(); self.process.wait()
+        # Se o motor foi morto, ele não teve chance de remover a memória compartilhada
+        if self.shm_path and os.path.exists(self.shm_path):
+            try: os.unlink(self.shm_path)
+            except OSError: pass
+        self.shm_path = None
+
+    def read_output(self):
+        if PROTOCOL == "texto": self.read_text(self.process.stdout)
+        elif PROTOCOL == "shm": self.read_shm()
+        else: self.read_binary(self.process.stdout)
 
     def run(self):
-        global current_steps_count, current_obstacle
         while self.running:
             try: target = command_queue.get(timeout=0.5) 
             except queue.Empty: continue
 
-            if self.process and self.process.poll() is None:
-                self.process.kill(); self.process.wait()
-            
-            graph_data_queue.put("RESET")
+            # O processo é reaproveitado entre alvos; só é (re)iniciado se não estiver vivo
+            if self.process is None or self.process.poll() is not None:
+                try: self.start_process()
+                except FileNotFoundError:
+                    print("ERRO: Executável C++ não encontrado."); continue
+
             tx, ty, tz = target
-            
-            process_name = "./main" if sys.platform != "win32" else "main.exe"
             try:
-                self.process = subprocess.Popen([process_name, str(tx), str(ty), str(tz)], stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, bufsize=1)
-                current_path = []; reading_path = False
-                
-                while True:
-                    if not command_queue.empty(): break 
-                    line = self.process.stdout.readline()
-                    if not line: break
-                    line = line.strip()
-
-                    if line.startswith("OBSTACLE"):
-                        parts = line.split()
-                        if len(parts) == 5:
-                            current_obstacle = (
-                                float(parts[1]),
-                                float(parts[2]),
-                                float(parts[3]),
-                                float(parts[4])
-                            )
-                    
-                    elif line == "START_PATH": current_path = []; reading_path = True
-                    elif line == "END_PATH":
-                        reading_path = False
-                        if current_path: trajectory_queue.put(current_path)
-                    elif line.startswith("STATS"):
-                        parts = line.split()
-                        if len(parts) == 5:
-                            current_steps_count = int(parts[4])
-                            graph_data_queue.put((int(parts[1]), float(parts[2]), float(parts[3])))
-                    elif reading_path:
-                        try: current_path.append(tuple(map(float, line.split())))
-                        except ValueError: pass
-            except FileNotFoundError: print("ERRO: Executável C++ não encontrado.")
+                self.process.stdin.write(f"ALVO {tx} {ty} {tz}\n".encode())
+                self.process.stdin.flush()
+            except OSError: pass
+
+    def read_binary(self, stream):
+        while True:
+            header = read_exact(stream, FRAME_HEADER.size)
+            if header is None: break
+            magic, ftype, version, size = FRAME_HEADER.unpack(header)
+            if magic != b'BR': break
+            payload = read_exact(stream, size)
+            if payload is None: break
+            handle_frame(ftype, payload)
+
+    def read_shm(self):
+        # A primeira (e única) linha do stdout anuncia a região: "SHM <nome> <bytes>"
+        line = self.process.stdout.readline().decode(errors='ignore').split()
+        if len(line) != 3 or line[0] != "SHM":
+            # O motor caiu para o protocolo binário (memória compartilhada indisponível)
+            return
+        name, total = line[1], int(line[2])
+        if sys.platform == "win32":
+            mm = mmap.mmap(-1, total, tagname=name, access=mmap.ACCESS_READ)
+        else:
+            self.shm_path = "/dev/shm" + name
+            fd = os.open(self.shm_path, os.O_RDONLY)
+            mm = mmap.mmap(fd, total, access=mmap.ACCESS_READ)
+            os.close(fd)
+
+        magic, version, n_slots, slot_size = struct.unpack_from('<4sIII', mm, 0)
+        last = 0
+        try:
+            while True:
+                if self.process.poll() is not None: break
+                published = struct.unpack_from('<Q', mm, 16)[0]
+                if published == last:
+                    time.sleep(0.005); continue
+
+                # Leitor atrasado: pula direto para os quadros que ainda estão no anel
+                for n in range(max(last, published - n_slots), published):
+                    offset = 64 + (n % n_slots) * slot_size
+                    seq = struct.unpack_from('<Q', mm, offset)[0]
+                    if seq != 2 * n + 2: continue
+                    magic, ftype, version, size = FRAME_HEADER.unpack_from(mm, offset + 8)
+                    payload = mm[offset + 16: offset + 16 + size]
+                    # Seqlock: descarta se o produtor sobrescreveu o slot durante a leitura
+                    if struct.unpack_from('<Q', mm, offset)[0] != seq: continue
+                    handle_frame(ftype, payload)
+                last = published
+        finally:
+            mm.close()
+
+    def read_text(self, stream):
+        global current_steps_count, current_obstacle, latest_metrics, solver_status
+        current_path = []; reading_path = False
+        
+        while True:
+            line = stream.readline()
+            if not line: break
+            line = line.decode(errors='ignore').strip()
+
+            if line.startswith("TARGET"): graph_data_queue.put("RESET"); solver_status = ""
+            elif line.startswith("SOLVED") or line.startswith("GAVE_UP"):
+                parts = line.split()
+                if len(parts) == 5: solver_status = f"{parts[0]} ({parts[2]} avaliações)"
+            elif line.startswith("OBSTACLE"):
+                parts = line.split()
+                if len(parts) == 5:
+                    current_obstacle = (
+                        float(parts[1]),
+                        float(parts[2]),
+                        float(parts[3]),
+                        float(parts[4])
+                    )
+            
+            elif line == "START_PATH": current_path = []; reading_path = True
+            elif line == "END_PATH":
+                reading_path = False
+                if current_path: trajectory_queue.put(current_path)
+            elif line.startswith("STATS"):
+                parts = line.split()
+                if len(parts) == 5:
+                    current_steps_count = int(parts[4])
+                    graph_data_queue.put((int(parts[1]), float(parts[2]), float(parts[3])))
+            elif line.startswith("METRICS "):
+                try: latest_metrics = json.loads(line[8:])
+                except ValueError: pass
+            elif reading_path:
+                try: current_path.append(tuple(map(float, line.split())))
+                except ValueError: pass
 
 # --- Funções Auxiliares ---
 def generate_valid_target_fk():
@@ -348,12 +485,15 @@ def main():
             draw_button_gl(btn_ghost_mode.x, btn_ghost_mode.y, btn_ghost_mode.w, btn_ghost_mode.h, ghost_text, font, ghost_color)
             
             draw_text_gl(20, 110, f"Passos: {current_steps_count}", font_info, (0, 255, 255))
+            if solver_status:
+                draw_text_gl(20, 140, solver_status, font_info, (100, 255, 100) if solver_status.startswith("SOLVED") else (255, 100, 100))
 
             pygame.display.flip(); clock.tick(60)
 
     finally:
         print("Limpando processos...")
         solver_thread.running = False
+        solver_thread.stop_process()
         if graph_process.is_alive():
             graph_process.terminate()
             graph_process.kill()